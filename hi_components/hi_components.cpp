@@ -40,6 +40,7 @@
 #include "drag_plot/TableEditor.cpp"
 #include "keyboard/CustomKeyboard.cpp"
 #include "plugin_components/VoiceCpuBpmComponent.cpp"
+#include "plugin_components/PresetIndex.cpp"
 #include "plugin_components/PresetBrowser.cpp"
 #include "plugin_components/PresetComponents.cpp"
 #include "plugin_components/StandalonePopupComponents.cpp"
@@ -50,6 +51,7 @@
 #include "plugin_components/PluginPreviewWindow.cpp"
 #endif
 
+#include "wave_components/PeakPyramid.cpp"
 #include "wave_components/SampleDisplayComponent.cpp"
 #include "wave_components/WavetableComponents.cpp"
 
@@ -71,6 +71,7 @@ END_JUCE_MODULE_DECLARATION
 #include "drag_plot/TableEditor.h"
 #include "keyboard/CustomKeyboard.h"
 #include "plugin_components/VoiceCpuBpmComponent.h"
+#include "plugin_components/PresetIndex.h"
 #include "plugin_components/PresetBrowser.h"
 #include "plugin_components/PresetComponents.h"
 #include "plugin_components/StandalonePopupComponents.h"
@@ -82,6 +83,7 @@ END_JUCE_MODULE_DECLARATION
 #include "plugin_components/PluginPreviewWindow.h"
 #endif
 
+#include "wave_components/PeakPyramid.h"
 #include "wave_components/SampleDisplayComponent.h"
 #include "wave_components/WavetableComponents.h"
 
@@ -296,91 +296,39 @@ void MultiColumnPresetBrowser::ModalWindow::paint(Graphics& g)
 
 int PresetBrowserColumn::ColumnListModel::getNumRows()
 {
-    if(wildcard.isEmpty())
-    {   
-		const File& rootToUse = showFavoritesOnly ? totalRoot : root;
+	if (presetIndex == nullptr)
+		return 0;
 
-		if (!rootToUse.isDirectory())
-	    {
-		    entries.clear();
-		    return 0;
-	    }
+	if (!entriesNeedUpdate && entriesRevision == presetIndex->getRevision())
+		return entries.size();
 
-		
-	    entries.clear();
-	    rootToUse.findChildFiles(entries, displayDirectories ? File::findDirectories : File::findFiles, showFavoritesOnly);
+	entriesNeedUpdate = false;
+	entriesRevision = presetIndex->getRevision();
 
-		for (int i = 0; i < entries.size(); i++)
-		{
-			const bool isNoPresetFile = entries[i].isHidden() || entries[i].getFileName().startsWith(".") || entries[i].getFileExtension() != ".preset";
-			const bool isNoDirectory = !entries[i].isDirectory();
-
-			if (isNoPresetFile && isNoDirectory)
-			{
-				entries.remove(i--);
-				continue;
-			}
-		}
-
-		if (showFavoritesOnly && index == 2)
-		{
-			for (int i = 0; i < entries.size(); i++)
-			{
-				if (!MultiColumnPresetBrowser::DataBaseHelpers::isFavorite(database, entries[i]))
-				{
-					entries.remove(i--);
-					continue;
-				}
-			}
-		}
-			
-	    entries.sort();
+	// The bank and category columns always show their directories
+	const bool filterFavorites = showFavoritesOnly && index == 2;
 
-	    return entries.size();
-    }
-    else
-    {
+	if (wildcard.isEmpty())
+	{
+		entries = filterFavorites ? presetIndex->getAllPresets() : presetIndex->getChildren(root);
+	}
+	else
+	{
 		jassert(index == 2);
 
-        Array<File> allFiles;
-        
-        totalRoot.findChildFiles(allFiles, File::findFiles, true);
-        
-        entries.clear();
-        
-        for(int i = 0; i < allFiles.size(); i++)
-        {
-            if(allFiles[i].getFullPathName().containsIgnoreCase(wildcard))
-                entries.add(allFiles[i]);
-        }
-        
+		entries = presetIndex->search(wildcard);
+	}
+
+	if (filterFavorites)
+	{
 		for (int i = 0; i < entries.size(); i++)
 		{
-			const bool isNoPresetFile = entries[i].isHidden() || entries[i].getFileName().startsWith(".") || entries[i].getFileExtension() != ".preset";
-			
-			if (isNoPresetFile)
-			{
+			if (!MultiColumnPresetBrowser::DataBaseHelpers::isFavorite(database, entries[i]))
 				entries.remove(i--);
-			}
 		}
+	}
 
-		if (showFavoritesOnly && index == 2)
-		{
-			for (int i = 0; i < entries.size(); i++)
-			{
-				if (!MultiColumnPresetBrowser::DataBaseHelpers::isFavorite(database, entries[i]))
-				{
-					entries.remove(i--);
-					continue;
-				}
-			}
-		}
-
-
-        entries.sort();
-        
-        return entries.size();
-    }
+	return entries.size();
 }
 
 void PresetBrowserColumn::ColumnListModel::listBoxItemClicked(int row, const MouseEvent &e)
@@ -524,11 +472,10 @@ index(index_)
 	listModel = new ColumnListModel(index, listener);
 
 	listModel->database = dynamic_cast<MultiColumnPresetBrowser*>(listener)->getDataBase();
+	listModel->setPresetIndex(dynamic_cast<MultiColumnPresetBrowser*>(listener)->getPresetIndex());
 	
 	listModel->setTotalRoot(rootDirectory);
 	
-	startTimer(4000);
-	
 	if (index == 2)
 	{
 		listModel->setDisplayDirectories(false);
@@ -638,6 +585,9 @@ void PresetBrowserColumn::addEntry(const String &newName)
 		File newDirectory = currentRoot.getChildFile(newName);
 		newDirectory.createDirectory();
 
+		browser->getPresetIndex()->invalidate(currentRoot);
+		browser->rebuildAllPresets();
+
 		setNewRootDirectory(currentRoot);
 
 		
@@ -659,8 +609,9 @@ void PresetBrowserColumn::addEntry(const String &newName)
 			{
 				UserPresetHelpers::saveUserPreset(mc->getMainSynthChain(), newPreset.getFullPathName());
 
-				setNewRootDirectory(currentRoot);
+				browser->getPresetIndex()->invalidate(currentRoot);
 				browser->rebuildAllPresets();
+				setNewRootDirectory(currentRoot);
 				browser->showLoadedPreset();
 			}
 		}
@@ -796,6 +747,8 @@ mc(mc_)
 
 	loadPresetDatabase(rootFile);
 
+	presetIndex = new PresetIndex(rootFile);
+
 	mc->getUserPresetHandler().addListener(this);
 
 	addAndMakeVisible(bankColumn = new PresetBrowserColumn(mc, 0, rootFile, this));
@@ -854,6 +807,8 @@ mc(mc_)
     
     setOpaque(true);
 
+	startTimer(4000);
+
 }
 
 MultiColumnPresetBrowser::~MultiColumnPresetBrowser()
@@ -861,6 +816,7 @@ MultiColumnPresetBrowser::~MultiColumnPresetBrowser()
 	mc->getUserPresetHandler().removeListener(this);
 
 	savePresetDatabase(rootFile);
+	presetIndex->saveToFile();
 
 	searchBar->inputLabel->removeListener(this);
 	searchBar->inputLabel->removeListener(presetColumn);
@@ -907,25 +863,24 @@ void MultiColumnPresetBrowser::paint(Graphics& g)
 
 void MultiColumnPresetBrowser::rebuildAllPresets()
 {
-	allPresets.clear();
-	rootFile.findChildFiles(allPresets, File::findFiles, true, "*.preset");
-
-	for (int i = 0; i < allPresets.size(); i++)
+	if (presetIndex->refresh())
 	{
-		const bool isNoPresetFile = allPresets[i].isHidden() || allPresets[i].getFileName().startsWith(".") || allPresets[i].getFileExtension() != ".preset";
-		const bool isNoDirectory = !allPresets[i].isDirectory();
-
-		if (isNoDirectory && isNoPresetFile)
-		{
-			allPresets.remove(i--);
-		}
+		bankColumn->refreshEntries();
+		categoryColumn->refreshEntries();
+		presetColumn->refreshEntries();
 	}
 
+	allPresets = presetIndex->getAllPresets();
+
 	File f = mc->getUserPresetHandler().getCurrentlyLoadedFile();
 
 	currentlyLoadedPreset = allPresets.indexOf(f);
+}
 
-	
+void MultiColumnPresetBrowser::timerCallback()
+{
+	if (isShowing())
+		rebuildAllPresets();
 }
 
 String MultiColumnPresetBrowser::getCurrentlyLoadedPresetName()
@@ -1161,6 +1116,7 @@ void MultiColumnPresetBrowser::renameEntry(int columnIndex, int rowIndex, const
 				return;
 
             currentBankFile.moveFileTo(newBank);
+            presetIndex->invalidate(rootFile);
             
             categoryColumn->setNewRootDirectory(File());
             presetColumn->setNewRootDirectory(File());
@@ -1182,6 +1138,7 @@ void MultiColumnPresetBrowser::renameEntry(int columnIndex, int rowIndex, const
 				return;
             
             currentCategoryFile.moveFileTo(newCategory);
+            presetIndex->invalidate(currentBankFile);
             
             categoryColumn->setNewRootDirectory(currentBankFile);
             presetColumn->setNewRootDirectory(newCategory);
@@ -1202,8 +1159,9 @@ void MultiColumnPresetBrowser::renameEntry(int columnIndex, int rowIndex, const
 			else
 			{
 				presetFile.moveFileTo(newFile);
-				presetColumn->setNewRootDirectory(currentCategoryFile);
+				presetIndex->invalidate(currentCategoryFile);
 				rebuildAllPresets();
+				presetColumn->setNewRootDirectory(currentCategoryFile);
 				showLoadedPreset();
 			}
 		}
@@ -1212,6 +1170,8 @@ void MultiColumnPresetBrowser::renameEntry(int columnIndex, int rowIndex, const
 
 void MultiColumnPresetBrowser::deleteEntry(int columnIndex, const File& f)
 {
+	presetIndex->invalidate(f.getParentDirectory());
+
 	if (columnIndex == 0)
 	{
 		File bankToDelete = f;
@@ -1321,9 +1281,13 @@ void MultiColumnPresetBrowser::buttonClicked(Button* b)
 			break;
 		case ImportPresetsFromClipboard:
 			PresetHelpers::importPresetsFromClipboard(rootFile, currentCategoryFile);
+			presetIndex->invalidate(rootFile);
+			rebuildAllPresets();
 			break;
 		case ImportPresetsFromFile:
 			PresetHelpers::importPresetsFromFile(rootFile, currentCategoryFile);
+			presetIndex->invalidate(rootFile);
+			rebuildAllPresets();
 			break;
 		case ExportPresetsToClipboard:
 			PresetHelpers::exportPresetsToClipboard(rootFile, currentCategoryFile);
@@ -1489,6 +1453,7 @@ void PresetBrowserColumn::ColumnListModel::FavoriteOverlay::buttonClicked(Button
 	auto f = parent.getFileForIndex(index);
 
 	MultiColumnPresetBrowser::DataBaseHelpers::setFavorite(parent.database, f, newValue);
+	parent.invalidateEntries();
 
 	
 	refreshShape();
@@ -124,8 +124,7 @@ public:
 
 class PresetBrowserColumn : public Component,
 	                       public ButtonListener,
-	                       public Label::Listener,
-	                       public Timer
+	                       public Label::Listener
 {
 public:
 
@@ -167,7 +166,22 @@ public:
 
 		ColumnListModel(int index_, Listener* listener_);
 
-		void setRootDirectory(const File& newRootDirectory) { root = newRootDirectory; }
+		void setRootDirectory(const File& newRootDirectory) 
+		{ 
+			root = newRootDirectory; 
+			entriesNeedUpdate = true;
+		}
+
+		void setPresetIndex(PresetIndex* newPresetIndex) { presetIndex = newPresetIndex; }
+
+		void setWildcard(const String& newWildcard)
+		{
+			wildcard = newWildcard;
+			entriesNeedUpdate = true;
+		}
+
+		/** Call this if the entries need to be filtered again (eg. if a favorite has changed). */
+		void invalidateEntries() { entriesNeedUpdate = true; }
 		void toggleEditMode() { editMode = !editMode; }
 		void setDisplayDirectories(bool shouldDisplayDirectories) { displayDirectories = shouldDisplayDirectories; }
 
@@ -234,6 +248,7 @@ public:
 		void setShowFavoritesOnly(bool shouldShowFavoritesOnly)
 		{
 			showFavoritesOnly = shouldShowFavoritesOnly;
+			entriesNeedUpdate = true;
 		}
 		
 		File getFileForIndex(int fileIndex) const
@@ -246,8 +261,6 @@ public:
 			return entries.indexOf(f);
 		}
 
-        String wildcard;
-        
 		Colour highlightColour;
 		Font font;
 
@@ -258,6 +271,14 @@ public:
 
 		bool showFavoritesOnly = false;
 
+		String wildcard;
+
+		PresetIndex* presetIndex = nullptr;
+
+		// The entries are only filtered again if the index or the settings have changed
+		int entriesRevision = -1;
+		bool entriesNeedUpdate = true;
+
 		Image deleteIcon;
 
 		Listener* listener;
@@ -321,7 +342,7 @@ public:
 
 	void labelTextChanged(Label* l) override
 	{
-	    listModel->wildcard = l->getText();
+	    listModel->setWildcard(l->getText());
       
 	    listbox->deselectAllRows();
 	    listbox->updateContent();
@@ -335,13 +356,12 @@ public:
 		updateButtonVisibility();
 	}
 
-	void timerCallback() override
-    {
-        if(!isVisible()) return;
-        
-	    listbox->updateContent();
-	    listbox->repaint();
-    }
+	/** Updates the list after the preset index has changed. */
+	void refreshEntries()
+	{
+		listbox->updateContent();
+		listbox->repaint();
+	}
 	
 	void setSelectedFile(const File& file, NotificationType notifyListeners=dontSendNotification)
 	{
@@ -415,7 +435,8 @@ class MultiColumnPresetBrowser : public Component,
 								 public Button::Listener,
 								 public PresetBrowserColumn::ColumnListModel::Listener,
 								 public Label::Listener,
-								 public MainController::UserPresetHandler::Listener
+								 public MainController::UserPresetHandler::Listener,
+								 public Timer
 {
 public:
 
@@ -603,6 +624,7 @@ public:
 					if (le.oldFile.getFileName() == "tempFileBeforeMove.preset")
 						le.oldFile.deleteFile();
 
+					p->getPresetIndex()->invalidate(le.newFile.getParentDirectory());
 					p->rebuildAllPresets();
 					break;
                     }
@@ -769,9 +791,15 @@ public:
 		rebuildAllPresets();
 	}
 
+	/** Refreshes the preset index and updates the columns if anything has changed. */
 	void rebuildAllPresets();
 	String getCurrentlyLoadedPresetName();
 
+	/** Checks the preset index for changes that were made outside the browser. */
+	void timerCallback() override;
+
+	PresetIndex* getPresetIndex() { return presetIndex; }
+
 	void selectionChanged(int columnIndex, int rowIndex, const File& clickedFile, bool doubleClick);
 	void renameEntry(int columnIndex, int rowIndex, const String& newName);
 	void deleteEntry(int columnIndex, const File& f);
@@ -986,9 +1014,6 @@ public:
 
 		static bool isFavorite(const var& database, const File& presetFile)
 		{
-			if (!presetFile.existsAsFile())
-				return false;
-
 			if (!presetFile.hasFileExtension(".preset"))
 				return false;
 
@@ -1127,6 +1152,9 @@ private:
 	PresetBrowserColumn::ButtonLookAndFeel blaf;
 
 	File rootFile;
+
+	ScopedPointer<PresetIndex> presetIndex;
+
 	File currentBankFile;
 	File currentCategoryFile;
 
@@ -0,0 +1,290 @@
+/*  ===========================================================================
+*
+*   This file is part of HISE.
+*   Copyright 2016 Christoph Hart
+*
+*   HISE is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   HISE is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with HISE.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Commercial licenses for using HISE in an closed source project are
+*   available on request. Please visit the project's website to get more
+*   information about commercial licensing:
+*
+*   http://www.hise.audio/
+*
+*   HISE is based on the JUCE library,
+*   which must be separately licensed for closed source applications:
+*
+*   http://www.juce.com
+*
+*   ===========================================================================
+*/
+
+namespace hise { using namespace juce;
+
+PresetIndex::PresetIndex(const File& rootDirectory) :
+	root(rootDirectory)
+{
+	loadFromFile();
+	refresh();
+}
+
+bool PresetIndex::refresh()
+{
+	for (auto d : directories)
+		d->wasFound = false;
+
+	bool changed = false;
+
+	if (root.isDirectory())
+		changed = refreshDirectory(root, RootLevel);
+
+	// Remove the directories that were deleted
+	for (int i = 0; i < directories.size(); i++)
+	{
+		if (!directories[i]->wasFound)
+		{
+			directories.remove(i--);
+			changed = true;
+		}
+	}
+
+	if (changed)
+	{
+		rebuildPresetList();
+		revision++;
+	}
+
+	return changed;
+}
+
+void PresetIndex::invalidate(const File& directory)
+{
+	for (auto d : directories)
+	{
+		if (d->file == directory || d->file.isAChildOf(directory))
+			d->modificationTime = 0;
+	}
+}
+
+Array<File> PresetIndex::getChildren(const File& directory) const
+{
+	if (auto d = getDirectory(directory))
+		return d->children;
+
+	return {};
+}
+
+Array<File> PresetIndex::search(const String& searchTerm) const
+{
+	StringArray tokens;
+	tokens.addTokens(searchTerm.toLowerCase(), " \t", "\"");
+	tokens.removeEmptyStrings();
+
+	Array<File> results;
+
+	for (int i = 0; i < searchPaths.size(); i++)
+	{
+		const String& path = searchPaths[i];
+
+		bool found = true;
+
+		for (const auto& t : tokens)
+		{
+			if (!path.contains(t))
+			{
+				found = false;
+				break;
+			}
+		}
+
+		if (found)
+			results.add(allPresets.getUnchecked(i));
+	}
+
+	return results;
+}
+
+void PresetIndex::saveToFile() const
+{
+	if (!root.isDirectory())
+		return;
+
+	ValueTree v("PresetIndex");
+
+	for (auto d : directories)
+	{
+		ValueTree dv("Directory");
+
+		dv.setProperty("Path", d->file.getRelativePathFrom(root).replaceCharacter('\\', '/'), nullptr);
+		dv.setProperty("Level", d->level, nullptr);
+		dv.setProperty("Modified", d->modificationTime, nullptr);
+
+		for (const auto& c : d->children)
+		{
+			ValueTree cv("Child");
+			cv.setProperty("Name", c.getFileName(), nullptr);
+			dv.addChild(cv, -1, nullptr);
+		}
+
+		v.addChild(dv, -1, nullptr);
+	}
+
+	auto indexFile = getIndexFile();
+
+	indexFile.deleteFile();
+
+	FileOutputStream fos(indexFile);
+
+	if (fos.openedOk())
+		v.writeToStream(fos);
+}
+
+bool PresetIndex::refreshDirectory(const File& directoryFile, int level)
+{
+	bool changed = false;
+
+	auto d = getDirectory(directoryFile);
+
+	if (d == nullptr)
+	{
+		d = new Directory();
+		d->file = directoryFile;
+		d->level = level;
+
+		directories.add(d);
+	}
+
+	d->wasFound = true;
+
+	const int64 modificationTime = directoryFile.getLastModificationTime().toMilliseconds();
+
+	if (modificationTime != d->modificationTime)
+	{
+		auto newChildren = listChildren(directoryFile, level);
+
+		d->modificationTime = modificationTime;
+
+		if (newChildren != d->children)
+		{
+			d->children.swapWith(newChildren);
+			changed = true;
+		}
+	}
+
+	if (level < CategoryLevel)
+	{
+		// The array might be reallocated while refreshing the children
+		auto childDirectories = d->children;
+
+		for (const auto& c : childDirectories)
+			changed |= refreshDirectory(c, level + 1);
+	}
+
+	return changed;
+}
+
+PresetIndex::Directory* PresetIndex::getDirectory(const File& directoryFile) const
+{
+	for (auto d : directories)
+	{
+		if (d->file == directoryFile)
+			return d;
+	}
+
+	return nullptr;
+}
+
+void PresetIndex::rebuildPresetList()
+{
+	allPresets.clear();
+	searchPaths.clear();
+
+	for (auto d : directories)
+	{
+		if (d->level == CategoryLevel)
+			allPresets.addArray(d->children);
+	}
+
+	allPresets.sort();
+
+	searchPaths.ensureStorageAllocated(allPresets.size());
+
+	for (const auto& f : allPresets)
+		searchPaths.add(f.getRelativePathFrom(root).replaceCharacter('\\', '/').upToLastOccurrenceOf(".preset", false, false).toLowerCase());
+}
+
+void PresetIndex::loadFromFile()
+{
+	auto indexFile = getIndexFile();
+
+	if (!root.isDirectory() || !indexFile.existsAsFile())
+		return;
+
+	FileInputStream fis(indexFile);
+
+	if (!fis.openedOk())
+		return;
+
+	auto v = ValueTree::readFromStream(fis);
+
+	if (!v.hasType("PresetIndex"))
+		return;
+
+	for (const auto& dv : v)
+	{
+		auto d = new Directory();
+
+		const String path = dv.getProperty("Path").toString();
+
+		d->file = path.isEmpty() ? root : root.getChildFile(path);
+		d->level = dv.getProperty("Level");
+		d->modificationTime = dv.getProperty("Modified");
+
+		for (const auto& cv : dv)
+			d->children.add(d->file.getChildFile(cv.getProperty("Name").toString()));
+
+		directories.add(d);
+	}
+
+	rebuildPresetList();
+}
+
+File PresetIndex::getIndexFile() const
+{
+	return root.getChildFile(".presetindex");
+}
+
+Array<File> PresetIndex::listChildren(const File& directoryFile, int level)
+{
+	Array<File> children;
+
+	const bool listPresets = level == CategoryLevel;
+
+	directoryFile.findChildFiles(children, listPresets ? File::findFiles : File::findDirectories, false, listPresets ? "*.preset" : "*");
+
+	for (int i = 0; i < children.size(); i++)
+	{
+		const bool isHidden = children[i].isHidden() || children[i].getFileName().startsWith(".");
+		const bool isNoPresetFile = listPresets && children[i].getFileExtension() != ".preset";
+
+		if (isHidden || isNoPresetFile)
+			children.remove(i--);
+	}
+
+	children.sort();
+
+	return children;
+}
+
+} // namespace hise
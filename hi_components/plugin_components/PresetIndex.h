@@ -0,0 +1,123 @@
+/*  ===========================================================================
+*
+*   This file is part of HISE.
+*   Copyright 2016 Christoph Hart
+*
+*   HISE is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   HISE is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with HISE.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Commercial licenses for using HISE in an closed source project are
+*   available on request. Please visit the project's website to get more
+*   information about commercial licensing:
+*
+*   http://www.hise.audio/
+*
+*   HISE is based on the JUCE library,
+*   which must be separately licensed for closed source applications:
+*
+*   http://www.juce.com
+*
+*   ===========================================================================
+*/
+
+#ifndef PRESETINDEX_H_INCLUDED
+#define PRESETINDEX_H_INCLUDED
+
+namespace hise { using namespace juce;
+
+/** An index of all user presets that is used by the preset browser instead of scanning the file system.
+*
+*	The user preset directory always has the layout Bank/Category/Preset.preset, so the index stores the sorted children
+*	of every directory together with its modification time. Refreshing the index only reads the modification time of
+*	the indexed directories and lists the ones that have changed, and searching is done in memory.
+*
+*	The index is stored as hidden file in the root directory, so the next time the browser is opened only the changed
+*	directories need to be listed.
+*/
+class PresetIndex
+{
+public:
+
+	PresetIndex(const File& rootDirectory);
+
+	/** Updates all directories whose modification time has changed. Returns true if anything has changed. */
+	bool refresh();
+
+	/** Forces a rescan of the given directory (and all its subdirectories) with the next refresh. 
+	*
+	*	Call this after you've changed the directory, because the resolution of the modification time might be too coarse.
+	*/
+	void invalidate(const File& directory);
+
+	/** Returns the subdirectories (for the root and the banks) or the presets (for the categories) of the given directory. */
+	Array<File> getChildren(const File& directory) const;
+
+	/** Returns all presets sorted by their path. */
+	const Array<File>& getAllPresets() const noexcept { return allPresets; }
+
+	/** Returns all presets whose path contains every word of the search term (ignoring the case). */
+	Array<File> search(const String& searchTerm) const;
+
+	/** A number that changes whenever the content of the index has changed. */
+	int getRevision() const noexcept { return revision; }
+
+	/** Writes the index into the root directory. */
+	void saveToFile() const;
+
+private:
+
+	enum Level
+	{
+		RootLevel = 0,
+		BankLevel,
+		CategoryLevel,
+		numLevels
+	};
+
+	struct Directory
+	{
+		File file;
+		int level = 0;
+		int64 modificationTime = 0;
+		bool wasFound = false;
+
+		Array<File> children;
+	};
+
+	bool refreshDirectory(const File& directoryFile, int level);
+
+	Directory* getDirectory(const File& directoryFile) const;
+
+	void rebuildPresetList();
+
+	void loadFromFile();
+
+	File getIndexFile() const;
+
+	static Array<File> listChildren(const File& directoryFile, int level);
+
+	const File root;
+
+	OwnedArray<Directory> directories;
+
+	Array<File> allPresets;
+	StringArray searchPaths;
+
+	int revision = 0;
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(PresetIndex);
+};
+
+} // namespace hise
+
+#endif  // PRESETINDEX_H_INCLUDED
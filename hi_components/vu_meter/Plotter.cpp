@@ -62,6 +62,9 @@ freeMode(false)
 
 Plotter::~Plotter()
 {
+	if (telemetryRing != nullptr)
+		telemetryRing->removeSubscriber(this);
+
 	speedSlider = nullptr;
 	
 };
@@ -70,6 +73,9 @@ void Plotter::addPlottedModulator(Modulator *m)
 {
 	modQueue.add(new PlotterQueue(m));
 
+	telemetryRing = &m->getMainController()->getTelemetryRing();
+	telemetryRing->addSubscriber(m, this);
+
 	m->setPlotter(this);
 
 	if(getParentComponent() != nullptr) getParentComponent()->repaint();
@@ -80,6 +86,9 @@ void Plotter::removePlottedModulator(Modulator *m)
 	m->setPlotter(nullptr);
 	m->sendChangeMessage();
 
+	if (telemetryRing != nullptr)
+		telemetryRing->removeSubscriber(m, this);
+
 	for(int i = 0; i < modQueue.size(); i++)
 	{
 		if(modQueue[i]->attachedMod == m) 
@@ -153,16 +162,21 @@ void Plotter::addValue(const Modulator *m, float addedValue)
 			modQueue[i]->addValue(addedValue);
 
 			if(i == modQueue.size() -1) 
-			{
 				currentQueuePosition++;
-				triggerAsyncUpdate();
-			}
-
 		}
-		
-	}	
+	}
+
+	// The queues are full, so they need to be flushed before the next value arrives
+	if (currentQueuePosition >= 1024)
+		handleAsyncUpdate();
 };
 
+void Plotter::telemetryReceived(const TelemetryRing::Record& r)
+{
+	if (r.type == TelemetryRing::ModulatorValue)
+		addValue(static_cast<const Modulator*>(r.source), r.value);
+}
+
 void Plotter::addValue(float addedValue)
 {
 	freeModePlotterQueue.addValue(addedValue);
@@ -47,11 +47,14 @@ class ScriptContentComponent;
 *	You can add values with addValue(). This should be periodic 
 *	(either within the audio callback or with a designated timer in your Editor, as
 *	the plotter only writes something if new data is added.
+*
+*	The values of the plotted modulators are received from the TelemetryRing of the MainController.
 */
 class Plotter    : public Component,
 				   public SettableTooltipClient,
 				   public AsyncUpdater,
-				   public Slider::Listener
+				   public Slider::Listener,
+				   public TelemetryRing::Subscriber
 {
 public:
 	Plotter();
@@ -74,9 +77,14 @@ public:
 
 	void sliderValueChanged (Slider* ) override { setSpeed((int)speedSlider->getValue()); };
 
-	/** Adds a value to the queue to be displayed at the next timerCallback(). */
+	/** Adds a value to the queue of the modulator. Call this on the message thread. */
 	void addValue(const Modulator *m, float addedValue);
 
+	void telemetryReceived(const TelemetryRing::Record& r) override;
+
+	/** Writes the queued values into the buffer and repaints the plotter. */
+	void telemetryDrained() override { handleAsyncUpdate(); }
+
 	/** If set to true, you don't need any modulators, but call addValue(float newValue) directly. */
 	void setFreeMode(bool shouldUseFreeMode);
 
@@ -152,6 +160,8 @@ private:
 
 	OwnedArray<PlotterQueue> modQueue;
 
+	TelemetryRing* telemetryRing = nullptr;
+
 	int currentQueuePosition;
 	int currentRingBufferPosition;
 	
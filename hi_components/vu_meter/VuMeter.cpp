@@ -32,11 +32,42 @@
 
 namespace hise { using namespace juce;
 
+MeterRepaintDispatcher::Client::Client()
+{
+	dispatcher->addClient(this);
+}
+
+MeterRepaintDispatcher::Client::~Client()
+{
+	dispatcher->removeClient(this);
+}
+
+void MeterRepaintDispatcher::addClient(Client* c)
+{
+	clients.addIfNotAlreadyThere(c);
+
+	if (!isTimerRunning())
+		startTimer(30);
+}
+
+void MeterRepaintDispatcher::removeClient(Client* c)
+{
+	clients.removeAllInstancesOf(c);
+
+	if (clients.isEmpty())
+		stopTimer();
+}
+
+void MeterRepaintDispatcher::timerCallback()
+{
+	for (int i = 0; i < clients.size(); i++)
+		clients.getUnchecked(i)->refreshMeter();
+}
+
 VuMeter::VuMeter(float leftPeak/*=0.0f*/, float rightPeak/*=0.0f*/, Type t /*= MonoHorizontal*/) :
 type(t),
 l(leftPeak),
-r(rightPeak),
-previousValue(0.0f)
+r(rightPeak)
 {
 	setOpaque(true);
 
@@ -47,15 +78,55 @@ previousValue(0.0f)
 
 void VuMeter::paint(Graphics &g)
 {
-	switch (type)
+	if (type == MultiChannelVertical || type == MultiChannelHorizontal || type == numTypes)
+		return;
+
+	if (getWidth() <= 0 || getHeight() <= 0)
+		return;
+
+	const float scaleFactor = g.getInternalContext().getPhysicalPixelScaleFactor();
+
+	if (backgroundImage.isNull() || scaleFactor != imageScaleFactor)
+		renderCachedImages(scaleFactor);
+
+	const AffineTransform imageTransform = AffineTransform::scale(1.0f / imageScaleFactor);
+
+	g.drawImageTransformed(backgroundImage, imageTransform);
+
+	if (type == MonoVertical)
 	{
-	case MonoHorizontal:	drawMonoMeter(g); break;
-	case MonoVertical:		drawMonoMeter(g); break;
-	case StereoHorizontal:	drawStereoMeter(g); break;
-	case StereoVertical:	drawStereoMeter(g); break;
-    case MultiChannelVertical:
-    case MultiChannelHorizontal:
-	case numTypes:          break;
+		drawMonoVerticalBar(g);
+		return;
+	}
+
+	for (int i = 0; i < 2; i++)
+	{
+		const Rectangle<int> area = getLevelArea(i);
+
+		if (!area.isEmpty())
+		{
+			Graphics::ScopedSaveState sss(g);
+
+			g.reduceClipRegion(area);
+			g.drawImageTransformed(ledImage, imageTransform);
+		}
+	}
+}
+
+void VuMeter::refreshMeter()
+{
+	if (!isShowing())
+		return;
+
+	for (int i = 0; i < 2; i++)
+	{
+		const Rectangle<int> newArea = getLevelArea(i);
+
+		if (newArea != paintedLevelArea[i])
+		{
+			repaint(getChangedArea(paintedLevelArea[i], newArea));
+			paintedLevelArea[i] = newArea;
+		}
 	}
 }
 
@@ -68,6 +139,8 @@ void VuMeter::setType(Type newType)
 		l = -100.0f;
 		r = -100.0f;
 	}
+
+	invalidateCachedImages();
 }
 
 void VuMeter::setPeak(float left, float right/*=0.0f*/)
@@ -79,94 +152,154 @@ void VuMeter::setPeak(float left, float right/*=0.0f*/)
 
 		l = jmax(l, Decibels::gainToDecibels(left));
 		r = jmax(r, Decibels::gainToDecibels(right));
-		repaint();
 	}
 	else
 	{
+		l = jmax(0.0f, left);
+	}
+}
 
+void VuMeter::invalidateCachedImages()
+{
+	backgroundImage = Image();
+	ledImage = Image();
 
-		if (left != l)
-		{
-			l = jmax(0.0f, left);
+	repaint();
+}
 
-			repaint();
-		}
+void VuMeter::renderCachedImages(float scaleFactor)
+{
+	imageScaleFactor = scaleFactor;
+
+	const int imageWidth = jmax(1, roundToInt((float)getWidth() * scaleFactor));
+	const int imageHeight = jmax(1, roundToInt((float)getHeight() * scaleFactor));
+
+	backgroundImage = Image(Image::ARGB, imageWidth, imageHeight, true);
+
+	{
+		Graphics g(backgroundImage);
+		g.addTransform(AffineTransform::scale(scaleFactor));
+		drawBackground(g);
+	}
+
+	// The vertical mono meter has a drop shadow around the bar, so it is painted directly
+	if (type == MonoVertical)
+	{
+		ledImage = Image();
+		return;
+	}
+
+	ledImage = Image(Image::ARGB, imageWidth, imageHeight, true);
+
+	{
+		Graphics g(ledImage);
+		g.addTransform(AffineTransform::scale(scaleFactor));
+		drawLeds(g);
 	}
 }
 
-void VuMeter::drawMonoMeter(Graphics &g)
+Rectangle<int> VuMeter::getLevelArea(int channelIndex) const
 {
 	const float w = (float)getWidth();
 	const float h = (float)getHeight();
 
-	float v = jlimit<float>(0.0f, 1.0f, l);
+	switch (type)
+	{
+	case MonoHorizontal:
+	{
+		if (channelIndex != 0)
+			return {};
 
+		const float value = (w - 4.0f) * jlimit<float>(0.0f, 1.0f, l);
 
+		return { 2, 2, roundToInt(value), getHeight() - 4 };
+	}
+	case MonoVertical:
+	{
+		if (channelIndex != 0)
+			return {};
 
-	g.setColour(colours[backgroundColour]);
-	g.fillAll();
+		const float v = jlimit<float>(0.0f, 1.0f, l);
 
-	g.setColour(colours[outlineColour]);
-	g.drawRect(getLocalBounds());
+		Rectangle<int> a((int)2.0f, (int)(h * (1.0f - v)), (int)w - 4, (int)(h * v));
 
-	if (type == MonoHorizontal)
+		if (a.isEmpty())
+			return {};
+
+		// Include the drop shadow
+		return w >= 16.0f ? a.expanded(5).getIntersection(getLocalBounds()) : a;
+	}
+	case StereoHorizontal:
 	{
-		const float value = (w - 4.0f) * v;
+		const float v = jmin(1.0f, ((channelIndex == 0 ? l : r) + 100.0f) / 100.0f);
+		const float offset = jmin(w, w * v);
 
+		float lastLine = 0.0f;
 
+		for (float i = 3.0f; i < offset; i += 3.0f)
+			lastLine = i;
 
+		if (lastLine == 0.0f)
+			return {};
 
-		g.setGradientFill(ColourGradient(colours[ledColour].withMultipliedAlpha(.5f),
-			0.0f, 0.0f,
-			colours[ledColour].withMultipliedAlpha(0.2f),
-			0.0f, h, false));
+		const int y = channelIndex == 0 ? 0 : getHeight() / 2;
+		const int height = channelIndex == 0 ? getHeight() / 2 : getHeight() - y;
 
-		g.fillRect(2.0f, 2.0f, value, h - 4.0f);
+		return { 0, y, (int)lastLine + 1, height };
+	}
+	case StereoVertical:
+	{
+		const float v = jmin(1.0f, ((channelIndex == 0 ? l : r) + 100.0f) / 100.0f);
+		const float offset = jmin(h, h - h * v);
 
-		previousValue = value;
+		float lastLine = -1.0f;
 
-	}
+		for (float i = h - 4; i > offset; i -= 3.0f)
+			lastLine = i;
 
-	if (type == MonoVertical)
-	{
-		g.setGradientFill(ColourGradient(colours[ledColour].withAlpha(0.2f),
-			0.0f, 0.0f,
-			colours[ledColour].withAlpha(0.05f),
-			w, 0.0f, false));
+		if (lastLine < 0.0f)
+			return {};
 
-		//g.fillRect(2.0f, 2.0f,		  w -4.0f, h - 4.0f);
+		const int x = channelIndex == 0 ? 0 : getWidth() / 2;
+		const int width = channelIndex == 0 ? getWidth() / 2 : getWidth() - x;
+		const int top = jmax(0, (int)lastLine - 1);
 
-		const float value = h * v;
-		const float offset = h * (1.0f - v);
+		return { x, top, width, getHeight() - top };
+	}
+	case MultiChannelVertical:
+	case MultiChannelHorizontal:
+	case numTypes:
+		break;
+	}
 
-		g.setGradientFill(ColourGradient(colours[ledColour],
-			0.0f, 0.0f,
-			colours[ledColour].withMultipliedAlpha(0.5f),
-			0.0f, h, false));
+	return {};
+}
 
+Rectangle<int> VuMeter::getChangedArea(Rectangle<int> oldArea, Rectangle<int> newArea) const
+{
+	if (oldArea.isEmpty())
+		return newArea;
 
-		Rectangle<int> a((int)2.0f, (int)offset, (int)w - 4, (int)value);
+	if (newArea.isEmpty())
+		return oldArea;
 
-		if (w >= 16.0)
-		{
-			DropShadow d(Colours::white.withAlpha(0.2f), 5, Point<int>());
+	const Rectangle<int> bothAreas = oldArea.getUnion(newArea);
 
-			d.drawForRectangle(g, a);
-		}
+	// The levels grow from the same edge, so only the strip between the old and the new level has changed
+	if (type == MonoHorizontal || type == StereoHorizontal)
+		return bothAreas.withLeft(jmin(oldArea.getRight(), newArea.getRight()));
 
-		g.fillRect(a);
+	if (type == StereoVertical)
+		return bothAreas.withBottom(jmax(oldArea.getY(), newArea.getY()));
 
-	}
+	return bothAreas;
 }
 
-void VuMeter::drawStereoMeter(Graphics &g)
+void VuMeter::drawBackground(Graphics &g)
 {
 	const float w = (float)getWidth();
 	const float h = (float)getHeight();
 
-	const float vL = jmin(1.0f, (l + 100.0f) / 100.0f);
-	const float vR = jmin(1.0f, (r + 100.0f) / 100.0f);
-
 	g.setColour(colours[backgroundColour]);
 	g.fillAll();
 
@@ -182,63 +315,86 @@ void VuMeter::drawStereoMeter(Graphics &g)
 
 		g.fillRect(2.0f, 2.0f, w - 4.0f, h / 2.0f - 3.0f);
 		g.fillRect(2.0f, h / 2.0f + 1, w - 4.0f, h / 2.0f - 3.0f);
+	}
+	else if (type == StereoVertical)
+	{
+		g.setGradientFill(ColourGradient(colours[ledColour].withAlpha(0.2f),
+			0.0f, 0.0f,
+			colours[ledColour].withAlpha(0.05f),
+			0.0f, h, false));
 
-		const float valueL = (w)* vL;
-		const float valueR = (w)* vR;
+		g.fillRect(2.0f, 2.0f, w / 2.0f - 3.0f, h - 4.0f);
+		g.fillRect(w / 2.0f + 1, 2.0f, w / 2.0f - 3.0f, h - 4.0f);
+	}
+}
+
+void VuMeter::drawLeds(Graphics &g)
+{
+	const float w = (float)getWidth();
+	const float h = (float)getHeight();
 
-		const float offsetL = jmin(w, valueL);
-		const float offsetR = jmin(w, valueR);
+	if (type == MonoHorizontal)
+	{
+		g.setGradientFill(ColourGradient(colours[ledColour].withMultipliedAlpha(.5f),
+			0.0f, 0.0f,
+			colours[ledColour].withMultipliedAlpha(0.2f),
+			0.0f, h, false));
 
+		g.fillRect(2.0f, 2.0f, w - 4.0f, h - 4.0f);
+	}
+	else if (type == StereoHorizontal)
+	{
 		g.setGradientFill(ColourGradient(colours[ledColour].withAlpha(1.0f).withMultipliedBrightness(1.4f),
 			0.0f, 0.0f,
 			colours[ledColour].withMultipliedBrightness(0.7f),
 			0.0f, h, false));
 
-		for (float i = 3.0f; i < offsetL; i += 3.0f)
+		for (float i = 3.0f; i < w; i += 3.0f)
 		{
 			g.drawLine(i, 2.0f, i, h / 2.0f - 1.0f, 1.0f);
-		}
-
-		for (float i = 3.0f; i < offsetR; i += 3.0f)
-		{
 			g.drawLine(i, h / 2.0f + 1.0f, i, h - 2.0f, 1.0f);
 		}
 	}
-	else
+	else if (type == StereoVertical)
 	{
-		g.setGradientFill(ColourGradient(colours[ledColour].withAlpha(0.2f),
+		g.setGradientFill(ColourGradient(colours[ledColour].withAlpha(1.0f).withMultipliedBrightness(1.4f),
 			0.0f, 0.0f,
-			colours[ledColour].withAlpha(0.05f),
+			colours[ledColour].withMultipliedBrightness(0.7f),
 			0.0f, h, false));
 
+		for (float i = h - 4; i > 0.0f; i -= 3.0f)
+		{
+			g.drawLine(2.0, i, w / 2.0f - 1.0f, i, 1.0f);
+			g.drawLine(w / 2.0f + 1.0f, i, w - 2.0f, i, 1.0f);
+		}
+	}
+}
 
+void VuMeter::drawMonoVerticalBar(Graphics &g)
+{
+	const float w = (float)getWidth();
+	const float h = (float)getHeight();
 
-		g.fillRect(2.0f, 2.0f, w / 2.0f - 3.0f, h - 4.0f);
-		g.fillRect(w / 2.0f + 1, 2.0f, w / 2.0f - 3.0f, h - 4.0f);
-
-		const float valueL = (h)* vL;
-		const float valueR = (h)* vR;
-
-		const float offsetL = jmin(h, h - valueL);
-		const float offsetR = jmin(h, h - valueR);
+	float v = jlimit<float>(0.0f, 1.0f, l);
 
-		g.setGradientFill(ColourGradient(colours[ledColour].withAlpha(1.0f).withMultipliedBrightness(1.4f),
-			0.0f, 0.0f,
-			colours[ledColour].withMultipliedBrightness(0.7f),
-			0.0f, h, false));
+	const float value = h * v;
+	const float offset = h * (1.0f - v);
 
-		for (float i = h - 4; i > offsetL; i -= 3.0f)
-		{
+	g.setGradientFill(ColourGradient(colours[ledColour],
+		0.0f, 0.0f,
+		colours[ledColour].withMultipliedAlpha(0.5f),
+		0.0f, h, false));
 
-			g.drawLine(2.0, i, w / 2.0f - 1.0f, i, 1.0f);
+	Rectangle<int> a((int)2.0f, (int)offset, (int)w - 4, (int)value);
 
-		}
+	if (w >= 16.0)
+	{
+		DropShadow d(Colours::white.withAlpha(0.2f), 5, Point<int>());
 
-		for (float i = h - 4; i > offsetR; i -= 3.0f)
-		{
-			g.drawLine(w / 2.0f + 1.0f, i, w - 2.0f, i, 1.0f);
-		}
+		d.drawForRectangle(g, a);
 	}
+
+	g.fillRect(a);
 }
 
 void WaveformComponent::paint(Graphics &g)
@@ -35,15 +35,59 @@
 
 namespace hise { using namespace juce;
 
+/** Repaints all registered meters in a single timer callback.
+*
+*	Instead of repainting themselves whenever a new value arrives, the meters register here and 
+*	repaint the area that has changed once per timer callback. The timer only runs if there are any meters.
+*/
+class MeterRepaintDispatcher : private Timer
+{
+public:
+
+	class Client
+	{
+	public:
+
+		Client();
+		virtual ~Client();
+
+		/** Called periodically by the dispatcher. Repaint the area that has changed since the last call. */
+		virtual void refreshMeter() = 0;
+
+	private:
+
+		SharedResourcePointer<MeterRepaintDispatcher> dispatcher;
+
+		JUCE_DECLARE_NON_COPYABLE(Client);
+	};
+
+	MeterRepaintDispatcher() {};
+
+	void addClient(Client* c);
+	void removeClient(Client* c);
+
+private:
+
+	void timerCallback() override;
+
+	Array<Client*> clients;
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(MeterRepaintDispatcher);
+};
+
 /** A Slider-style component that displays peak values.
 *	@ingroup components
 *
 *	The best practice for using one of those is a Timer that regularly
 *	calls setPeak() in its timerCallback().
 *
+*	The meter does not repaint itself in setPeak(), but repaints the segments that have changed with the next 
+*	callback of the MeterRepaintDispatcher. The background and the fully lit segments are rendered into images
+*	that are clipped to the current level, so the painting cost does not depend on the level.
 */
 class VuMeter: public Component,
-			   public SettableTooltipClient
+			   public SettableTooltipClient,
+			   public MeterRepaintDispatcher::Client
 {
 public:
 
@@ -74,10 +118,18 @@ public:
 	~VuMeter() {};
 
 	/** Change the colour of the VuMeter. */
-	void setColour(ColourId id, Colour newColour) {	colours[id] = newColour; };
+	void setColour(ColourId id, Colour newColour) 
+	{	
+		colours[id] = newColour; 
+		invalidateCachedImages();
+	};
 
 	void paint(Graphics &g) override;;
 
+	void resized() override { invalidateCachedImages(); }
+
+	void refreshMeter() override;
+
 	
 
 	/** Change the Type of the VuMeter. */
@@ -93,12 +145,29 @@ public:
 
 private:
 
-	void drawMonoMeter(Graphics &g);
+	void invalidateCachedImages();
+
+	void renderCachedImages(float scaleFactor);
+
+	/** Returns the area of the lit segments for the given channel (0 = left). */
+	Rectangle<int> getLevelArea(int channelIndex) const;
+
+	/** Returns the part of the meter that needs to be repainted if the level changes from the old to the new area. */
+	Rectangle<int> getChangedArea(Rectangle<int> oldArea, Rectangle<int> newArea) const;
+
+	/** Draws everything except the level. */
+	void drawBackground(Graphics &g);
+
+	/** Draws all segments with the maximum level. */
+	void drawLeds(Graphics &g);
 
-	void drawStereoMeter(Graphics &g);;
+	void drawMonoVerticalBar(Graphics &g);
 
+	Image backgroundImage;
+	Image ledImage;
+	float imageScaleFactor = 1.0f;
 
-	float previousValue;
+	Rectangle<int> paintedLevelArea[2];
 
 	Colour colours[numColours];
 
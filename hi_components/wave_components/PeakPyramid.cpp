@@ -0,0 +1,364 @@
+/*  ===========================================================================
+*
+*   This file is part of HISE.
+*   Copyright 2016 Christoph Hart
+*
+*   HISE is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   HISE is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with HISE.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Commercial licenses for using HISE in an closed source project are
+*   available on request. Please visit the project's website to get more
+*   information about commercial licensing:
+*
+*   http://www.hise.audio/
+*
+*   HISE is based on the JUCE library,
+*   which must be separately licensed for closed source applications:
+*
+*   http://www.juce.com
+*
+*   ===========================================================================
+*/
+
+namespace hise { using namespace juce;
+
+namespace PeakPyramidHelpers
+{
+	static const int fileIdentifier = 0x59504b50; // "PKPY"
+	static const int fileVersion = 1;
+
+	static int16 quantizeMin(float value) noexcept { return (int16)jlimit<int>(-32768, 32767, (int)std::floor(value * 32767.0f)); }
+	static int16 quantizeMax(float value) noexcept { return (int16)jlimit<int>(-32768, 32767, (int)std::ceil(value * 32767.0f)); }
+
+	static size_t getNumBytesPerChannel(int numPeaks) noexcept { return sizeof(int16) * 2 * (size_t)numPeaks; }
+}
+
+PeakPyramid::Level::Level(int samplesPerPeak_, int numPeaks_, int numChannels) :
+	samplesPerPeak(samplesPerPeak_),
+	numPeaks(numPeaks_)
+{
+	for (int i = 0; i < numChannels; i++)
+		data[i].calloc(numPeaks * 2);
+}
+
+Range<float> PeakPyramid::Level::getPeak(int channel, int index) const noexcept
+{
+	jassert(isPositiveAndBelow(index, numPeaks));
+
+	const int16* d = data[channel] + index * 2;
+
+	return { (float)d[0] / 32767.0f, (float)d[1] / 32767.0f };
+}
+
+PeakPyramid::Builder::Builder(int numChannels_, int64 lengthInSamples_) :
+	numChannels(jlimit<int>(1, MaxNumChannels, numChannels_)),
+	lengthInSamples(lengthInSamples_)
+{
+	const int numPeaks = jmax<int>(1, (int)((lengthInSamples + BaseSamplesPerPeak - 1) / BaseSamplesPerPeak));
+
+	baseLevel = new Level(BaseSamplesPerPeak, numPeaks, numChannels);
+}
+
+void PeakPyramid::Builder::addBlock(const AudioSampleBuffer& buffer, int numSamples)
+{
+	int offset = 0;
+
+	while (offset < numSamples)
+	{
+		const int numThisTime = jmin<int>(numSamples - offset, BaseSamplesPerPeak - samplesInCurrentPeak);
+
+		for (int c = 0; c < numChannels; c++)
+		{
+			const float* d = buffer.getReadPointer(jmin<int>(c, buffer.getNumChannels() - 1), offset);
+			auto peak = FloatVectorOperations::findMinAndMax(d, numThisTime);
+
+			currentPeak[c] = samplesInCurrentPeak == 0 ? peak : currentPeak[c].getUnionWith(peak);
+		}
+
+		samplesInCurrentPeak += numThisTime;
+		offset += numThisTime;
+
+		if (samplesInCurrentPeak == BaseSamplesPerPeak)
+			storeCurrentPeak();
+	}
+}
+
+void PeakPyramid::Builder::storeCurrentPeak()
+{
+	if (peakIndex < baseLevel->numPeaks)
+	{
+		for (int c = 0; c < numChannels; c++)
+		{
+			baseLevel->data[c][peakIndex * 2] = PeakPyramidHelpers::quantizeMin(currentPeak[c].getStart());
+			baseLevel->data[c][peakIndex * 2 + 1] = PeakPyramidHelpers::quantizeMax(currentPeak[c].getEnd());
+		}
+	}
+
+	peakIndex++;
+	samplesInCurrentPeak = 0;
+}
+
+PeakPyramid* PeakPyramid::Builder::createPyramid()
+{
+	if (samplesInCurrentPeak > 0)
+		storeCurrentPeak();
+
+	ScopedPointer<PeakPyramid> pyramid = new PeakPyramid(numChannels, lengthInSamples);
+
+	pyramid->levels.add(baseLevel.release());
+
+	while (pyramid->levels.getLast()->numPeaks > MinNumPeaks)
+	{
+		const Level& source = *pyramid->levels.getLast();
+		const int numPeaks = (source.numPeaks + ReductionFactor - 1) / ReductionFactor;
+
+		auto level = new Level(source.samplesPerPeak * ReductionFactor, numPeaks, numChannels);
+
+		for (int c = 0; c < numChannels; c++)
+		{
+			const int16* s = source.data[c];
+			int16* d = level->data[c];
+
+			for (int i = 0; i < numPeaks; i++)
+			{
+				const int start = i * ReductionFactor;
+				const int end = jmin<int>(start + ReductionFactor, source.numPeaks);
+
+				int16 minValue = s[start * 2];
+				int16 maxValue = s[start * 2 + 1];
+
+				for (int j = start + 1; j < end; j++)
+				{
+					minValue = jmin(minValue, s[j * 2]);
+					maxValue = jmax(maxValue, s[j * 2 + 1]);
+				}
+
+				d[i * 2] = minValue;
+				d[i * 2 + 1] = maxValue;
+			}
+		}
+
+		pyramid->levels.add(level);
+	}
+
+	return pyramid.release();
+}
+
+// ====================================================================================================================
+
+PeakPyramid::PeakPyramid(int numChannels_, int64 lengthInSamples_) :
+	numChannels(numChannels_),
+	lengthInSamples(lengthInSamples_)
+{}
+
+PeakPyramid* PeakPyramid::createFromReader(AudioFormatReader& reader, Thread* threadToCheck)
+{
+	const int numChannels = jmin<int>(MaxNumChannels, (int)reader.numChannels);
+
+	Builder builder(numChannels, reader.lengthInSamples);
+	AudioSampleBuffer chunk(numChannels, (int)jmin<int64>(ChunkSize, jmax<int64>(1, reader.lengthInSamples)));
+
+	for (int64 position = 0; position < reader.lengthInSamples; position += chunk.getNumSamples())
+	{
+		if (threadToCheck != nullptr && threadToCheck->threadShouldExit())
+			return nullptr;
+
+		const int numSamples = (int)jmin<int64>(chunk.getNumSamples(), reader.lengthInSamples - position);
+
+		reader.read(&chunk, 0, numSamples, position, true, true);
+		builder.addBlock(chunk, numSamples);
+	}
+
+	return builder.createPyramid();
+}
+
+PeakPyramid* PeakPyramid::loadFromFile(const File& file, int numChannels, int64 lengthInSamples, double samplesPerPixel)
+{
+	if (!file.existsAsFile())
+		return nullptr;
+
+	FileInputStream input(file);
+
+	if (input.failedToOpen())
+		return nullptr;
+
+	if (input.readInt() != PeakPyramidHelpers::fileIdentifier || input.readInt() != PeakPyramidHelpers::fileVersion)
+		return nullptr;
+
+	const int numChannelsInFile = input.readInt();
+	const int64 lengthInFile = input.readInt64();
+	const int numLevels = input.readInt();
+
+	if (numChannelsInFile != jlimit<int>(1, MaxNumChannels, numChannels) || lengthInFile != lengthInSamples || numLevels <= 0 || numLevels > 32)
+		return nullptr;
+
+	int samplesPerPeak[32];
+	int numPeaks[32];
+	int firstLevelToLoad = 0;
+
+	for (int i = 0; i < numLevels; i++)
+	{
+		samplesPerPeak[i] = input.readInt();
+		numPeaks[i] = input.readInt();
+
+		if (numPeaks[i] <= 0)
+			return nullptr;
+
+		if (samplesPerPeak[i] <= samplesPerPixel)
+			firstLevelToLoad = i;
+	}
+
+	int64 offset = input.getPosition();
+
+	for (int i = 0; i < firstLevelToLoad; i++)
+		offset += (int64)PeakPyramidHelpers::getNumBytesPerChannel(numPeaks[i]) * numChannelsInFile;
+
+	if (!input.setPosition(offset))
+		return nullptr;
+
+	ScopedPointer<PeakPyramid> pyramid = new PeakPyramid(numChannelsInFile, lengthInFile);
+
+	for (int i = firstLevelToLoad; i < numLevels; i++)
+	{
+		auto level = new Level(samplesPerPeak[i], numPeaks[i], numChannelsInFile);
+		pyramid->levels.add(level);
+
+		const int numBytes = (int)PeakPyramidHelpers::getNumBytesPerChannel(numPeaks[i]);
+
+		for (int c = 0; c < numChannelsInFile; c++)
+		{
+			if (input.read(level->data[c], numBytes) != numBytes)
+				return nullptr;
+		}
+	}
+
+	return pyramid.release();
+}
+
+bool PeakPyramid::saveToFile(const File& file) const
+{
+	if (!file.getParentDirectory().createDirectory())
+		return false;
+
+	TemporaryFile tempFile(file);
+
+	{
+		FileOutputStream output(tempFile.getFile());
+
+		if (output.failedToOpen())
+			return false;
+
+		output.writeInt(PeakPyramidHelpers::fileIdentifier);
+		output.writeInt(PeakPyramidHelpers::fileVersion);
+		output.writeInt(numChannels);
+		output.writeInt64(lengthInSamples);
+		output.writeInt(levels.size());
+
+		for (auto l : levels)
+		{
+			output.writeInt(l->samplesPerPeak);
+			output.writeInt(l->numPeaks);
+		}
+
+		// The peaks are written as raw little endian data so that they can be read in one go
+		for (auto l : levels)
+		{
+			for (int c = 0; c < numChannels; c++)
+				output.write(l->data[c], PeakPyramidHelpers::getNumBytesPerChannel(l->numPeaks));
+		}
+
+		output.flush();
+
+		if (output.getStatus().failed())
+			return false;
+	}
+
+	return tempFile.overwriteTargetFileWithTemporary();
+}
+
+File PeakPyramid::getCacheFile(const File& cacheDirectory, int64 hashCode)
+{
+	return cacheDirectory.getChildFile(String::toHexString(hashCode) + ".peaks");
+}
+
+// ====================================================================================================================
+
+const PeakPyramid::Level* PeakPyramid::getLevelForSamplesPerPixel(double samplesPerPixel) const noexcept
+{
+	const Level* result = levels.getFirst();
+
+	for (auto l : levels)
+	{
+		if (l->samplesPerPeak <= samplesPerPixel)
+			result = l;
+	}
+
+	return result;
+}
+
+bool PeakPyramid::hasResolution(double samplesPerPixel) const noexcept
+{
+	if (levels.isEmpty())
+		return false;
+
+	return levels.getFirst()->samplesPerPeak <= jmax<double>(BaseSamplesPerPeak, samplesPerPixel);
+}
+
+Range<float> PeakPyramid::getPeak(int channel, int64 startSample, int64 endSample) const noexcept
+{
+	auto level = getLevelForSamplesPerPixel((double)(endSample - startSample));
+
+	if (level == nullptr || endSample <= startSample)
+		return {};
+
+	channel = jlimit<int>(0, numChannels - 1, channel);
+
+	const int firstPeak = (int)jlimit<int64>(0, level->numPeaks - 1, startSample / level->samplesPerPeak);
+	const int lastPeak = (int)jlimit<int64>(0, level->numPeaks - 1, (endSample - 1) / level->samplesPerPeak);
+
+	auto peak = level->getPeak(channel, firstPeak);
+
+	for (int i = firstPeak + 1; i <= lastPeak; i++)
+		peak = peak.getUnionWith(level->getPeak(channel, i));
+
+	return peak;
+}
+
+Range<float> PeakPyramid::getTotalPeak(int channel) const noexcept
+{
+	auto level = levels.getLast();
+
+	if (level == nullptr)
+		return {};
+
+	channel = jlimit<int>(0, numChannels - 1, channel);
+
+	auto peak = level->getPeak(channel, 0);
+
+	for (int i = 1; i < level->numPeaks; i++)
+		peak = peak.getUnionWith(level->getPeak(channel, i));
+
+	return peak;
+}
+
+size_t PeakPyramid::getMemoryUsage() const noexcept
+{
+	size_t numBytes = 0;
+
+	for (auto l : levels)
+		numBytes += PeakPyramidHelpers::getNumBytesPerChannel(l->numPeaks) * (size_t)numChannels;
+
+	return numBytes;
+}
+
+} // namespace hise
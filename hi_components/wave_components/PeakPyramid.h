@@ -0,0 +1,159 @@
+/*  ===========================================================================
+*
+*   This file is part of HISE.
+*   Copyright 2016 Christoph Hart
+*
+*   HISE is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   HISE is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with HISE.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Commercial licenses for using HISE in an closed source project are
+*   available on request. Please visit the project's website to get more
+*   information about commercial licensing:
+*
+*   http://www.hise.audio/
+*
+*   HISE is based on the JUCE library,
+*   which must be separately licensed for closed source applications:
+*
+*   http://www.juce.com
+*
+*   ===========================================================================
+*/
+
+#ifndef PEAKPYRAMID_H_INCLUDED
+#define PEAKPYRAMID_H_INCLUDED
+
+namespace hise { using namespace juce;
+
+/** A multi-resolution min / max overview of an audio file that is used to draw waveforms.
+*
+*	The finest level contains the peaks of every BaseSamplesPerPeak samples, and every other level combines
+*	ReductionFactor peaks of the level below. A display picks the coarsest level that still has at least one peak 
+*	per pixel, so the amount of data it has to look at only depends on its width.
+*
+*	The pyramid is built from chunks of audio data (the file never has to be loaded completely) and can be stored 
+*	in a cache directory using the hash code of the sample, so it only needs to be calculated once.
+*/
+class PeakPyramid : public ReferenceCountedObject
+{
+public:
+
+	typedef ReferenceCountedObjectPtr<PeakPyramid> Ptr;
+
+	enum
+	{
+		BaseSamplesPerPeak = 64,
+		ReductionFactor = 4,
+		MinNumPeaks = 32,
+		ChunkSize = 65536,
+		MaxNumChannels = 2
+	};
+
+	/** A level of the pyramid. The peaks are stored as interleaved 16bit min / max values. */
+	struct Level
+	{
+		Level(int samplesPerPeak, int numPeaks, int numChannels);
+
+		Range<float> getPeak(int channel, int index) const noexcept;
+
+		const int samplesPerPeak;
+		const int numPeaks;
+
+		HeapBlock<int16> data[MaxNumChannels];
+
+		JUCE_DECLARE_NON_COPYABLE(Level)
+	};
+
+	/** Creates the pyramid from consecutive blocks of audio data. */
+	class Builder
+	{
+	public:
+
+		Builder(int numChannels, int64 lengthInSamples);
+
+		/** Adds the next block of samples. */
+		void addBlock(const AudioSampleBuffer& buffer, int numSamples);
+
+		/** Calculates the upper levels and returns the pyramid. Call this after all samples were added. */
+		PeakPyramid* createPyramid();
+
+	private:
+
+		void storeCurrentPeak();
+
+		const int numChannels;
+		const int64 lengthInSamples;
+
+		ScopedPointer<Level> baseLevel;
+
+		int peakIndex = 0;
+		int samplesInCurrentPeak = 0;
+		Range<float> currentPeak[MaxNumChannels];
+
+		JUCE_DECLARE_NON_COPYABLE(Builder)
+	};
+
+	// ================================================================================================================
+
+	/** Reads the file in chunks and creates the pyramid. Returns nullptr if the thread should exit. */
+	static PeakPyramid* createFromReader(AudioFormatReader& reader, Thread* threadToCheck=nullptr);
+
+	/** Loads the pyramid from the given file. 
+	*
+	*	Only the levels that are needed for the given resolution will be read. It returns nullptr if the file does 
+	*	not exist or if it was created for a sample with another size.
+	*/
+	static PeakPyramid* loadFromFile(const File& file, int numChannels, int64 lengthInSamples, double samplesPerPixel=0.0);
+
+	/** Writes all levels into the given file. */
+	bool saveToFile(const File& file) const;
+
+	/** Returns the file for the sample with the given hash code in the cache directory. */
+	static File getCacheFile(const File& cacheDirectory, int64 hashCode);
+
+	// ================================================================================================================
+
+	int getNumChannels() const noexcept { return numChannels; }
+
+	int64 getLengthInSamples() const noexcept { return lengthInSamples; }
+
+	/** Checks if the pyramid contains a level with at least one peak per pixel. */
+	bool hasResolution(double samplesPerPixel) const noexcept;
+
+	/** Returns the min / max values of the given sample range. */
+	Range<float> getPeak(int channel, int64 startSample, int64 endSample) const noexcept;
+
+	/** Returns the min / max values of the whole sample. */
+	Range<float> getTotalPeak(int channel) const noexcept;
+
+	/** Returns the amount of bytes used by the loaded levels. */
+	size_t getMemoryUsage() const noexcept;
+
+private:
+
+	PeakPyramid(int numChannels, int64 lengthInSamples);
+
+	const Level* getLevelForSamplesPerPixel(double samplesPerPixel) const noexcept;
+
+	const int numChannels;
+	const int64 lengthInSamples;
+
+	/** The loaded levels, starting with the finest one. */
+	OwnedArray<Level> levels;
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(PeakPyramid)
+};
+
+} // namespace hise
+
+#endif  // PEAKPYRAMID_H_INCLUDED
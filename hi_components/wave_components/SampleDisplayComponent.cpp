@@ -57,27 +57,28 @@ SamplerSoundWaveform::SamplerSoundWaveform(const ModulatorSampler *ownerSampler)
 
 	setOpaque(true);
 
-#ifdef JUCE_DEBUG
-
-	startTimer(30);
-
-#else
-
-	startTimer(30);
-
-#endif
-
-	
+	sampler->getMainController()->getTelemetryRing().addSubscriber(sampler, this);
 };
 
 SamplerSoundWaveform::~SamplerSoundWaveform()
 {
+	sampler->getMainController()->getTelemetryRing().removeSubscriber(this);
+
     if(currentSound.get() != nullptr)
         currentSound->removeChangeListener(this);
 	
 }
 
-void SamplerSoundWaveform::timerCallback() 
+void SamplerSoundWaveform::telemetryReceived(const TelemetryRing::Record& r)
+{
+	if (r.type == TelemetryRing::PlaybackPosition)
+	{
+		lastPlaybackPosition = r.position;
+		lastSampleStartPosition = (double)r.value;
+	}
+}
+
+void SamplerSoundWaveform::telemetryDrained() 
 {
 	if(sampler->getLastStartedVoice() != nullptr)
 	{
@@ -85,8 +86,8 @@ void SamplerSoundWaveform::timerCallback()
 
 		if(s == currentSound)
 		{
-			sampleStartPosition = sampler->getSamplerDisplayValues().currentSampleStartPos;
-			setPlaybackPosition(sampler->getSamplerDisplayValues().currentSamplePos);
+			sampleStartPosition = lastSampleStartPosition;
+			setPlaybackPosition(lastPlaybackPosition);
 		}
         else
         {
@@ -261,6 +262,7 @@ void SamplerSoundWaveform::setSoundToDisplay(const ModulatorSamplerSound *s, int
 		{
 			numSamplesInCurrentSample = (int)afr->lengthInSamples;
 
+			preview->setPeakCacheDirectory(ThumbnailHandler::getPeakCacheDirectory(const_cast<ModulatorSampler*>(sampler)));
 			preview->setReader(afr.release(), sound->getHashCode());
 
 			updateRanges();
@@ -786,6 +788,8 @@ void HiseAudioThumbnail::LoadingThread::run()
 	var lb;
 	var rb;
 	ScopedPointer<AudioFormatReader> reader;
+	PeakPyramid::Ptr pyramid;
+	File cacheFile;
 
 	{
 		if (parent.get() == nullptr)
@@ -794,11 +798,16 @@ void HiseAudioThumbnail::LoadingThread::run()
 		ScopedLock sl(parent->lock);
 
 		bounds = parent->getBounds();
+		cacheFile = parent->peakCacheFile;
 
 		if (parent->currentReader != nullptr)
 		{
 			reader.swapWith(parent->currentReader);
 		}
+		else if (parent->pyramid != nullptr)
+		{
+			pyramid = parent->pyramid;
+		}
 		else
 		{
 			lb = parent->lBuffer;
@@ -806,93 +815,60 @@ void HiseAudioThumbnail::LoadingThread::run()
 		}
 	}
 
+	float width = (float)bounds.getWidth();
+
 	if (reader != nullptr)
 	{
-		VariantBuffer::Ptr l = new VariantBuffer((int)reader->lengthInSamples);
-		VariantBuffer::Ptr r;
+		const double samplesPerPixel = (double)reader->lengthInSamples / (double)jmax<int>(1, bounds.getWidth());
 
-		if (reader->numChannels > 1)
-			r = new VariantBuffer((int)reader->lengthInSamples);
+		if (cacheFile != File())
+			pyramid = PeakPyramid::loadFromFile(cacheFile, (int)reader->numChannels, reader->lengthInSamples, samplesPerPixel);
 
-		float* d[2];
-
-		d[0] = l->buffer.getWritePointer(0);
-		d[1] = r != nullptr ? r->buffer.getWritePointer(0) : nullptr;
-
-		AudioSampleBuffer tempBuffer = AudioSampleBuffer(d, reader->numChannels, (int)reader->lengthInSamples);
-		
-
-		if (threadShouldExit())
-			return;
-
-		reader->read(&tempBuffer, 0, (int)reader->lengthInSamples, 0, true, true);
-
-		if (threadShouldExit())
-			return;
+		if (pyramid == nullptr)
+		{
+			pyramid = PeakPyramid::createFromReader(*reader, this);
 
-		lb = var(l);
+			if (pyramid == nullptr)
+				return;
 
-		if (reader->numChannels > 1)
-		{
-			rb = var(r);
+			if (cacheFile != File())
+				pyramid->saveToFile(cacheFile);
 		}
+	}
+	else if (pyramid != nullptr && cacheFile != File())
+	{
+		const double samplesPerPixel = (double)pyramid->getLengthInSamples() / (double)jmax<int>(1, bounds.getWidth());
 
-		if (parent.get() != nullptr)
+		// The levels that were loaded are too coarse for the new size
+		if (!pyramid->hasResolution(samplesPerPixel))
 		{
-			ScopedLock sl(parent->lock);
-
-			parent->lBuffer = lb;
-			parent->rBuffer = rb;
+			if (auto finerPyramid = PeakPyramid::loadFromFile(cacheFile, pyramid->getNumChannels(), pyramid->getLengthInSamples(), samplesPerPixel))
+				pyramid = finerPyramid;
 		}
 	}
 
+	if (threadShouldExit())
+		return;
+
 	Path lPath;
 	Path rPath;
 
-	float width = (float)bounds.getWidth();
+	Range<float> lLevels;
+	Range<float> rLevels;
 
-	if (auto l = lb.getBuffer())
+	if (pyramid != nullptr)
 	{
-		if (l->size != 0)
-		{
-			const float* data = l->buffer.getReadPointer(0);
-			const int numSamples = l->size;
+		calculatePath(lPath, width, *pyramid, 0);
+		lLevels = pyramid->getTotalPeak(0);
 
-			calculatePath(lPath, width, data, numSamples);
-		}
-	}
-
-	if (auto r = rb.getBuffer())
-	{
-		if (r->size != 0)
+		if (pyramid->getNumChannels() > 1)
 		{
-			const float* data = r->buffer.getReadPointer(0);
-			const int numSamples = r->size;
-
-			calculatePath(rPath, width, data, numSamples);
-		}
-	}
-	
-	const bool isMono = rPath.isEmpty();
-
-	if (isMono)
-	{
-		if (auto l = lb.getBuffer())
-		{
-			if (l->size != 0)
-			{
-				const float* data = l->buffer.getReadPointer(0);
-				const int numSamples = l->size;
-
-				scalePathFromLevels(lPath, { 0.0f, 0.0f, (float)bounds.getWidth(), (float)bounds.getHeight() }, data, numSamples);
-			}
+			calculatePath(rPath, width, *pyramid, 1);
+			rLevels = pyramid->getTotalPeak(1);
 		}
 	}
 	else
 	{
-
-		float h = (float)bounds.getHeight() / 2.0f;
-
 		if (auto l = lb.getBuffer())
 		{
 			if (l->size != 0)
@@ -900,11 +876,9 @@ void HiseAudioThumbnail::LoadingThread::run()
 				const float* data = l->buffer.getReadPointer(0);
 				const int numSamples = l->size;
 
-				scalePathFromLevels(lPath, { 0.0f, 0.0f, (float)bounds.getWidth(), h }, data, numSamples);
+				calculatePath(lPath, width, data, numSamples);
+				lLevels = FloatVectorOperations::findMinAndMax(data, numSamples);
 			}
-				
-
-			
 		}
 
 		if (auto r = rb.getBuffer())
@@ -914,10 +888,24 @@ void HiseAudioThumbnail::LoadingThread::run()
 				const float* data = r->buffer.getReadPointer(0);
 				const int numSamples = r->size;
 
-				scalePathFromLevels(rPath, { 0.0f, h, (float)bounds.getWidth(), h }, data, numSamples);
+				calculatePath(rPath, width, data, numSamples);
+				rLevels = FloatVectorOperations::findMinAndMax(data, numSamples);
 			}
 		}
+	}
+	
+	const bool isMono = rPath.isEmpty();
 
+	if (isMono)
+	{
+		scalePathFromLevels(lPath, { 0.0f, 0.0f, (float)bounds.getWidth(), (float)bounds.getHeight() }, lLevels);
+	}
+	else
+	{
+		float h = (float)bounds.getHeight() / 2.0f;
+
+		scalePathFromLevels(lPath, { 0.0f, 0.0f, (float)bounds.getWidth(), h }, lLevels);
+		scalePathFromLevels(rPath, { 0.0f, h, (float)bounds.getWidth(), h }, rLevels);
 	}
 
 	{
@@ -925,6 +913,17 @@ void HiseAudioThumbnail::LoadingThread::run()
 		{
 			ScopedLock sl(parent->lock);
 
+			if (reader != nullptr && parent->currentReader == nullptr)
+			{
+				parent->pyramid = pyramid;
+				parent->lBuffer = var();
+				parent->rBuffer = var();
+			}
+			else if (pyramid != nullptr && parent->pyramid != nullptr)
+			{
+				parent->pyramid = pyramid;
+			}
+
 			parent->leftWaveform.swapWithPath(lPath);
 			parent->rightWaveform.swapWithPath(rPath);
 			parent->isClear = false;
@@ -935,13 +934,11 @@ void HiseAudioThumbnail::LoadingThread::run()
 	}
 }
 
-void HiseAudioThumbnail::LoadingThread::scalePathFromLevels(Path &p, Rectangle<float> bounds, const float* data, const int numSamples)
+void HiseAudioThumbnail::LoadingThread::scalePathFromLevels(Path &p, Rectangle<float> bounds, Range<float> levels)
 {
 	if (p.isEmpty())
 		return;
 
-	auto levels = FloatVectorOperations::findMinAndMax(data, numSamples);
-
 	if (levels.isEmpty())
 	{
 		p.clear();
@@ -1008,6 +1005,43 @@ void HiseAudioThumbnail::LoadingThread::calculatePath(Path &p, float width, cons
 	}
 }
 
+void HiseAudioThumbnail::LoadingThread::calculatePath(Path &p, float width, const PeakPyramid& pyramid, int channel)
+{
+	const int64 numSamples = pyramid.getLengthInSamples();
+
+	int64 stride = (int64)roundToInt((double)numSamples / (double)width);
+	stride = jmax<int64>(1, stride * 2);
+
+	p.clear();
+
+	if (numSamples == 0)
+		return;
+
+	p.startNewSubPath(0.0f, 0.0f);
+
+	for (int64 i = stride; i < numSamples; i += stride)
+	{
+		if (threadShouldExit())
+			return;
+
+		auto value = jmax<float>(0.0f, pyramid.getPeak(channel, i, jmin<int64>(i + stride, numSamples)).getEnd());
+
+		p.lineTo((float)i, -1.0f * value);
+	}
+
+	for (int64 i = numSamples - 1; i > 0; i -= stride)
+	{
+		if (threadShouldExit())
+			return;
+
+		auto value = jmin<float>(0.0f, pyramid.getPeak(channel, i, jmin<int64>(i + stride, numSamples)).getStart());
+
+		p.lineTo((float)i, -1.0f * value);
+	}
+
+	p.closeSubPath();
+}
+
 HiseAudioThumbnail::HiseAudioThumbnail() :
 	loadingThread(this)
 {
@@ -1026,6 +1060,8 @@ HiseAudioThumbnail::~HiseAudioThumbnail()
 void HiseAudioThumbnail::setBuffer(var bufferL, var bufferR /*= var()*/)
 {
 	currentReader = nullptr;
+	pyramid = nullptr;
+	peakCacheFile = File();
 
 	const bool shouldBeNotEmpty = bufferL.isBuffer() && bufferL.getBuffer()->size != 0;
 	const bool isNotEmpty = lBuffer.isBuffer() && lBuffer.getBuffer()->size != 0;
@@ -1085,7 +1121,7 @@ void HiseAudioThumbnail::paint(Graphics& g)
 
 void HiseAudioThumbnail::drawSection(Graphics &g, bool enabled)
 {
-	bool isStereo = rBuffer.isBuffer();
+	bool isStereo = !rightWaveform.isEmpty();
 
 	Colour fillColour = findColour(AudioDisplayComponent::ColourIds::fillColour);
 	Colour outlineColour = findColour(AudioDisplayComponent::ColourIds::outlineColour);
@@ -1140,9 +1176,15 @@ void HiseAudioThumbnail::drawSection(Graphics &g, bool enabled)
 	}
 }
 
-void HiseAudioThumbnail::setReader(AudioFormatReader* r, int64 /*unused*/)
+void HiseAudioThumbnail::setReader(AudioFormatReader* r, int64 hashCode)
 {
-	currentReader = r;
+	{
+		ScopedLock sl(lock);
+
+		currentReader = r;
+		pyramid = nullptr;
+		peakCacheFile = peakCacheDirectory != File() ? PeakPyramid::getCacheFile(peakCacheDirectory, hashCode) : File();
+	}
 
 	if (currentReader != nullptr)
 	{
@@ -1165,6 +1207,8 @@ void HiseAudioThumbnail::clear()
 	isClear = true;
 
 	currentReader = nullptr;
+	pyramid = nullptr;
+	peakCacheFile = File();
 
 	repaint();
 }
@@ -66,7 +66,17 @@ public:
 		return lengthInSeconds;
 	}
 	
-	void setReader(AudioFormatReader* r, int64 unused);
+	/** Displays the audio file of the reader (the thumbnail takes ownership). 
+	*
+	*	The waveform is drawn from a PeakPyramid, which will be stored in the peak cache directory using the hash code.
+	*/
+	void setReader(AudioFormatReader* r, int64 hashCode);
+
+	/** Sets the directory that is used to store the PeakPyramid of the samples. */
+	void setPeakCacheDirectory(const File& directory)
+	{
+		peakCacheDirectory = directory;
+	}
 
 	void clear();
 
@@ -133,10 +143,12 @@ private:
 
 		void run() override;;
 
-		void scalePathFromLevels(Path &lPath, Rectangle<float> bounds, const float* data, const int numSamples);
+		void scalePathFromLevels(Path &lPath, Rectangle<float> bounds, Range<float> levels);
 
 		void calculatePath(Path &p, float width, const float* l_, int numSamples);
 
+		void calculatePath(Path &p, float width, const PeakPyramid& pyramid, int channel);
+
 	private:
 
 		
@@ -158,6 +170,10 @@ private:
 	var lBuffer;
 	var rBuffer;
 
+	PeakPyramid::Ptr pyramid;
+	File peakCacheDirectory;
+	File peakCacheFile;
+
 	bool isClear = true;
 	bool drawHorizontalLines = false;
 
@@ -542,7 +558,7 @@ private:
 *	It uses a timer to display the current playbar.
 */
 class SamplerSoundWaveform: public AudioDisplayComponent,
-							public Timer,
+							public TelemetryRing::Subscriber,
                             public SafeChangeListener
 {
 public:
@@ -566,8 +582,11 @@ public:
 
 	
 
+	/** Receives the playing positions / sample start position from the sampler. */
+	void telemetryReceived(const TelemetryRing::Record& r) override;
+
 	/** used to display the playing positions / sample start position. */
-	void timerCallback() override;
+	void telemetryDrained() override;
 
 	
     void changeListenerCallback(SafeChangeBroadcaster* /*b*/) override
@@ -612,6 +631,9 @@ private:
 	
 	double sampleStartPosition;
 
+	double lastPlaybackPosition = -1.0;
+	double lastSampleStartPosition = 0.0;
+
 	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(SamplerSoundWaveform)
 };
 
@@ -61,6 +61,11 @@
 #define HISE_SMOOTH_FIRST_MOD_BUFFER 0
 #endif
 
+/** The amount of decoded image data (in megabytes) that is kept in memory for all plugin instances. */
+#ifndef HISE_IMAGE_POOL_BUDGET_MB
+#define HISE_IMAGE_POOL_BUDGET_MB 256
+#endif
+
 namespace hise { using namespace juce;
 
 #if ENABLE_STARTUP_LOG
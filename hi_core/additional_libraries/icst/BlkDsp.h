@@ -57,9 +57,7 @@ public:
 
 private:
 
-#if USE_IPP
 	juce::ScopedPointer<hise::IppFFT> fftData;
-#endif
 
 };
 
@@ -190,6 +190,24 @@ If this is set to 1, the application will crash instantly if there is a drop out
 #define ENABLE_SCRIPTING_BREAKPOINTS 0
 #endif
 
+/** Config: ENABLE_SCRIPTING_BYTECODE
+
+Set this to 0 to deactivate the bytecode compilation of callbacks and inline functions and always execute the syntax tree.
+*/
+#ifndef ENABLE_SCRIPTING_BYTECODE
+#define ENABLE_SCRIPTING_BYTECODE 1
+#endif
+
+/** Config: ENABLE_SCRIPTING_ALLOCATION_TRACER
+
+Set this to 1 to trace the heap allocations of script callbacks that run on the audio thread. This replaces the global
+operator new and executes the syntax tree instead of the bytecode, so the statement that allocated can be reported 
+to the DebugLogger. Don't use this in a release build.
+*/
+#ifndef ENABLE_SCRIPTING_ALLOCATION_TRACER
+#define ENABLE_SCRIPTING_ALLOCATION_TRACER 0
+#endif
+
 /** Config: ENABLE_ALL_PEAK_METERS
 
 Set this to 0 to deactivate peak collection for any other processor than the main synth chain
@@ -33,6 +33,83 @@ void StartupLogger::log(const String& message)
 bool StartupLogger::isInitialised = false;
 #endif
 
+struct StartupTraceRecorder::Data
+{
+	Data() :
+		startTicks(Time::getHighResolutionTicks())
+	{
+		const String path = SystemStats::getEnvironmentVariable("HISE_STARTUP_TRACE", String());
+
+		if (path.isEmpty() || !File::isAbsolutePath(path))
+			return;
+
+		File traceFile(path);
+
+		traceFile.deleteFile();
+
+		output = new FileOutputStream(traceFile);
+
+		if (output->failedToOpen())
+		{
+			output = nullptr;
+			return;
+		}
+
+		// The closing bracket is optional in the trace event format, so the file is valid after every zone
+		*output << "[\n";
+		output->flush();
+
+		enabled = true;
+	}
+
+	CriticalSection lock;
+	ScopedPointer<FileOutputStream> output;
+	const int64 startTicks;
+	bool enabled = false;
+};
+
+StartupTraceRecorder::Data& StartupTraceRecorder::getData()
+{
+	static Data data;
+	return data;
+}
+
+bool StartupTraceRecorder::isEnabled()
+{
+	return getData().enabled;
+}
+
+void StartupTraceRecorder::addZone(const char* name, const String& detail, int64 startTicks, int64 endTicks)
+{
+	auto& d = getData();
+
+	auto toMicroSeconds = [&d](int64 ticks)
+	{
+		return (int64)(Time::highResolutionTicksToSeconds(ticks - d.startTicks) * 1000000.0);
+	};
+
+	String event;
+
+	event << "{\"name\":" << JSON::toString(var(String(name)));
+	event << ",\"cat\":\"startup\",\"ph\":\"X\"";
+	event << ",\"ts\":" << String(toMicroSeconds(startTicks));
+	event << ",\"dur\":" << String(toMicroSeconds(endTicks) - toMicroSeconds(startTicks));
+	event << ",\"pid\":1,\"tid\":" << String((int64)(pointer_sized_int)Thread::getCurrentThreadId());
+
+	if (detail.isNotEmpty())
+		event << ",\"args\":{\"detail\":" << JSON::toString(var(detail)) << "}";
+
+	event << "},\n";
+
+	ScopedLock sl(d.lock);
+
+	if (d.output != nullptr)
+	{
+		*d.output << event;
+		d.output->flush();
+	}
+}
+
 struct DebugLogger::Message
 {
 	Message() {};
@@ -519,6 +596,16 @@ void DebugLogger::checkAssertion(Processor* p, Location location, bool result, d
 }
 
 
+void DebugLogger::logScriptAllocation(Processor* p, const Identifier& callbackId, const String& message, int numAllocations)
+{
+	if (!isLogging()) return;
+
+	Failure f(messageIndex++, callbackIndex, Location::ScriptCallback, FailureType::ScriptAllocation, p, getCurrentTimeStamp(), (double)numAllocations, callbackId);
+	addFailure(f);
+
+	logMessage(message);
+}
+
 bool DebugLogger::checkIsSoftBypassed(const ModulatorSynth* synth, Location location)
 {
 	auto silence = synth->getMainController()->getMainSynthChain()->areVoicesActive();
@@ -866,6 +953,7 @@ String DebugLogger::getNameForLocation(Location l)
 		RETURN_CASE_STRING_LOCATION(NoteOffCallback);
 		RETURN_CASE_STRING_LOCATION(MasterEffectRendering);
 		RETURN_CASE_STRING_LOCATION(ScriptMidiEventCallback);
+		RETURN_CASE_STRING_LOCATION(ScriptCallback);
 		RETURN_CASE_STRING_LOCATION(ConvolutionRendering);
 		RETURN_CASE_STRING_LOCATION(DeleteOneSample);
 		RETURN_CASE_STRING_LOCATION(DeleteAllSamples);
@@ -904,6 +992,7 @@ String DebugLogger::getNameForFailure(FailureType f)
 		RETURN_CASE_STRING_FAILURE(SampleLoadingError);
 		RETURN_CASE_STRING_FAILURE(StreamingFailure);
 		RETURN_CASE_STRING_FAILURE(SoftBypassFailure);
+		RETURN_CASE_STRING_FAILURE(ScriptAllocation);
         RETURN_CASE_STRING_FAILURE(numFailureTypes);
 	}
 
@@ -70,6 +70,7 @@ public:
 		SampleLoadingError,
 		StreamingFailure,
 		SoftBypassFailure,
+		ScriptAllocation, //< a script callback on the audio thread allocated memory
 		numFailureTypes
 	};
 
@@ -113,6 +114,7 @@ public:
 		SampleMapLoading,
 		SampleMapLoadingFromFile,
 		SamplePreloadThread,
+		ScriptCallback,
 		numLocations
 	};
 
@@ -193,6 +195,9 @@ public:
 
 	void checkAssertion(Processor* p, Location location, bool result, double extraData);
 
+	/** Logs a script callback that allocated memory on the audio thread (the message contains the code location). */
+	void logScriptAllocation(Processor* p, const Identifier& callbackId, const String& message, int numAllocations);
+
 	bool checkIsSoftBypassed(const ModulatorSynth* synth, Location location);
 
 	void checkPriorityInversion(const CriticalSection& lockToCheck);
@@ -385,6 +390,69 @@ private:
 #define CHECK_AND_LOG_ASSERTION(processor, location, result, extraData) if(processor != nullptr) processor->getMainController()->getDebugLogger().checkAssertion(processor, location, result, (double)extraData);
 
 
+/** Records the duration of the loading steps and writes them as Chrome trace event JSON.
+*
+*	Set the environment variable HISE_STARTUP_TRACE to the path of the output file before starting the 
+*	host, and open the file in chrome://tracing (or https://ui.perfetto.dev) to see where the load time goes.
+*	Every zone is written when it ends, so the file is usable even if the plugin is never closed properly.
+*
+*	If the variable is not set, a zone just checks a flag, so you can leave them in the code.
+*	Use the TRACE_STARTUP_ZONE macros instead of creating the ScopedZone objects directly.
+*/
+class StartupTraceRecorder
+{
+public:
+
+	class ScopedZone
+	{
+	public:
+
+		/** The name must be a string literal. */
+		ScopedZone(const char* name_) :
+			name(name_),
+			startTicks(isEnabled() ? Time::getHighResolutionTicks() : 0)
+		{}
+
+		/** The detail is added as argument (eg. the ID of a processor). The function is only called if the tracing is enabled. */
+		template <typename DetailFunction> ScopedZone(const char* name_, const DetailFunction& createDetail) :
+			name(name_),
+			startTicks(isEnabled() ? Time::getHighResolutionTicks() : 0)
+		{
+			if (startTicks != 0)
+				detail = createDetail();
+		}
+
+		~ScopedZone()
+		{
+			if (startTicks != 0)
+				addZone(name, detail, startTicks, Time::getHighResolutionTicks());
+		}
+
+	private:
+
+		const char* name;
+		String detail;
+		const int64 startTicks;
+
+		JUCE_DECLARE_NON_COPYABLE(ScopedZone)
+	};
+
+	/** Returns true if the environment variable is set. */
+	static bool isEnabled();
+
+private:
+
+	struct Data;
+
+	static Data& getData();
+
+	static void addZone(const char* name, const String& detail, int64 startTicks, int64 endTicks);
+};
+
+#define TRACE_STARTUP_ZONE(name) hise::StartupTraceRecorder::ScopedZone JUCE_JOIN_MACRO(startupZone_, __LINE__)(name)
+#define TRACE_STARTUP_ZONE_WITH_DETAIL(name, detail) hise::StartupTraceRecorder::ScopedZone JUCE_JOIN_MACRO(startupZone_, __LINE__)(name, [&]() { return String(detail); })
+
+
 class DebugLoggerComponent : public Component,
 							 public DebugLogger::Listener,
 							 public Button::Listener,
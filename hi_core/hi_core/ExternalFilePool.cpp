@@ -64,7 +64,10 @@ String ImagePool::getFileNameForId(Identifier identifier) const
 
 void ImagePool::clearData()
 {
+	ScopedLock sl(lock);
+
 	loadedImages.clear();
+	embeddedHashCodes.clear();
 }
 
 StringArray ImagePool::getTextDataForId(int index) const
@@ -74,7 +77,7 @@ StringArray ImagePool::getTextDataForId(int index) const
 
 void ImagePool::storeItemInValueTree(ValueTree& child, int i) const
 {
-	auto e = loadedImages[i];
+	const auto& e = loadedImages.getReference(i);
 
 	child.setProperty("ID", e.id.toString(), nullptr);
 	child.setProperty("FileName", e.fileName, nullptr);
@@ -92,28 +95,25 @@ void ImagePool::restoreItemFromValueTree(ValueTree& child)
 {
 	Identifier id = Identifier(child.getProperty("ID", String()).toString());
 
+	ScopedLock sl(lock);
+
 	if (loadedImages.indexOf(id) != -1)
 		return;
 
-	var x = child.getProperty("Data", var::undefined());
-
-	MemoryBlock *mb = x.getBinaryData();
-
-	jassert(mb != nullptr);
-
-	ScopedPointer<MemoryInputStream> mis = new MemoryInputStream(*mb, false);
+	jassert(child.getProperty("Data").getBinaryData() != nullptr);
 
+	// The image is decoded when it is used for the first time, so we just keep a reference to the compressed data.
 	ImageEntry ne;
 
 	ne.fileName = child.getProperty("FileName", String()).toString();
 	jassert(ne.fileName.isNotEmpty());
 
 	ne.id = id;
-	ne.data = ImageFileFormat::loadFrom(mis->getData(), mis->getDataSize());
-
-	mis = nullptr;
+	ne.data = child;
 
-	ImageCache::addImageToCache(ne.data, ne.fileName.hashCode64());
+	// The hash of the compressed data is calculated once, so the lookup of the decoded image stays cheap
+	if (auto mb = child.getProperty("Data").getBinaryData())
+		embeddedHashCodes.set(id.toString(), MD5(*mb).toHexString().hashCode64());
 
 	notifyTable();
 
@@ -174,34 +174,211 @@ StringArray ImagePool::getFileNameList() const
 {
 	StringArray sa;
 
-	for (auto e : loadedImages)
+	for (const auto& e : loadedImages)
 		sa.add(e.fileName);
 
 	return sa;
 }
 
 Image ImagePool::loadFileIntoPool(const String& fileName)
+{
+	ImageEntry e;
+
+	int64 hashCode;
+
+	{
+		ScopedLock sl(lock);
+		e = loadedImages.getReference(getIndexForFileName(fileName));
+		hashCode = getHashCode(e);
+	}
+
+	Image img = decodedImages->get(hashCode);
+
+	if (img.isValid())
+		return img;
+
+	return decodeImage(e, hashCode);
+}
+
+int64 ImagePool::registerFile(const String& fileName)
+{
+	ScopedLock sl(lock);
+
+	return getHashCode(loadedImages.getReference(getIndexForFileName(fileName)));
+}
+
+Image ImagePool::getImage(const String& fileName, int64 hashCode)
+{
+	Image img = decodedImages->get(hashCode);
+
+	if (img.isValid())
+		return img;
+
+	ImageEntry e;
+
+	{
+		ScopedLock sl(lock);
+		e = loadedImages.getReference(getIndexForFileName(fileName));
+	}
+
+	return decodeImage(e, hashCode);
+}
+
+int ImagePool::getIndexForFileName(const String& fileName)
 {
 	Identifier idForFileName = getIdForFileName(fileName);
 
 	const int existingIndex = loadedImages.indexOf(idForFileName);
 
 	if (existingIndex != -1)
-	{
-		return loadedImages[existingIndex].data;
-	}
+		return existingIndex;
 
 	ImageEntry ne;
 	ne.id = idForFileName;
 	ne.fileName = fileName;
 
-	File f = getFileFromFileNameString(fileName);
+	loadedImages.add(ne);
+
+	return loadedImages.size() - 1;
+}
+
+int64 ImagePool::getHashCode(const ImageEntry& e)
+{
+	if (e.data.isValid())
+	{
+		// Embedded images share the decoded image across all instances if the compressed data is identical.
+		// The data is hashed, because other plugins (or another version of this one) might use the same file name.
+		return embeddedHashCodes[e.id.toString()];
+	}
 
-	ne.data = ImageCache::getFromFile(f);
+	File f = getFileFromFileNameString(e.fileName);
 
-	loadedImages.add(ne);
+	return (f.getFullPathName() + String(f.getLastModificationTime().toMilliseconds())).hashCode64();
+}
+
+Image ImagePool::decodeImage(const ImageEntry& e, int64 hashCode)
+{
+	Image img;
+
+	TRACE_STARTUP_ZONE_WITH_DETAIL("Decode image", e.fileName);
+
+	if (e.data.isValid())
+	{
+		if (const MemoryBlock* mb = e.data.getProperty("Data").getBinaryData())
+			img = ImageFileFormat::loadFrom(mb->getData(), mb->getSize());
+	}
+	else
+	{
+		img = ImageFileFormat::loadFrom(getFileFromFileNameString(e.fileName));
+	}
+
+	if (img.isValid())
+		return decodedImages->add(hashCode, img);
+
+	return img;
+}
+
+void ImagePool::LazyImage::setReference(ImagePool* pool_, const String& fileName_)
+{
+	pool = pool_;
+	fileName = fileName_;
+
+	hashCode = pool->registerFile(fileName);
+}
 
-	return ne.data;
+void ImagePool::LazyImage::clear()
+{
+	pool = nullptr;
+	fileName = String();
+	hashCode = 0;
+}
+
+Image ImagePool::LazyImage::get() const
+{
+	if (pool == nullptr || fileName.isEmpty())
+		return Image();
+
+	auto img = pool->getImage(fileName, hashCode);
+
+#if USE_FRONTEND
+	jassert(img.isValid());
+#endif
+
+	return img;
+}
+
+Image ImagePool::DecodedImageCache::get(int64 hashCode)
+{
+	ScopedLock sl(lock);
+
+	for (auto& item : items)
+	{
+		if (item.hashCode == hashCode)
+		{
+			item.lastAccess = ++accessCounter;
+			return item.image;
+		}
+	}
+
+	return Image();
+}
+
+Image ImagePool::DecodedImageCache::add(int64 hashCode, const Image& image)
+{
+	ScopedLock sl(lock);
+
+	for (auto& item : items)
+	{
+		if (item.hashCode == hashCode)
+		{
+			item.lastAccess = ++accessCounter;
+			return item.image;
+		}
+	}
+
+	Item newItem;
+	newItem.hashCode = hashCode;
+	newItem.image = image;
+	newItem.lastAccess = ++accessCounter;
+
+	items.add(newItem);
+
+	decodedBytes += (size_t)image.getWidth() * (size_t)image.getHeight() * sizeof(uint32);
+
+	releaseUnusedImages();
+
+	return image;
+}
+
+void ImagePool::DecodedImageCache::releaseUnusedImages()
+{
+	const size_t budget = (size_t)HISE_IMAGE_POOL_BUDGET_MB * 1024 * 1024;
+
+	while (decodedBytes > budget)
+	{
+		int oldestIndex = -1;
+
+		for (int i = 0; i < items.size(); i++)
+		{
+			const auto& item = items.getReference(i);
+
+			// Images that are still used by a component must stay in the cache
+			if (item.image.getReferenceCount() > 1)
+				continue;
+
+			if (oldestIndex == -1 || item.lastAccess < items.getReference(oldestIndex).lastAccess)
+				oldestIndex = i;
+		}
+
+		if (oldestIndex == -1)
+			return;
+
+		const auto& oldest = items.getReference(oldestIndex);
+
+		decodedBytes -= (size_t)oldest.image.getWidth() * (size_t)oldest.image.getHeight() * sizeof(uint32);
+
+		items.remove(oldestIndex);
+	}
 }
 
 void SharedPoolBase::notifyTable()
@@ -298,6 +475,8 @@ ValueTree SharedPoolBase::exportAsValueTree() const
 
 void SharedPoolBase::restoreFromValueTree(const ValueTree &v)
 {
+	TRACE_STARTUP_ZONE_WITH_DETAIL("Restore pool", getFileTypeName().toString());
+
 	clearData();
 
 	for (int i = 0; i < v.getNumChildren(); i++)
@@ -362,6 +541,9 @@ StringArray AudioSampleBufferPool::getTextDataForId(int index) const
 void AudioSampleBufferPool::clearData()
 {
 	loadedSamples.clear();
+
+	ScopedLock sl(sharedDataLock);
+	sharedData.clear();
 }
 
 void AudioSampleBufferPool::storeItemInValueTree(ValueTree& child, int i) const
@@ -450,6 +632,52 @@ double AudioSampleBufferPool::getSampleRateForFile(const Identifier& id)
 	return 0.0;
 }
 
+ReferenceCountedObjectPtr<ReferenceCountedObject> AudioSampleBufferPool::getSharedData(const String& key)
+{
+	ScopedLock sl(sharedDataLock);
+
+	// The reference is created while the lock is held, so removeUnusedSharedData() can't delete it
+	for (const auto& d : sharedData)
+	{
+		if (d.key == key)
+			return d.data;
+	}
+
+	return nullptr;
+}
+
+void AudioSampleBufferPool::addSharedData(const String& key, ReferenceCountedObject* newData)
+{
+	ScopedLock sl(sharedDataLock);
+
+	removeUnusedSharedData();
+
+	for (auto& d : sharedData)
+	{
+		if (d.key == key)
+		{
+			d.data = newData;
+			return;
+		}
+	}
+
+	SharedData d;
+	d.key = key;
+	d.data = newData;
+
+	sharedData.add(d);
+}
+
+void AudioSampleBufferPool::removeUnusedSharedData()
+{
+	for (int i = 0; i < sharedData.size(); i++)
+	{
+		// The pool holds the only reference
+		if (sharedData[i].data == nullptr || sharedData[i].data->getReferenceCount() == 1)
+			sharedData.remove(i--);
+	}
+}
+
 void AudioSampleBufferPool::loadFromStream(BufferEntry& ne, InputStream* ownedStream)
 {
 	ScopedPointer<AudioFormatReader> reader = afm.createReaderFor(ownedStream);
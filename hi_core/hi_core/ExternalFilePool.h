@@ -179,8 +179,30 @@ public:
 
 	double getSampleRateForFile(const Identifier& id);
 
+	/** Returns the object that was stored with addSharedData() for the given key or nullptr.
+	*
+	*	This can be used to share data that is derived from a pooled file and expensive to calculate 
+	*	(eg. the spectra of an impulse response) between multiple processors. The data must not be changed after it was added,
+	*	so the key should contain everything the data depends on (including a hash of the content).
+	*/
+	ReferenceCountedObjectPtr<ReferenceCountedObject> getSharedData(const String& key);
+
+	/** Stores the data for the given key. Data that is not used by any other object anymore will be removed from the pool. */
+	void addSharedData(const String& key, ReferenceCountedObject* newData);
+
 private:
 
+	struct SharedData
+	{
+		String key;
+		ReferenceCountedObjectPtr<ReferenceCountedObject> data;
+	};
+
+	void removeUnusedSharedData();
+
+	CriticalSection sharedDataLock;
+	Array<SharedData> sharedData;
+
 	ScopedPointer<AudioThumbnailCache> cache;
 
 	void loadFromStream(BufferEntry& ne, InputStream* ownedStream);
@@ -198,7 +220,38 @@ class ImagePool: public SharedPoolBase
 {
 public:
 
-	typedef SharedPoolBase::PoolEntry<Image> ImageEntry;
+	/** The data of an entry is the ValueTree with the compressed image (or an invalid tree if the image is loaded from a file). */
+	typedef SharedPoolBase::PoolEntry<ValueTree> ImageEntry;
+
+	/** A reference to an image of the pool that is only decoded when it is needed.
+	*
+	*	It does not keep the decoded image alive, so the image can be released when no component uses it anymore.
+	*	The cache key is calculated once when the reference is set, so a file that changes afterwards is picked up
+	*	the next time the reference is set.
+	*/
+	class LazyImage
+	{
+	public:
+
+		/** Registers the file in the pool without decoding it. */
+		void setReference(ImagePool* pool_, const String& fileName_);
+
+		void clear();
+
+		/** Returns the decoded image. It will be decoded if it's not in the cache. */
+		Image get() const;
+
+		bool isEmpty() const noexcept { return fileName.isEmpty(); }
+
+		/** Returns the key of the decoded image. Two references with the same key point to the same image. */
+		int64 getHashCode() const noexcept { return hashCode; }
+
+	private:
+
+		ImagePool* pool = nullptr;
+		String fileName;
+		int64 hashCode = 0;
+	};
 
 	ImagePool(MainController* mc_);;
 
@@ -219,16 +272,63 @@ public:
 
 	StringArray getFileNameList() const;
 
+	/** Returns the decoded image for the given file and registers it in the pool if it's not there yet. */
 	Image loadFileIntoPool(const String& fileName);
 
+	/** Adds the file to the pool without decoding it and returns the key of the decoded image. */
+	int64 registerFile(const String& fileName);
+
+	/** Returns the decoded image for a file that was registered with the given key. */
+	Image getImage(const String& fileName, int64 hashCode);
+
 	static Image getEmptyImage(int width, int height);
 	static Image loadImageFromReference(MainController* mc, const String referenceToImage);
 
 protected:
 
-	
+	/** A process wide cache for the decoded images of all pools.
+	*
+	*	Multiple plugin instances that load the same image share the decoded bitmap. If the size of all decoded
+	*	images exceeds HISE_IMAGE_POOL_BUDGET_MB, the images that are not used anywhere else are released in
+	*	least recently used order.
+	*/
+	class DecodedImageCache
+	{
+	public:
+
+		Image get(int64 hashCode);
+
+		/** Adds the image and returns the image that is stored in the cache (which might be another one if two threads decoded it at the same time). */
+		Image add(int64 hashCode, const Image& image);
 
+	private:
+
+		struct Item
+		{
+			int64 hashCode;
+			Image image;
+			uint32 lastAccess;
+		};
+
+		void releaseUnusedImages();
+
+		CriticalSection lock;
+		Array<Item> items;
+		size_t decodedBytes = 0;
+		uint32 accessCounter = 0;
+	};
+
+	int getIndexForFileName(const String& fileName);
+	int64 getHashCode(const ImageEntry& e);
+	Image decodeImage(const ImageEntry& e, int64 hashCode);
+
+	CriticalSection lock;
 	Array<ImageEntry> loadedImages;
+
+	/** The MD5 hash of the compressed data of every embedded image. */
+	HashMap<String, int64> embeddedHashCodes;
+
+	SharedResourcePointer<DecodedImageCache> decodedImages;
 };
 
 } // namespace hise
@@ -110,7 +110,25 @@ void GlobalScriptCompileBroadcaster::fillExternalFileList(Array<File> &files, St
 
 void GlobalScriptCompileBroadcaster::setExternalScriptData(const ValueTree &collectedExternalScripts)
 {
+	static const Identifier precompiledTokenTree("PrecompiledTokens");
+	static const Identifier hash("Hash");
+	static const Identifier data("Data");
+
 	externalScripts = collectedExternalScripts;
+
+	ScopedLock sl(precompiledTokenLock);
+
+	precompiledTokens.clear();
+
+	const ValueTree tokens = externalScripts.getChildWithName(precompiledTokenTree);
+
+	for (int i = 0; i < tokens.getNumChildren(); i++)
+	{
+		const ValueTree child = tokens.getChild(i);
+
+		if (auto mb = child.getProperty(data).getBinaryData())
+			precompiledTokens.set((int64)child.getProperty(hash), *mb);
+	}
 }
 
 String GlobalScriptCompileBroadcaster::getExternalScriptFromCollection(const String &fileName)
@@ -140,6 +158,39 @@ String GlobalScriptCompileBroadcaster::getExternalScriptFromCollection(const Str
 	return String();
 }
 
+MemoryBlock GlobalScriptCompileBroadcaster::getPrecompiledTokens(int64 codeHash) const
+{
+	ScopedLock sl(precompiledTokenLock);
+
+	return precompiledTokens[codeHash];
+}
+
+bool GlobalScriptCompileBroadcaster::hasPrecompiledTokens(int64 codeHash) const
+{
+	ScopedLock sl(precompiledTokenLock);
+
+	return precompiledTokens.contains(codeHash);
+}
+
+bool GlobalScriptCompileBroadcaster::addPrecompiledTokens(int64 codeHash, const MemoryBlock& tokens)
+{
+	ScopedLock sl(precompiledTokenLock);
+
+	if (precompiledTokens.contains(codeHash))
+		return false;
+
+	precompiledTokens.set(codeHash, tokens);
+	return true;
+}
+
+void GlobalScriptCompileBroadcaster::removePrecompiledTokens(const Array<int64>& codeHashes)
+{
+	ScopedLock sl(precompiledTokenLock);
+
+	for (auto codeHash : codeHashes)
+		precompiledTokens.remove(codeHash);
+}
+
 ExternalScriptFile::Ptr GlobalScriptCompileBroadcaster::getExternalScriptFile(const File& fileToInclude)
 {
 	for (int i = 0; i < includedFiles.size(); i++)
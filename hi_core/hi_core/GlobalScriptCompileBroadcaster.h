@@ -168,6 +168,17 @@ public:
 
 	String getExternalScriptFromCollection(const String &fileName);
 
+	/** Returns the precompiled tokens of the code with the given hash code if they were exported with the external scripts (or an empty block). */
+	MemoryBlock getPrecompiledTokens(int64 codeHash) const;
+
+	bool hasPrecompiledTokens(int64 codeHash) const;
+
+	/** Adds tokens that were created at runtime. Returns false if there are already tokens for the code with this hash code. */
+	bool addPrecompiledTokens(int64 codeHash, const MemoryBlock& tokens);
+
+	/** Removes tokens that were added with addPrecompiledTokens(). */
+	void removePrecompiledTokens(const Array<int64>& codeHashes);
+
 	int getNumExternalScriptFiles() const { return includedFiles.size(); }
 
 	ExternalScriptFile::Ptr getExternalScriptFile(const File& fileToInclude);
@@ -207,6 +218,9 @@ private:
 
 	ValueTree externalScripts;
 
+	CriticalSection precompiledTokenLock;
+	HashMap<int64, MemoryBlock> precompiledTokens;
+
     
     DynamicObject::Ptr dummyLibraryLoader; // prevents the SharedResourcePointer from deleting the handler
     
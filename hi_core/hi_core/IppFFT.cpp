@@ -33,6 +33,26 @@
 namespace hise { using namespace juce;
 
 
+int IppFFT::getPowerOfTwo(int size) const
+{
+	if (!isPowerOfTwo(size)) return -1;
+
+	const int N = (int)(log(size) / log(2));
+
+	if (isPositiveAndBelow(N, maxOrder))
+	{
+		return N;
+	}
+	else
+	{
+		jassertfalse;
+	}
+
+	return -1;
+}
+
+#if USE_IPP
+
 IppFFT::IppFFT(DataType typeToUse, int maxPowerOfTwo /*= IPP_FFT_MAX_POWER_OF_TWO*/, const int flagToUse /*= IPP_FFT_NODIV_BY_ANY*/) :
 type(typeToUse),
 maxOrder(jmin<int>(maxPowerOfTwo, IPP_FFT_MAX_POWER_OF_TWO)),
@@ -239,25 +259,6 @@ void IppFFT::complexFFTInverse(const float* in, float *out, int size) const
 	}
 }
 
-int IppFFT::getPowerOfTwo(int size) const
-{
-	if (!isPowerOfTwo(size)) return -1;
-
-	const int N = (int)(log(size) / log(2));
-
-	if (isPositiveAndBelow(N, maxOrder))
-	{
-		return N;
-	}
-	else
-	{
-		jassertfalse;
-	}
-
-	return -1;
-}
-
-
 void IppFFT::initFFT(int N)
 {
 	int sizeSpec = 0;
@@ -356,4 +357,183 @@ void IppFFT::Buffer::releaseData()
 	}
 }
 
+#else
+
+IppFFT::IppFFT(DataType typeToUse, int maxPowerOfTwo /*= IPP_FFT_MAX_POWER_OF_TWO*/, const int flagToUse /*= IPP_FFT_NODIV_BY_ANY*/) :
+type(typeToUse),
+maxOrder(jmin<int>(maxPowerOfTwo, IPP_FFT_MAX_POWER_OF_TWO)),
+flag(flagToUse)
+{
+	// The portable implementation only supports the unnormalized transforms
+	jassert(flag == 8);
+
+	const bool useDouble = type == DataType::ComplexDouble || type == DataType::RealDouble;
+
+	// getPowerOfTwo() only accepts orders below maxOrder
+	portableFFT = new PortableFFT(jmax<int>(1, maxOrder - 1), useDouble);
+}
+
+IppFFT::~IppFFT()
+{
+	portableFFT = nullptr;
+}
+
+void IppFFT::realFFTInplace(float *data, int size) const
+{
+	jassert(type == DataType::RealFloat);
+
+	const int N = getPowerOfTwo(size);
+
+	if (N > 0)
+	{
+		portableFFT->realFFTInplace(data, N);
+	}
+}
+
+void IppFFT::realFFTInplace(double *data, int size) const
+{
+	jassert(type == DataType::RealDouble);
+
+	const int N = getPowerOfTwo(size);
+
+	if (N > 0)
+	{
+		portableFFT->realFFTInplace(data, N);
+	}
+}
+
+void IppFFT::realFFTInverseInplace(float *data, int size) const
+{
+	jassert(type == DataType::RealFloat);
+
+	const int N = getPowerOfTwo(size);
+
+	if (N > 0)
+	{
+		portableFFT->realFFTInverseInplace(data, N);
+	}
+}
+
+void IppFFT::realFFTInverseInplace(double *data, int size) const
+{
+	jassert(type == DataType::RealDouble);
+
+	const int N = getPowerOfTwo(size);
+
+	if (N > 0)
+	{
+		portableFFT->realFFTInverseInplace(data, N);
+	}
+}
+
+void IppFFT::complexFFTInplace(float *data, int size) const
+{
+	jassert(type == DataType::ComplexFloat);
+
+	const int N = getPowerOfTwo(size);
+
+	if (N > 0)
+	{
+		portableFFT->complexFFTInplace(data, N, false);
+	}
+}
+
+void IppFFT::complexFFTInplace(double *data, int size) const
+{
+	jassert(type == DataType::ComplexDouble);
+
+	const int N = getPowerOfTwo(size);
+
+	if (N > 0)
+	{
+		portableFFT->complexFFTInplace(data, N, false);
+	}
+}
+
+void IppFFT::complexFFTInverseInplace(float *data, int size) const
+{
+	jassert(type == DataType::ComplexFloat);
+
+	const int N = getPowerOfTwo(size);
+
+	if (N > 0)
+	{
+		portableFFT->complexFFTInplace(data, N, true);
+	}
+}
+
+void IppFFT::complexFFTInverseInplace(double *data, int size) const
+{
+	jassert(type == DataType::ComplexDouble);
+
+	const int N = getPowerOfTwo(size);
+
+	if (N > 0)
+	{
+		portableFFT->complexFFTInplace(data, N, true);
+	}
+}
+
+void IppFFT::realFFT(const float *in, float* out, int size) const
+{
+	jassert(type == DataType::RealFloat);
+
+	const int N = getPowerOfTwo(size);
+
+	if (N > 0)
+	{
+		// CCS format: re[0], 0, re[1], im[1], ..., re[size/2], 0 (needs size + 2 elements)
+
+		FloatVectorOperations::copy(out, in, size);
+		portableFFT->realFFTInplace(out, N);
+
+		out[size] = out[1];
+		out[size + 1] = 0.0f;
+		out[1] = 0.0f;
+	}
+}
+
+void IppFFT::realFFTInverse(const float *in, float* out, int size) const
+{
+	jassert(type == DataType::RealFloat);
+
+	const int N = getPowerOfTwo(size);
+
+	if (N > 0)
+	{
+		FloatVectorOperations::copy(out, in, size);
+		out[1] = in[size];
+
+		portableFFT->realFFTInverseInplace(out, N);
+	}
+}
+
+void IppFFT::complexFFT(const float *in, float* out, int size) const
+{
+	jassert(type == DataType::ComplexFloat);
+
+	const int N = getPowerOfTwo(size);
+
+	if (N > 0)
+	{
+		FloatVectorOperations::copy(out, in, size * 2);
+		portableFFT->complexFFTInplace(out, N, false);
+	}
+}
+
+void IppFFT::complexFFTInverse(const float* in, float *out, int size) const
+{
+	jassert(type == DataType::ComplexFloat);
+
+	const int N = getPowerOfTwo(size);
+
+	if (N > 0)
+	{
+		FloatVectorOperations::copy(out, in, size * 2);
+		portableFFT->complexFFTInplace(out, N, true);
+	}
+}
+
+#endif
+
 } // namespace hise
\ No newline at end of file
@@ -46,6 +46,9 @@ namespace hise { using namespace juce;
 *	fft.realFFT(data, 512);
 *
 *	It is not templated for speed, but it throws assertions if you call it on the wrong type.
+*
+*	If USE_IPP is disabled, the same interface is implemented with the PortableFFT class, which produces the same data
+*	layout and scaling, so you can use this class on every platform.
 */
 class IppFFT
 {
@@ -119,15 +122,29 @@ public:
 	/** Complex inverse inplace FFT (input is aligned Complex<double> array, size is power of two.) */
 	void complexFFTInverseInplace(double *data, int size) const;
 
+#if USE_IPP
+
+	/** The portable implementation has no additional work buffer. */
 	float *getAdditionalWorkBuffer()
 	{
 		return (float*)additionalWorkingBuffer->getData();
 	}
 
+#endif
+
 private:
 
 	// =============================================================================================================================
 
+	/** @internal */
+	int getPowerOfTwo(int size) const;
+
+	const DataType type;
+	const int maxOrder;
+	const int flag;
+
+#if USE_IPP
+
 	class Buffer
 	{
 	public:
@@ -152,8 +169,6 @@ private:
 
 	// =============================================================================================================================
 
-	/** @internal */
-	int getPowerOfTwo(int size) const;
 	/** @internal */
 	void initSpec(int N, Ipp8u *specData, Ipp8u *initData);
 	/** @internal */
@@ -161,10 +176,6 @@ private:
 	/** @internal */
 	void getSizes(int FFTOrder, int &sizeSpec, int &sizeInit, int &sizeBuffer);
 
-	const DataType type;
-	const int maxOrder;
-	const int flag;
-
 	IppsFFTSpec_C_32fc *complexFloatSpecs[IPP_FFT_MAX_POWER_OF_TWO];
 	IppsFFTSpec_C_64fc *complexDoubleSpecs[IPP_FFT_MAX_POWER_OF_TWO];
 	IppsFFTSpec_R_32f *realFloatSpecs[IPP_FFT_MAX_POWER_OF_TWO];
@@ -175,6 +186,12 @@ private:
 
 	ScopedPointer<Buffer> additionalWorkingBuffer;
 
+#else
+
+	ScopedPointer<PortableFFT> portableFFT;
+
+#endif
+
 	// =============================================================================================================================
 
 	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(IppFFT)
@@ -205,6 +205,8 @@ void MainController::loadPresetFromValueTree(const ValueTree &v, Component* /*ma
 
 void MainController::loadPresetInternal(const ValueTree& v)
 {
+	TRACE_STARTUP_ZONE_WITH_DETAIL("loadPresetInternal", v.getProperty("ID", String()).toString());
+
 	try
 	{
 		ModulatorSynthChain *synthChain = getMainSynthChain();
@@ -229,7 +231,10 @@ void MainController::loadPresetInternal(const ValueTree& v)
 
 		skipCompilingAtPresetLoad = true;
 
-		synthChain->restoreFromValueTree(v);
+		{
+			TRACE_STARTUP_ZONE("restoreFromValueTree");
+			synthChain->restoreFromValueTree(v);
+		}
 
 		skipCompilingAtPresetLoad = false;
 
@@ -288,21 +293,26 @@ void MainController::startCpuBenchmark(int bufferSize_)
 
 void MainController::compileAllScripts()
 {
+	TRACE_STARTUP_ZONE("MainController::compileAllScripts");
+
 	Processor::Iterator<JavascriptProcessor> it(getMainSynthChain());
 
 	JavascriptProcessor *sp;
+
+	Array<JavascriptProcessor*> processors;
 		
 	while((sp = it.getNextProcessor()) != nullptr)
 	{
 		if (sp->isConnectedToExternalFile())
 		{
-			sp->reloadFromFile();
-		}
-		else
-		{
-			sp->compileScript();
+			const String fileReference = sp->getConnectedFileReference();
+			sp->setConnectedFile(fileReference, false);
 		}
+
+		processors.add(sp);
 	}
+
+	JavascriptProcessor::compileAll(processors);
 };
 
 void MainController::allNotesOff(bool resetSoftBypassState/*=false*/)
@@ -971,6 +981,8 @@ ValueTree MainController::exportCustomFontsAsValueTree() const
 
 void MainController::restoreCustomFontValueTree(const ValueTree &v)
 {
+	TRACE_STARTUP_ZONE("Load fonts");
+
 	customTypeFaceData = v;
 
 	for (int i = 0; i < customTypeFaceData.getNumChildren(); i++)
@@ -1110,6 +1122,7 @@ void MainController::SampleManager::setShouldSkipPreloading(bool skip)
 
 void MainController::SampleManager::preloadEverything()
 {
+	TRACE_STARTUP_ZONE("preloadEverything");
 	
 	jassert(skipPreloading);
 
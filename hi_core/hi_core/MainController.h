@@ -335,7 +335,7 @@ public:
 		JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(EventIdHandler)
 	};
 
-	class UserPresetHandler
+	class UserPresetHandler: private AsyncUpdater
 	{
 	public:
 
@@ -353,12 +353,19 @@ public:
 			WeakReference<Listener>::Master masterReference;
 		};
 
-		UserPresetHandler(MainController* mc_) :
-			mc(mc_)
-		{};
+		UserPresetHandler(MainController* mc_);
+
+		~UserPresetHandler();
 
 		void incPreset(bool next, bool stayInSameDirectory);
+
+		/** Kills all voices and restores the preset on the sample loading thread. 
+		*
+		*	If another preset is requested before the voices are killed, this preset will be skipped.
+		*/
 		void loadUserPreset(const ValueTree& v);
+
+		/** Parses the preset file on a background thread and loads it if no other preset was requested in the meantime. */
 		void loadUserPreset(const File& f);
 
 		File getCurrentlyLoadedFile() const;;
@@ -372,11 +379,24 @@ public:
 
 	private:
 
+		class LoadingThread;
+
+		void handleAsyncUpdate() override;
+
+		bool isLatestLoadRequest(int requestId) const noexcept { return requestId == latestLoadRequest.load(); }
+
+		/** Restores the preset after the voices are killed and sets the given file as current preset afterwards (unless it's empty). */
+		void restoreUserPreset(const ValueTree& v, const File& presetFile, int requestId);
+
 		void loadUserPresetInternal(const ValueTree& v);
 		void saveUserPresetInternal(const String& name=String());
 
 		Array<WeakReference<Listener>> listeners;
 
+		std::atomic<int> latestLoadRequest;
+
+		ScopedPointer<LoadingThread> loadingThread;
+
 		File currentlyLoadedFile;
 
 		MainController* mc;
@@ -780,6 +800,12 @@ public:
 
 	DebugLogger& getDebugLogger() { return debugLogger; }
 	const DebugLogger& getDebugLogger() const { return debugLogger; }
+
+	/** Returns the ring that transports display values from the audio thread to the interface. 
+	*
+	*	The ring is returned as non-const reference so that const methods (eg. Modulator::addValueToPlotter()) can push values.
+	*/
+	TelemetryRing& getTelemetryRing() const noexcept { return telemetryRing; }
     
 	void setKeyboardCoulour(int keyNumber, Colour colour);
 
@@ -1199,6 +1225,8 @@ private:
 
 	DebugLogger debugLogger;
 
+	mutable TelemetryRing telemetryRing;
+
 #if USE_BACKEND
     
 	
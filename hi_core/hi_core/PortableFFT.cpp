@@ -0,0 +1,543 @@
+/*  ===========================================================================
+*
+*   This file is part of HISE.
+*   Copyright 2016 Christoph Hart
+*
+*   HISE is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   HISE is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with HISE.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Commercial licenses for using HISE in an closed source project are
+*   available on request. Please visit the project's website to get more
+*   information about commercial licensing:
+*
+*   http://www.hise.audio/
+*
+*   HISE is based on the JUCE library,
+*   which must be separately licensed for closed source applications:
+*
+*   http://www.juce.com
+*
+*   ===========================================================================
+*/
+
+#if JUCE_USE_SSE_INTRINSICS
+#include <emmintrin.h>
+#endif
+
+namespace hise { using namespace juce;
+
+template <typename FloatType> struct PortableFFT::Engine
+{
+	/** Performs a complex FFT of 2^order points. The result will be written back to data. */
+	static void perform(FloatType* data, FloatType* scratch, const FloatType* twiddles, int tableOrder, int order, bool inverse)
+	{
+		const int numPoints = 1 << order;
+
+		FloatType* src = data;
+		FloatType* dst = scratch;
+
+		int stride = 1;
+		int length = numPoints;
+
+		while (length >= 4)
+		{
+			radix4(src, dst, twiddles, (1 << tableOrder) / length, length / 4, stride, inverse);
+
+			std::swap(src, dst);
+			stride *= 4;
+			length /= 4;
+		}
+
+		if (length == 2)
+		{
+			radix2(src, dst, stride);
+			std::swap(src, dst);
+		}
+
+		if (src != data)
+			memcpy(data, src, sizeof(FloatType) * 2 * (size_t)numPoints);
+	}
+
+	/** Converts the half-size complex FFT of the even / odd samples to the spectrum of the real signal (Perm format). */
+	static void realPostProcess(FloatType* d, const FloatType* twiddles, int tableOrder, int order)
+	{
+		const int M = 1 << (order - 1);
+		const int twStride = 1 << (tableOrder - order);
+
+		const FloatType z0r = d[0];
+		const FloatType z0i = d[1];
+
+		d[0] = z0r + z0i;
+		d[1] = z0r - z0i;
+
+		const FloatType half = FloatType(0.5);
+
+		for (int k = 1; k <= M / 2; k++)
+		{
+			FloatType* zk = d + 2 * k;
+			FloatType* zc = d + 2 * (M - k);
+
+			const FloatType wr = twiddles[2 * k * twStride];
+			const FloatType wi = twiddles[2 * k * twStride + 1];
+
+			const FloatType fer = half * (zk[0] + zc[0]);
+			const FloatType fei = half * (zk[1] - zc[1]);
+
+			// fo = -i * (Z[k] - conj(Z[M-k])) / 2
+			const FloatType for_ = half * (zk[1] + zc[1]);
+			const FloatType foi = -half * (zk[0] - zc[0]);
+
+			const FloatType tr = wr * for_ - wi * foi;
+			const FloatType ti = wr * foi + wi * for_;
+
+			zk[0] = fer + tr;
+			zk[1] = fei + ti;
+
+			zc[0] = fer - tr;
+			zc[1] = -(fei - ti);
+		}
+	}
+
+	/** Converts a spectrum in Perm format to a half-size complex spectrum that can be transformed back with the complex FFT. */
+	static void realPreProcess(FloatType* d, const FloatType* twiddles, int tableOrder, int order)
+	{
+		const int M = 1 << (order - 1);
+		const int twStride = 1 << (tableOrder - order);
+
+		const FloatType x0 = d[0];
+		const FloatType xm = d[1];
+
+		d[0] = x0 + xm;
+		d[1] = x0 - xm;
+
+		for (int k = 1; k <= M / 2; k++)
+		{
+			FloatType* xk = d + 2 * k;
+			FloatType* xc = d + 2 * (M - k);
+
+			const FloatType wr = twiddles[2 * k * twStride];
+			const FloatType wi = -twiddles[2 * k * twStride + 1];
+
+			const FloatType fer = xk[0] + xc[0];
+			const FloatType fei = xk[1] - xc[1];
+
+			const FloatType dr = xk[0] - xc[0];
+			const FloatType di = xk[1] + xc[1];
+
+			const FloatType for_ = dr * wr - di * wi;
+			const FloatType foi = dr * wi + di * wr;
+
+			// Z[k] = fe + i * fo, Z[M-k] = conj(fe - i * fo)
+			xk[0] = fer - foi;
+			xk[1] = fei + for_;
+
+			xc[0] = fer + foi;
+			xc[1] = -(fei - for_);
+		}
+	}
+
+	static void radix4(const FloatType* x, FloatType* y, const FloatType* twiddles, int twStride, int m, int s, bool inverse);
+
+	static void radix2(const FloatType* x, FloatType* y, int s);
+
+	/** The scalar radix-4 pass for the points [pStart, m). */
+	static void radix4Scalar(const FloatType* x, FloatType* y, const FloatType* twiddles, int twStride, int pStart, int m, int s, bool inverse)
+	{
+		const FloatType sign = inverse ? FloatType(-1) : FloatType(1);
+
+		for (int p = pStart; p < m; p++)
+		{
+			const FloatType w1r = twiddles[2 * p * twStride];
+			const FloatType w1i = sign * twiddles[2 * p * twStride + 1];
+			const FloatType w2r = twiddles[4 * p * twStride];
+			const FloatType w2i = sign * twiddles[4 * p * twStride + 1];
+			const FloatType w3r = twiddles[6 * p * twStride];
+			const FloatType w3i = sign * twiddles[6 * p * twStride + 1];
+
+			for (int q = 0; q < s; q++)
+			{
+				const FloatType* a = x + 2 * (q + s * p);
+				const FloatType* b = x + 2 * (q + s * (p + m));
+				const FloatType* c = x + 2 * (q + s * (p + 2 * m));
+				const FloatType* d = x + 2 * (q + s * (p + 3 * m));
+
+				const FloatType apcR = a[0] + c[0], apcI = a[1] + c[1];
+				const FloatType amcR = a[0] - c[0], amcI = a[1] - c[1];
+				const FloatType bpdR = b[0] + d[0], bpdI = b[1] + d[1];
+				const FloatType bmdR = b[0] - d[0], bmdI = b[1] - d[1];
+
+				FloatType* y0 = y + 2 * (q + s * (4 * p));
+				FloatType* y1 = y0 + 2 * s;
+				FloatType* y2 = y1 + 2 * s;
+				FloatType* y3 = y2 + 2 * s;
+
+				y0[0] = apcR + bpdR;
+				y0[1] = apcI + bpdI;
+
+				const FloatType t1r = amcR + sign * bmdI;
+				const FloatType t1i = amcI - sign * bmdR;
+				y1[0] = w1r * t1r - w1i * t1i;
+				y1[1] = w1r * t1i + w1i * t1r;
+
+				const FloatType t2r = apcR - bpdR;
+				const FloatType t2i = apcI - bpdI;
+				y2[0] = w2r * t2r - w2i * t2i;
+				y2[1] = w2r * t2i + w2i * t2r;
+
+				const FloatType t3r = amcR - sign * bmdI;
+				const FloatType t3i = amcI + sign * bmdR;
+				y3[0] = w3r * t3r - w3i * t3i;
+				y3[1] = w3r * t3i + w3i * t3r;
+			}
+		}
+	}
+
+	static void radix2Scalar(const FloatType* x, FloatType* y, int qStart, int s)
+	{
+		for (int q = qStart; q < s; q++)
+		{
+			const FloatType* a = x + 2 * q;
+			const FloatType* b = x + 2 * (q + s);
+
+			y[2 * q] = a[0] + b[0];
+			y[2 * q + 1] = a[1] + b[1];
+			y[2 * (q + s)] = a[0] - b[0];
+			y[2 * (q + s) + 1] = a[1] - b[1];
+		}
+	}
+};
+
+#if JUCE_USE_SSE_INTRINSICS
+
+namespace PortableFFTHelpers
+{
+
+/** Multiplies two complex floats per register. */
+static forcedinline __m128 mulComplex(__m128 a, __m128 b)
+{
+	const __m128 br = _mm_shuffle_ps(b, b, _MM_SHUFFLE(2, 2, 0, 0));
+	const __m128 bi = _mm_shuffle_ps(b, b, _MM_SHUFFLE(3, 3, 1, 1));
+	const __m128 as = _mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 3, 0, 1));
+
+	return _mm_add_ps(_mm_mul_ps(a, br), _mm_mul_ps(_mm_mul_ps(as, bi), _mm_setr_ps(-1.0f, 1.0f, -1.0f, 1.0f)));
+}
+
+/** Swaps the real and imaginary part of both complex floats. */
+static forcedinline __m128 swapComplex(__m128 a)
+{
+	return _mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 3, 0, 1));
+}
+
+static forcedinline __m128d mulComplex(__m128d a, __m128d b)
+{
+	const __m128d br = _mm_unpacklo_pd(b, b);
+	const __m128d bi = _mm_unpackhi_pd(b, b);
+	const __m128d as = _mm_shuffle_pd(a, a, 1);
+
+	return _mm_add_pd(_mm_mul_pd(a, br), _mm_mul_pd(_mm_mul_pd(as, bi), _mm_setr_pd(-1.0, 1.0)));
+}
+
+static forcedinline __m128d swapComplex(__m128d a)
+{
+	return _mm_shuffle_pd(a, a, 1);
+}
+
+}
+
+template <> void PortableFFT::Engine<float>::radix4(const float* x, float* y, const float* twiddles, int twStride, int m, int s, bool inverse)
+{
+	using namespace PortableFFTHelpers;
+
+	const float sign = inverse ? -1.0f : 1.0f;
+	const __m128 jSign = _mm_setr_ps(sign, -sign, sign, -sign);
+
+	if (s == 1)
+	{
+		// First pass: the input points are contiguous in p, so two adjacent p values share a register
+		// (with different twiddle factors) and the outputs are written as 64bit halfs.
+
+		if (m < 2)
+		{
+			radix4Scalar(x, y, twiddles, twStride, 0, m, s, inverse);
+			return;
+		}
+
+		const __m128 twSign = _mm_setr_ps(1.0f, sign, 1.0f, sign);
+
+		for (int p = 0; p < m; p += 2)
+		{
+			__m128 w1 = _mm_loadl_pi(_mm_setzero_ps(), (const __m64*)(twiddles + 2 * p * twStride));
+			w1 = _mm_loadh_pi(w1, (const __m64*)(twiddles + 2 * (p + 1) * twStride));
+			__m128 w2 = _mm_loadl_pi(_mm_setzero_ps(), (const __m64*)(twiddles + 4 * p * twStride));
+			w2 = _mm_loadh_pi(w2, (const __m64*)(twiddles + 4 * (p + 1) * twStride));
+			__m128 w3 = _mm_loadl_pi(_mm_setzero_ps(), (const __m64*)(twiddles + 6 * p * twStride));
+			w3 = _mm_loadh_pi(w3, (const __m64*)(twiddles + 6 * (p + 1) * twStride));
+
+			w1 = _mm_mul_ps(w1, twSign);
+			w2 = _mm_mul_ps(w2, twSign);
+			w3 = _mm_mul_ps(w3, twSign);
+
+			const __m128 a = _mm_loadu_ps(x + 2 * p);
+			const __m128 b = _mm_loadu_ps(x + 2 * (p + m));
+			const __m128 c = _mm_loadu_ps(x + 2 * (p + 2 * m));
+			const __m128 d = _mm_loadu_ps(x + 2 * (p + 3 * m));
+
+			const __m128 apc = _mm_add_ps(a, c);
+			const __m128 amc = _mm_sub_ps(a, c);
+			const __m128 bpd = _mm_add_ps(b, d);
+			const __m128 jbmd = _mm_mul_ps(swapComplex(_mm_sub_ps(b, d)), jSign);
+
+			const __m128 y0 = _mm_add_ps(apc, bpd);
+			const __m128 y1 = mulComplex(_mm_add_ps(amc, jbmd), w1);
+			const __m128 y2 = mulComplex(_mm_sub_ps(apc, bpd), w2);
+			const __m128 y3 = mulComplex(_mm_sub_ps(amc, jbmd), w3);
+
+			float* lo = y + 8 * p;
+			float* hi = lo + 8;
+
+			_mm_storel_pi((__m64*)lo, y0);
+			_mm_storel_pi((__m64*)(lo + 2), y1);
+			_mm_storel_pi((__m64*)(lo + 4), y2);
+			_mm_storel_pi((__m64*)(lo + 6), y3);
+			_mm_storeh_pi((__m64*)hi, y0);
+			_mm_storeh_pi((__m64*)(hi + 2), y1);
+			_mm_storeh_pi((__m64*)(hi + 4), y2);
+			_mm_storeh_pi((__m64*)(hi + 6), y3);
+		}
+
+		return;
+	}
+
+	// All other passes: s is a power of four, so the q loop processes two complex values per register with a constant twiddle.
+
+	for (int p = 0; p < m; p++)
+	{
+		const float* t1 = twiddles + 2 * p * twStride;
+		const float* t2 = twiddles + 4 * p * twStride;
+		const float* t3 = twiddles + 6 * p * twStride;
+
+		const __m128 w1 = _mm_setr_ps(t1[0], sign * t1[1], t1[0], sign * t1[1]);
+		const __m128 w2 = _mm_setr_ps(t2[0], sign * t2[1], t2[0], sign * t2[1]);
+		const __m128 w3 = _mm_setr_ps(t3[0], sign * t3[1], t3[0], sign * t3[1]);
+
+		const float* xa = x + 2 * s * p;
+		const float* xb = x + 2 * s * (p + m);
+		const float* xc = x + 2 * s * (p + 2 * m);
+		const float* xd = x + 2 * s * (p + 3 * m);
+
+		float* y0 = y + 2 * s * (4 * p);
+		float* y1 = y0 + 2 * s;
+		float* y2 = y1 + 2 * s;
+		float* y3 = y2 + 2 * s;
+
+		for (int q = 0; q < 2 * s; q += 4)
+		{
+			const __m128 a = _mm_loadu_ps(xa + q);
+			const __m128 b = _mm_loadu_ps(xb + q);
+			const __m128 c = _mm_loadu_ps(xc + q);
+			const __m128 d = _mm_loadu_ps(xd + q);
+
+			const __m128 apc = _mm_add_ps(a, c);
+			const __m128 amc = _mm_sub_ps(a, c);
+			const __m128 bpd = _mm_add_ps(b, d);
+			const __m128 jbmd = _mm_mul_ps(swapComplex(_mm_sub_ps(b, d)), jSign);
+
+			_mm_storeu_ps(y0 + q, _mm_add_ps(apc, bpd));
+			_mm_storeu_ps(y1 + q, mulComplex(_mm_add_ps(amc, jbmd), w1));
+			_mm_storeu_ps(y2 + q, mulComplex(_mm_sub_ps(apc, bpd), w2));
+			_mm_storeu_ps(y3 + q, mulComplex(_mm_sub_ps(amc, jbmd), w3));
+		}
+	}
+}
+
+template <> void PortableFFT::Engine<float>::radix2(const float* x, float* y, int s)
+{
+	if (s < 2)
+	{
+		radix2Scalar(x, y, 0, s);
+		return;
+	}
+
+	for (int q = 0; q < 2 * s; q += 4)
+	{
+		const __m128 a = _mm_loadu_ps(x + q);
+		const __m128 b = _mm_loadu_ps(x + 2 * s + q);
+
+		_mm_storeu_ps(y + q, _mm_add_ps(a, b));
+		_mm_storeu_ps(y + 2 * s + q, _mm_sub_ps(a, b));
+	}
+}
+
+template <> void PortableFFT::Engine<double>::radix4(const double* x, double* y, const double* twiddles, int twStride, int m, int s, bool inverse)
+{
+	using namespace PortableFFTHelpers;
+
+	const double sign = inverse ? -1.0 : 1.0;
+	const __m128d jSign = _mm_setr_pd(sign, -sign);
+	const __m128d twSign = _mm_setr_pd(1.0, sign);
+
+	for (int p = 0; p < m; p++)
+	{
+		const __m128d w1 = _mm_mul_pd(_mm_loadu_pd(twiddles + 2 * p * twStride), twSign);
+		const __m128d w2 = _mm_mul_pd(_mm_loadu_pd(twiddles + 4 * p * twStride), twSign);
+		const __m128d w3 = _mm_mul_pd(_mm_loadu_pd(twiddles + 6 * p * twStride), twSign);
+
+		const double* xa = x + 2 * s * p;
+		const double* xb = x + 2 * s * (p + m);
+		const double* xc = x + 2 * s * (p + 2 * m);
+		const double* xd = x + 2 * s * (p + 3 * m);
+
+		double* y0 = y + 2 * s * (4 * p);
+		double* y1 = y0 + 2 * s;
+		double* y2 = y1 + 2 * s;
+		double* y3 = y2 + 2 * s;
+
+		for (int q = 0; q < 2 * s; q += 2)
+		{
+			const __m128d a = _mm_loadu_pd(xa + q);
+			const __m128d b = _mm_loadu_pd(xb + q);
+			const __m128d c = _mm_loadu_pd(xc + q);
+			const __m128d d = _mm_loadu_pd(xd + q);
+
+			const __m128d apc = _mm_add_pd(a, c);
+			const __m128d amc = _mm_sub_pd(a, c);
+			const __m128d bpd = _mm_add_pd(b, d);
+			const __m128d jbmd = _mm_mul_pd(swapComplex(_mm_sub_pd(b, d)), jSign);
+
+			_mm_storeu_pd(y0 + q, _mm_add_pd(apc, bpd));
+			_mm_storeu_pd(y1 + q, mulComplex(_mm_add_pd(amc, jbmd), w1));
+			_mm_storeu_pd(y2 + q, mulComplex(_mm_sub_pd(apc, bpd), w2));
+			_mm_storeu_pd(y3 + q, mulComplex(_mm_sub_pd(amc, jbmd), w3));
+		}
+	}
+}
+
+template <> void PortableFFT::Engine<double>::radix2(const double* x, double* y, int s)
+{
+	for (int q = 0; q < 2 * s; q += 2)
+	{
+		const __m128d a = _mm_loadu_pd(x + q);
+		const __m128d b = _mm_loadu_pd(x + 2 * s + q);
+
+		_mm_storeu_pd(y + q, _mm_add_pd(a, b));
+		_mm_storeu_pd(y + 2 * s + q, _mm_sub_pd(a, b));
+	}
+}
+
+#else
+
+template <typename FloatType> void PortableFFT::Engine<FloatType>::radix4(const FloatType* x, FloatType* y, const FloatType* twiddles, int twStride, int m, int s, bool inverse)
+{
+	radix4Scalar(x, y, twiddles, twStride, 0, m, s, inverse);
+}
+
+template <typename FloatType> void PortableFFT::Engine<FloatType>::radix2(const FloatType* x, FloatType* y, int s)
+{
+	radix2Scalar(x, y, 0, s);
+}
+
+#endif
+
+PortableFFT::PortableFFT(int maxOrder_, bool useDoublePrecision) :
+	maxOrder(jlimit<int>(1, 30, maxOrder_)),
+	useDouble(useDoublePrecision)
+{
+	const int tableSize = 1 << maxOrder;
+
+	// The twiddle table contains exp(-2*pi*i*k/N) for the largest size. Smaller transforms step through it with a stride.
+
+	if (useDouble)
+	{
+		doubleTwiddles.calloc(2 * tableSize);
+		doubleScratch.calloc(2 * tableSize);
+
+		for (int k = 0; k < tableSize; k++)
+		{
+			const double phase = -2.0 * double_Pi * (double)k / (double)tableSize;
+
+			doubleTwiddles[2 * k] = std::cos(phase);
+			doubleTwiddles[2 * k + 1] = std::sin(phase);
+		}
+	}
+	else
+	{
+		floatTwiddles.calloc(2 * tableSize);
+		floatScratch.calloc(2 * tableSize);
+
+		for (int k = 0; k < tableSize; k++)
+		{
+			const double phase = -2.0 * double_Pi * (double)k / (double)tableSize;
+
+			floatTwiddles[2 * k] = (float)std::cos(phase);
+			floatTwiddles[2 * k + 1] = (float)std::sin(phase);
+		}
+	}
+}
+
+PortableFFT::~PortableFFT()
+{
+}
+
+void PortableFFT::complexFFTInplace(float* data, int order, bool inverse) const
+{
+	jassert(!useDouble);
+	jassert(isPositiveAndNotGreaterThan(order, maxOrder));
+
+	Engine<float>::perform(data, floatScratch.getData(), floatTwiddles.getData(), maxOrder, order, inverse);
+}
+
+void PortableFFT::complexFFTInplace(double* data, int order, bool inverse) const
+{
+	jassert(useDouble);
+	jassert(isPositiveAndNotGreaterThan(order, maxOrder));
+
+	Engine<double>::perform(data, doubleScratch.getData(), doubleTwiddles.getData(), maxOrder, order, inverse);
+}
+
+void PortableFFT::realFFTInplace(float* data, int order) const
+{
+	jassert(!useDouble);
+	jassert(order > 0 && order <= maxOrder);
+
+	Engine<float>::perform(data, floatScratch.getData(), floatTwiddles.getData(), maxOrder, order - 1, false);
+	Engine<float>::realPostProcess(data, floatTwiddles.getData(), maxOrder, order);
+}
+
+void PortableFFT::realFFTInplace(double* data, int order) const
+{
+	jassert(useDouble);
+	jassert(order > 0 && order <= maxOrder);
+
+	Engine<double>::perform(data, doubleScratch.getData(), doubleTwiddles.getData(), maxOrder, order - 1, false);
+	Engine<double>::realPostProcess(data, doubleTwiddles.getData(), maxOrder, order);
+}
+
+void PortableFFT::realFFTInverseInplace(float* data, int order) const
+{
+	jassert(!useDouble);
+	jassert(order > 0 && order <= maxOrder);
+
+	Engine<float>::realPreProcess(data, floatTwiddles.getData(), maxOrder, order);
+	Engine<float>::perform(data, floatScratch.getData(), floatTwiddles.getData(), maxOrder, order - 1, true);
+}
+
+void PortableFFT::realFFTInverseInplace(double* data, int order) const
+{
+	jassert(useDouble);
+	jassert(order > 0 && order <= maxOrder);
+
+	Engine<double>::realPreProcess(data, doubleTwiddles.getData(), maxOrder, order);
+	Engine<double>::perform(data, doubleScratch.getData(), doubleTwiddles.getData(), maxOrder, order - 1, true);
+}
+
+} // namespace hise
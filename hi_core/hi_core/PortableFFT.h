@@ -0,0 +1,101 @@
+/*  ===========================================================================
+*
+*   This file is part of HISE.
+*   Copyright 2016 Christoph Hart
+*
+*   HISE is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   HISE is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with HISE.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Commercial licenses for using HISE in an closed source project are
+*   available on request. Please visit the project's website to get more
+*   information about commercial licensing:
+*
+*   http://www.hise.audio/
+*
+*   HISE is based on the JUCE library,
+*   which must be separately licensed for closed source applications:
+*
+*   http://www.juce.com
+*
+*   ===========================================================================
+*/
+
+#ifndef PORTABLEFFT_H_INCLUDED
+#define PORTABLEFFT_H_INCLUDED
+
+namespace hise { using namespace juce;
+
+/** A self-contained FFT implementation that is used as backend for the IppFFT class if IPP is not available.
+*
+*	It uses a radix-4 Stockham autosort algorithm (with a final radix-2 pass for odd orders), so there is no bit 
+*	reversal step and the inner loops run over contiguous memory with a constant twiddle factor. On Intel platforms 
+*	the passes are vectorized with SSE2 (two complex floats or one complex double per register).
+*
+*	The data layout and scaling matches the IPP routines that are used with the IPP_FFT_NODIV_BY_ANY flag:
+*
+*	- complex data is interleaved: re[0], im[0], re[1], im[1], ...
+*	- real transforms use the packed Perm format: re[0], re[size/2], re[1], im[1], ..., re[size/2-1], im[size/2-1]
+*	- neither the forward nor the inverse transform is normalized.
+*
+*	All methods use an internal scratch buffer, so you must not call the same instance from multiple threads.
+*/
+class PortableFFT
+{
+public:
+
+	/** Creates the twiddle tables and the scratch buffer for transforms up to 2^maxOrder points. */
+	PortableFFT(int maxOrder, bool useDoublePrecision);
+
+	~PortableFFT();
+
+	/** Returns the highest order that this object was initialised with. */
+	int getMaxOrder() const noexcept { return maxOrder; }
+
+	/** Complex inplace FFT of 2^order interleaved complex values. */
+	void complexFFTInplace(float* data, int order, bool inverse) const;
+
+	/** Complex inplace FFT of 2^order interleaved complex values. */
+	void complexFFTInplace(double* data, int order, bool inverse) const;
+
+	/** Real inplace FFT of 2^order values. The output has the Perm format. */
+	void realFFTInplace(float* data, int order) const;
+
+	/** Real inplace FFT of 2^order values. The output has the Perm format. */
+	void realFFTInplace(double* data, int order) const;
+
+	/** Real inplace inverse FFT. The input must have the Perm format. */
+	void realFFTInverseInplace(float* data, int order) const;
+
+	/** Real inplace inverse FFT. The input must have the Perm format. */
+	void realFFTInverseInplace(double* data, int order) const;
+
+private:
+
+	/** @internal */
+	template <typename FloatType> struct Engine;
+
+	const int maxOrder;
+	const bool useDouble;
+
+	HeapBlock<float> floatTwiddles;
+	HeapBlock<double> doubleTwiddles;
+
+	HeapBlock<float> floatScratch;
+	HeapBlock<double> doubleScratch;
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(PortableFFT)
+};
+
+} // namespace hise
+
+#endif  // PORTABLEFFT_H_INCLUDED
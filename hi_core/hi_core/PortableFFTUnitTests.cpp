@@ -0,0 +1,363 @@
+/*  ===========================================================================
+*
+*   This file is part of HISE.
+*   Copyright 2016 Christoph Hart
+*
+*   HISE is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   HISE is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with HISE.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Commercial licenses for using HISE in an closed source project are
+*   available on request. Please visit the project's website to get more
+*   information about commercial licensing:
+*
+*   http://www.hise.audio/
+*
+*   HISE is based on the JUCE library,
+*   which must be separately licensed for closed source applications:
+*
+*   http://www.juce.com
+*
+*   ===========================================================================
+*/
+
+
+#include "AppConfig.h"
+
+#if HI_RUN_UNIT_TESTS
+
+#include  "JuceHeader.h"
+
+using namespace hise;
+
+class PortableFFTUnitTests : public UnitTest
+{
+public:
+
+	PortableFFTUnitTests() :
+		UnitTest("Testing FFT routines")
+	{
+
+	}
+
+	void runTest() override
+	{
+		testComplexFloat();
+		testComplexDouble();
+		testRealFloat();
+		testRealDouble();
+		testCCSFormat();
+
+#if USE_IPP
+		testAgainstIpp();
+#endif
+
+		testThroughput();
+	}
+
+private:
+
+	typedef std::complex<double> Complex;
+
+	/** The slow reference DFT. */
+	static Array<Complex> dft(const Array<Complex>& input, bool inverse)
+	{
+		const int N = input.size();
+		const double sign = inverse ? 1.0 : -1.0;
+
+		Array<Complex> output;
+
+		for (int k = 0; k < N; k++)
+		{
+			Complex sum = 0.0;
+
+			for (int n = 0; n < N; n++)
+			{
+				const int index = (int)(((int64)k * (int64)n) % N);
+				sum += input[n] * std::polar(1.0, sign * 2.0 * double_Pi * (double)index / (double)N);
+			}
+
+			output.add(sum);
+		}
+
+		return output;
+	}
+
+	template <typename FloatType> void fillRandom(HeapBlock<FloatType>& data, int numValues)
+	{
+		Random r = getRandom();
+
+		data.calloc(numValues);
+
+		for (int i = 0; i < numValues; i++)
+			data[i] = (FloatType)(r.nextDouble() * 2.0 - 1.0);
+	}
+
+	static double getMaxMagnitude(const Array<Complex>& data)
+	{
+		double maxValue = 0.0;
+
+		for (auto& c : data)
+			maxValue = jmax<double>(maxValue, std::abs(c));
+
+		return jmax<double>(maxValue, 1e-12);
+	}
+
+	template <typename FloatType> void testComplex(IppFFT::DataType type, double tolerance)
+	{
+		IppFFT fft(type);
+
+		for (int order = 1; order < 11; order++)
+		{
+			const int N = 1 << order;
+
+			HeapBlock<FloatType> data;
+			fillRandom(data, 2 * N);
+
+			Array<Complex> input;
+
+			for (int i = 0; i < N; i++)
+				input.add(Complex(data[2 * i], data[2 * i + 1]));
+
+			auto expected = dft(input, false);
+
+			fft.complexFFTInplace(data, N);
+
+			double error = 0.0;
+
+			for (int i = 0; i < N; i++)
+				error = jmax<double>(error, std::abs(expected[i] - Complex(data[2 * i], data[2 * i + 1])));
+
+			expect(error / getMaxMagnitude(expected) < tolerance, "Forward FFT error at size " + String(N) + ": " + String(error));
+
+			fft.complexFFTInverseInplace(data, N);
+
+			error = 0.0;
+
+			for (int i = 0; i < N; i++)
+				error = jmax<double>(error, std::abs(input[i] * (double)N - Complex(data[2 * i], data[2 * i + 1])));
+
+			expect(error / (double)N < tolerance, "Roundtrip error at size " + String(N) + ": " + String(error));
+		}
+	}
+
+	template <typename FloatType> void testReal(IppFFT::DataType type, double tolerance)
+	{
+		IppFFT fft(type);
+
+		for (int order = 1; order < 11; order++)
+		{
+			const int N = 1 << order;
+
+			HeapBlock<FloatType> data;
+			fillRandom(data, N);
+
+			Array<Complex> input;
+
+			for (int i = 0; i < N; i++)
+				input.add(Complex(data[i], 0.0));
+
+			auto expected = dft(input, false);
+
+			fft.realFFTInplace(data, N);
+
+			// Perm format: re[0], re[N/2], re[1], im[1], ...
+
+			double error = jmax<double>(std::abs(expected[0].real() - data[0]), std::abs(expected[N / 2].real() - data[1]));
+
+			for (int i = 1; i < N / 2; i++)
+				error = jmax<double>(error, std::abs(expected[i] - Complex(data[2 * i], data[2 * i + 1])));
+
+			expect(error / getMaxMagnitude(expected) < tolerance, "Forward real FFT error at size " + String(N) + ": " + String(error));
+
+			fft.realFFTInverseInplace(data, N);
+
+			error = 0.0;
+
+			for (int i = 0; i < N; i++)
+				error = jmax<double>(error, std::abs(input[i].real() * (double)N - data[i]));
+
+			expect(error / (double)N < tolerance, "Real roundtrip error at size " + String(N) + ": " + String(error));
+		}
+	}
+
+	void testComplexFloat()
+	{
+		beginTest("Testing complex float FFT");
+		testComplex<float>(IppFFT::DataType::ComplexFloat, 1e-5);
+	}
+
+	void testComplexDouble()
+	{
+		beginTest("Testing complex double FFT");
+		testComplex<double>(IppFFT::DataType::ComplexDouble, 1e-11);
+	}
+
+	void testRealFloat()
+	{
+		beginTest("Testing real float FFT");
+		testReal<float>(IppFFT::DataType::RealFloat, 1e-5);
+	}
+
+	void testRealDouble()
+	{
+		beginTest("Testing real double FFT");
+		testReal<double>(IppFFT::DataType::RealDouble, 1e-11);
+	}
+
+	void testCCSFormat()
+	{
+		beginTest("Testing out of place real FFT");
+
+		IppFFT fft(IppFFT::DataType::RealFloat);
+
+		const int N = 256;
+
+		HeapBlock<float> input;
+		fillRandom(input, N);
+
+		HeapBlock<float> perm;
+		perm.calloc(N);
+		FloatVectorOperations::copy(perm, input, N);
+		fft.realFFTInplace(perm, N);
+
+		HeapBlock<float> ccs;
+		ccs.calloc(N + 2);
+		fft.realFFT(input, ccs, N);
+
+		expectEquals<float>(ccs[0], perm[0], "DC");
+		expectEquals<float>(ccs[1], 0.0f, "DC imaginary");
+		expectEquals<float>(ccs[N], perm[1], "Nyquist");
+		expectEquals<float>(ccs[N + 1], 0.0f, "Nyquist imaginary");
+
+		for (int i = 2; i < N; i++)
+			expectEquals<float>(ccs[i], perm[i], "Bin value");
+
+		HeapBlock<float> output;
+		output.calloc(N);
+		fft.realFFTInverse(ccs, output, N);
+
+		for (int i = 0; i < N; i++)
+			expectWithinAbsoluteError<float>(output[i] / (float)N, input[i], 1e-5f, "Roundtrip value");
+	}
+
+#if USE_IPP
+
+	void testAgainstIpp()
+	{
+		beginTest("Comparing PortableFFT with IPP");
+
+		IppFFT ippFFT(IppFFT::DataType::RealFloat);
+		PortableFFT portableFFT(IPP_FFT_MAX_POWER_OF_TWO - 1, false);
+
+		IppFFT ippComplexFFT(IppFFT::DataType::ComplexFloat);
+
+		for (int order = 1; order < 13; order++)
+		{
+			const int N = 1 << order;
+
+			HeapBlock<float> a, b;
+			fillRandom(a, 2 * N);
+			b.calloc(2 * N);
+			FloatVectorOperations::copy(b, a, 2 * N);
+
+			ippFFT.realFFTInplace(a.getData(), N);
+			portableFFT.realFFTInplace(b.getData(), order);
+
+			float error = 0.0f;
+
+			for (int i = 0; i < N; i++)
+				error = jmax<float>(error, std::abs(a[i] - b[i]));
+
+			expect(error < 1e-4f * (float)N, "Real FFT deviation to IPP at size " + String(N) + ": " + String(error));
+
+			ippComplexFFT.complexFFTInplace(a.getData(), N);
+			portableFFT.complexFFTInplace(b.getData(), order, false);
+
+			error = 0.0f;
+
+			for (int i = 0; i < 2 * N; i++)
+				error = jmax<float>(error, std::abs(a[i] - b[i]));
+
+			expect(error < 1e-3f * (float)N, "Complex FFT deviation to IPP at size " + String(N) + ": " + String(error));
+		}
+	}
+
+#endif
+
+	void testThroughput()
+	{
+		beginTest("Measuring FFT throughput");
+
+		IppFFT complexFFT(IppFFT::DataType::ComplexFloat);
+		IppFFT realFFT(IppFFT::DataType::RealFloat);
+
+#if USE_IPP
+		PortableFFT portableFFT(IPP_FFT_MAX_POWER_OF_TWO - 1, false);
+#endif
+
+		for (int order = 8; order < 14; order += 2)
+		{
+			const int N = 1 << order;
+			const int numIterations = (1 << 20) / N;
+
+			HeapBlock<float> data;
+			fillRandom(data, 2 * N);
+
+			double start = Time::getMillisecondCounterHiRes();
+
+			for (int i = 0; i < numIterations; i++)
+			{
+				complexFFT.complexFFTInplace(data, N);
+				complexFFT.complexFFTInverseInplace(data, N);
+				FloatVectorOperations::multiply(data, 1.0f / (float)N, 2 * N);
+			}
+
+			const double complexTime = (Time::getMillisecondCounterHiRes() - start) * 1000.0 / (double)numIterations;
+
+			start = Time::getMillisecondCounterHiRes();
+
+			for (int i = 0; i < numIterations; i++)
+			{
+				realFFT.realFFTInplace(data, N);
+				realFFT.realFFTInverseInplace(data, N);
+				FloatVectorOperations::multiply(data, 1.0f / (float)N, N);
+			}
+
+			const double realTime = (Time::getMillisecondCounterHiRes() - start) * 1000.0 / (double)numIterations;
+
+			logMessage("Size " + String(N) + ": complex roundtrip " + String(complexTime, 2) + "us, real roundtrip " + String(realTime, 2) + "us");
+
+#if USE_IPP
+			start = Time::getMillisecondCounterHiRes();
+
+			for (int i = 0; i < numIterations; i++)
+			{
+				portableFFT.realFFTInplace(data, order);
+				portableFFT.realFFTInverseInplace(data, order);
+				FloatVectorOperations::multiply(data, 1.0f / (float)N, N);
+			}
+
+			const double portableTime = (Time::getMillisecondCounterHiRes() - start) * 1000.0 / (double)numIterations;
+
+			logMessage("Size " + String(N) + ": portable real roundtrip " + String(portableTime, 2) + "us");
+#endif
+
+			for (int i = 0; i < N; i++)
+				expect(std::isfinite(data[i]), "Finite values after roundtrips");
+		}
+	}
+};
+
+static PortableFFTUnitTests portableFFTUnitTests;
+
+#endif
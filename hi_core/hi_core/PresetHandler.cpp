@@ -438,6 +438,13 @@ void UserPresetHelpers::saveUserPreset(ModulatorSynthChain *chain, const String&
 }
 
 void UserPresetHelpers::loadUserPreset(ModulatorSynthChain *chain, const File &fileToLoad)
+{
+	chain->getMainController()->getDebugLogger().logMessage("### Loading user preset " + fileToLoad.getFileNameWithoutExtension() + "\n");
+
+	chain->getMainController()->getUserPresetHandler().loadUserPreset(fileToLoad);
+}
+
+ValueTree UserPresetHelpers::parseAndUpdateUserPreset(ModulatorSynthChain* chain, const File& fileToLoad)
 {
 	ScopedPointer<XmlElement> xml = XmlDocument::parse(fileToLoad);
     
@@ -449,19 +456,15 @@ void UserPresetHelpers::loadUserPreset(ModulatorSynthChain *chain, const File &f
             updateVersionNumber(chain, fileToLoad);
             
             xml = XmlDocument::parse(fileToLoad);
-		}
-
-        ValueTree parent = ValueTree::fromXml(*xml);
-        
-		chain->getMainController()->getDebugLogger().logMessage("### Loading user preset " + fileToLoad.getFileNameWithoutExtension() + "\n");
 
-        if (parent.isValid())
-        {
-			chain->getMainController()->getUserPresetHandler().setCurrentlyLoadedFile(fileToLoad);
+			if (xml == nullptr)
+				return ValueTree();
+		}
 
-            loadUserPreset(chain, parent);
-        }
+        return ValueTree::fromXml(*xml);
     }
+
+	return ValueTree();
 }
 
 void UserPresetHelpers::loadUserPreset(ModulatorSynthChain* chain, const ValueTree &parent)
@@ -569,6 +572,13 @@ bool UserPresetHelpers::updateVersionNumber(ModulatorSynthChain* chain, const Fi
 	return false;
 }
 
+bool UserPresetHelpers::needsVersionUpdate(const String& presetVersion, const String& currentVersion)
+{
+	SemanticVersionChecker versionChecker(presetVersion, currentVersion);
+
+	return !versionChecker.newVersionNumberIsValid() || versionChecker.isMinorVersionUpdate() || versionChecker.isMajorVersionUpdate();
+}
+
 bool UserPresetHelpers::checkVersionNumber(ModulatorSynthChain* chain, XmlElement& element)
 {
 	const String presetVersion = element.getStringAttribute("Version");
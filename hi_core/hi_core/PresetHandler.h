@@ -494,8 +494,15 @@ public:
     
     static void saveUserPreset(ModulatorSynthChain *chain, const String& targetFile=String(), NotificationType notify=sendNotification);
     
+    /** Loads the preset file asynchronously (see MainController::UserPresetHandler::loadUserPreset()). */
     static void loadUserPreset(ModulatorSynthChain *chain, const File &fileToLoad);
 
+	/** Parses the preset file and adds the missing controls if it was saved with an older version.
+	*
+	*	This might show a message box, so it must be called on the message thread.
+	*/
+	static ValueTree parseAndUpdateUserPreset(ModulatorSynthChain* chain, const File& fileToLoad);
+
 	static void loadUserPreset(ModulatorSynthChain* chain, const ValueTree &v);
     
 	static int addMissingControlsToUserPreset(ModulatorSynthChain* chain, const File& fileToUpdate);
@@ -508,6 +515,9 @@ public:
 
 	static bool checkVersionNumber(ModulatorSynthChain* chain, XmlElement& element);
 
+	/** Returns true if the preset needs to be updated with parseAndUpdateUserPreset(). This can be called on any thread. */
+	static bool needsVersionUpdate(const String& presetVersion, const String& currentVersion);
+
 	static String getCurrentVersionNumber(ModulatorSynthChain* chain);
 
     static File getUserPresetFile(ModulatorSynthChain *chain, const String &fileNameWithoutExtension);
@@ -0,0 +1,202 @@
+/*  ===========================================================================
+*
+*   This file is part of HISE.
+*   Copyright 2016 Christoph Hart
+*
+*   HISE is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   HISE is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with HISE.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Commercial licenses for using HISE in an closed source project are
+*   available on request. Please visit the project's website to get more
+*   information about commercial licensing:
+*
+*   http://www.hise.audio/
+*
+*   HISE is based on the JUCE library,
+*   which must be separately licensed for closed source applications:
+*
+*   http://www.juce.com
+*
+*   ===========================================================================
+*/
+
+namespace hise { using namespace juce;
+
+std::atomic<uint32> TelemetryRing::Source::numSourcesCreated(0);
+
+TelemetryRing::Source::Source() :
+	telemetrySourceId(++numSourcesCreated)
+{
+}
+
+TelemetryRing::TelemetryRing() :
+	readIndex(0),
+	writeIndex(0),
+	numSubscriptions(0),
+	numDroppedRecords(0)
+{
+	records.calloc(RingSize);
+}
+
+TelemetryRing::~TelemetryRing()
+{
+	stopTimer();
+}
+
+bool TelemetryRing::push(const Record& r) noexcept
+{
+	if (numSubscriptions.load() == 0)
+		return false;
+
+	// The ring has a single consumer, so this makes sure that there is only one producer at a time.
+	const GenericScopedTryLock<SpinLock> sl(pushLock);
+
+	if (!sl.isLocked())
+	{
+		numDroppedRecords++;
+		return false;
+	}
+
+	const int w = writeIndex.load(std::memory_order_relaxed);
+	const int next = (w + 1) & RingMask;
+
+	if (next == readIndex.load(std::memory_order_acquire))
+	{
+		numDroppedRecords++;
+		return false;
+	}
+
+	records[w] = r;
+	writeIndex.store(next, std::memory_order_release);
+
+	return true;
+}
+
+bool TelemetryRing::push(const Source* source, RecordType type, float value, int index/*=0*/, double position/*=0.0*/) noexcept
+{
+	Record r;
+
+	r.source = source;
+	r.sourceId = source->getTelemetrySourceId();
+	r.type = type;
+	r.index = index;
+	r.value = value;
+	r.position = position;
+
+	return push(r);
+}
+
+void TelemetryRing::addSubscriber(const Source* source, Subscriber* s)
+{
+	jassert(MessageManager::getInstance()->isThisTheMessageThread());
+
+	const uint32 sourceId = source->getTelemetrySourceId();
+
+	for (const auto& sub : subscriptions)
+	{
+		if (sub.sourceId == sourceId && sub.subscriber.get() == s)
+			return;
+	}
+
+	subscriptions.add({ sourceId, s });
+	updateTimer();
+}
+
+void TelemetryRing::removeSubscriber(const Source* source, Subscriber* s)
+{
+	const uint32 sourceId = source->getTelemetrySourceId();
+
+	for (int i = 0; i < subscriptions.size(); i++)
+	{
+		const auto& sub = subscriptions.getReference(i);
+
+		if (sub.sourceId == sourceId && sub.subscriber.get() == s)
+			subscriptions.remove(i--);
+	}
+
+	updateTimer();
+}
+
+void TelemetryRing::removeSubscriber(Subscriber* s)
+{
+	for (int i = 0; i < subscriptions.size(); i++)
+	{
+		auto sub = subscriptions.getReference(i).subscriber.get();
+
+		if (sub == s || sub == nullptr)
+			subscriptions.remove(i--);
+	}
+
+	updateTimer();
+}
+
+void TelemetryRing::updateTimer()
+{
+	numSubscriptions.store(subscriptions.size());
+
+	if (subscriptions.size() == 0)
+	{
+		stopTimer();
+
+		// Discard the records that weren't drained so they don't show up at the next subscription
+		readIndex.store(writeIndex.load(std::memory_order_acquire), std::memory_order_release);
+	}
+	else if (!isTimerRunning())
+	{
+		startTimer(30);
+	}
+}
+
+void TelemetryRing::timerCallback()
+{
+	int r = readIndex.load(std::memory_order_relaxed);
+	const int w = writeIndex.load(std::memory_order_acquire);
+
+	if (r == w)
+		return;
+
+	Array<WeakReference<Subscriber>> drainedSubscribers;
+
+	// A subscriber might remove itself (or others) in the callback, so this iterates over a copy.
+	// Subscribers that are deleted in the meantime are skipped by the weak reference.
+	const Array<Subscription> currentSubscriptions(subscriptions);
+
+	while (r != w)
+	{
+		const Record& record = records[r];
+
+		for (const auto& sub : currentSubscriptions)
+		{
+			if (sub.sourceId != record.sourceId)
+				continue;
+
+			if (auto s = sub.subscriber.get())
+			{
+				s->telemetryReceived(record);
+				drainedSubscribers.addIfNotAlreadyThere(s);
+			}
+		}
+
+		r = (r + 1) & RingMask;
+	}
+
+	readIndex.store(r, std::memory_order_release);
+
+	for (auto& s : drainedSubscribers)
+	{
+		if (s.get() != nullptr)
+			s->telemetryDrained();
+	}
+}
+
+} // namespace hise
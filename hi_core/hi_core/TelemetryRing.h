@@ -0,0 +1,172 @@
+/*  ===========================================================================
+*
+*   This file is part of HISE.
+*   Copyright 2016 Christoph Hart
+*
+*   HISE is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   HISE is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with HISE.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Commercial licenses for using HISE in an closed source project are
+*   available on request. Please visit the project's website to get more
+*   information about commercial licensing:
+*
+*   http://www.hise.audio/
+*
+*   HISE is based on the JUCE library,
+*   which must be separately licensed for closed source applications:
+*
+*   http://www.juce.com
+*
+*   ===========================================================================
+*/
+
+#ifndef TELEMETRYRING_H_INCLUDED
+#define TELEMETRYRING_H_INCLUDED
+
+namespace hise { using namespace juce;
+
+/** A lock-free ring buffer that transports display values from the audio thread to the interface.
+*
+*	Instead of sending a change message for every value that changes in the audio callback, the audio thread
+*	pushes a small fixed size Record into this ring. A timer on the message thread drains the ring every 30ms
+*	and sends the records to the Subscribers that are registered for the source of the record.
+*
+*	Pushing never allocates or waits: if the ring is full or another thread is pushing at the same time,
+*	the record is dropped (it's only display data). If nobody is subscribed, nothing is pushed at all.
+*/
+class TelemetryRing : private Timer
+{
+public:
+
+	enum RecordType
+	{
+		ModulatorValue = 0, ///< the value of a plotted modulator (value)
+		PlaybackPosition, ///< the normalised playback position of a sampler (position) and the sample start (value)
+		SamplerNotes, ///< a note of a sampler was started or stopped (index = note number, value = velocity)
+		numRecordTypes
+	};
+
+	/** Subclass the objects that push records from this class.
+	*
+	*	Every source gets a unique ID, so records of a deleted source are not sent to the subscribers of a new
+	*	source that was created at the same address.
+	*/
+	class Source
+	{
+	public:
+
+		Source();
+		virtual ~Source() {};
+
+		uint32 getTelemetrySourceId() const noexcept { return telemetrySourceId; }
+
+	private:
+
+		uint32 telemetrySourceId;
+
+		static std::atomic<uint32> numSourcesCreated;
+	};
+
+	struct Record
+	{
+		/** Only use this to identify the source, it might be deleted already. */
+		const Source* source = nullptr;
+		uint32 sourceId = 0;
+		RecordType type = numRecordTypes;
+		int index = 0;
+		float value = 0.0f;
+		double position = 0.0;
+	};
+
+	/** Subclass this and register it with addSubscriber() to get the records of a source. */
+	class Subscriber
+	{
+	public:
+
+		virtual ~Subscriber() { masterReference.clear(); };
+
+		/** Called on the message thread for every record of a subscribed source. */
+		virtual void telemetryReceived(const Record& r) = 0;
+
+		/** Called once after all records of a drain were sent. Use this to repaint. */
+		virtual void telemetryDrained() {};
+
+	private:
+
+		friend class WeakReference<Subscriber>;
+		WeakReference<Subscriber>::Master masterReference;
+	};
+
+	TelemetryRing();
+	~TelemetryRing();
+
+	/** Adds the record to the ring. This is lock-free and can be called from the audio thread. 
+	*
+	*	Returns false if the record was dropped.
+	*/
+	bool push(const Record& r) noexcept;
+
+	/** Convenience function that creates and pushes a record. */
+	bool push(const Source* source, RecordType type, float value, int index=0, double position=0.0) noexcept;
+
+	/** Returns true if there is a subscriber. You can use this to skip the calculation of the values. */
+	bool hasSubscribers() const noexcept { return numSubscriptions.load() != 0; };
+
+	/** Registers the subscriber for all records of the given source. Call this on the message thread. */
+	void addSubscriber(const Source* source, Subscriber* s);
+
+	/** Removes the subscription for the given source. */
+	void removeSubscriber(const Source* source, Subscriber* s);
+
+	/** Removes all subscriptions of the subscriber. */
+	void removeSubscriber(Subscriber* s);
+
+	/** Returns the number of records that were dropped because the ring was full. */
+	int getNumDroppedRecords() const noexcept { return numDroppedRecords.load(); };
+
+private:
+
+	enum
+	{
+		RingSize = 4096,
+		RingMask = RingSize - 1
+	};
+
+	struct Subscription
+	{
+		uint32 sourceId;
+		WeakReference<Subscriber> subscriber;
+	};
+
+	void timerCallback() override;
+
+	void updateTimer();
+
+	HeapBlock<Record> records;
+
+	std::atomic<int> readIndex;
+	std::atomic<int> writeIndex;
+
+	std::atomic<int> numSubscriptions;
+	std::atomic<int> numDroppedRecords;
+
+	SpinLock pushLock;
+
+	Array<Subscription> subscriptions;
+
+	JUCE_DECLARE_NON_COPYABLE(TelemetryRing)
+};
+
+} // namespace hise
+
+#endif  // TELEMETRYRING_H_INCLUDED
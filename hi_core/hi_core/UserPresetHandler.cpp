@@ -32,9 +32,152 @@
 
 namespace hise { using namespace juce;
 
+/** Parses the preset files in the background so that the message thread is not blocked while browsing through presets.
+*
+*	It only keeps the most recent request, so if the presets are requested faster than they can be parsed, the older ones are skipped.
+*/
+class MainController::UserPresetHandler::LoadingThread : public Thread
+{
+public:
+
+	struct ParsedPreset
+	{
+		File file;
+		ValueTree preset;
+		bool needsVersionUpdate = false;
+		int requestId = -1;
+	};
+
+	LoadingThread(UserPresetHandler& parent_) :
+		Thread("User Preset Loading Thread"),
+		parent(parent_)
+	{};
+
+	~LoadingThread()
+	{
+		stopThread(2000);
+	}
+
+	void addRequest(const File& f, const String& currentVersion, int requestId)
+	{
+		{
+			SpinLock::ScopedLockType sl(requestLock);
+
+			pendingRequest.file = f;
+			pendingRequest.requestId = requestId;
+			pendingVersion = currentVersion;
+		}
+
+		if (!isThreadRunning())
+			startThread();
+
+		notify();
+	}
+
+	bool getParsedPreset(ParsedPreset& p)
+	{
+		SpinLock::ScopedLockType sl(resultLock);
+
+		if (parsedPreset.requestId == -1)
+			return false;
+
+		p = parsedPreset;
+		parsedPreset = ParsedPreset();
+
+		return true;
+	}
+
+	void run() override
+	{
+		while (!threadShouldExit())
+		{
+			ParsedPreset request;
+			String currentVersion;
+
+			{
+				SpinLock::ScopedLockType sl(requestLock);
+
+				request = pendingRequest;
+				currentVersion = pendingVersion;
+				pendingRequest = ParsedPreset();
+			}
+
+			if (request.requestId == -1)
+			{
+				wait(-1);
+				continue;
+			}
+
+			ScopedPointer<XmlElement> xml = XmlDocument::parse(request.file);
+
+			if (xml == nullptr || !parent.isLatestLoadRequest(request.requestId))
+				continue;
+
+			request.needsVersionUpdate = UserPresetHelpers::needsVersionUpdate(xml->getStringAttribute("Version"), currentVersion);
+
+			// The message thread will parse the file again after updating it
+			if (!request.needsVersionUpdate)
+				request.preset = ValueTree::fromXml(*xml);
+
+			{
+				SpinLock::ScopedLockType sl(resultLock);
+				parsedPreset = request;
+			}
+
+			parent.triggerAsyncUpdate();
+		}
+	}
+
+private:
+
+	UserPresetHandler& parent;
+
+	SpinLock requestLock;
+	ParsedPreset pendingRequest;
+	String pendingVersion;
+
+	SpinLock resultLock;
+	ParsedPreset parsedPreset;
+
+	JUCE_DECLARE_NON_COPYABLE(LoadingThread);
+};
+
+MainController::UserPresetHandler::UserPresetHandler(MainController* mc_) :
+	mc(mc_),
+	latestLoadRequest(0)
+{
+
+}
+
+MainController::UserPresetHandler::~UserPresetHandler()
+{
+	cancelPendingUpdate();
+
+	// Stop the thread before the async updater is destroyed
+	loadingThread = nullptr;
+}
+
 void MainController::UserPresetHandler::loadUserPreset(const ValueTree& v)
 {
-	auto f = [this, v](Processor*) {loadUserPresetInternal(v); return true; };
+	restoreUserPreset(v, File(), ++latestLoadRequest);
+}
+
+void MainController::UserPresetHandler::restoreUserPreset(const ValueTree& v, const File& presetFile, int requestId)
+{
+	auto f = [this, v, presetFile, requestId](Processor*) 
+	{
+		// Skip the preset if another one was requested while the voices were killed
+		if (isLatestLoadRequest(requestId))
+		{
+			loadUserPresetInternal(v);
+
+			// The file is only set after the preset was applied, so a skipped preset is never reported as current
+			if (presetFile != File())
+				setCurrentlyLoadedFile(presetFile);
+		}
+
+		return true; 
+	};
 
 	auto synthChain = mc->getMainSynthChain();
 
@@ -43,17 +186,29 @@ void MainController::UserPresetHandler::loadUserPreset(const ValueTree& v)
 
 void MainController::UserPresetHandler::loadUserPreset(const File& f)
 {
-	ScopedPointer<XmlElement> xml = XmlDocument::parse(f);
+	const int requestId = ++latestLoadRequest;
 
-	if (xml != nullptr)
-	{
-		ValueTree v = ValueTree::fromXml(*xml);
+	if (loadingThread == nullptr)
+		loadingThread = new LoadingThread(*this);
 
-		if (v.isValid())
-		{
-			loadUserPreset(v);
-		}
-	}
+	loadingThread->addRequest(f, UserPresetHelpers::getCurrentVersionNumber(mc->getMainSynthChain()), requestId);
+}
+
+void MainController::UserPresetHandler::handleAsyncUpdate()
+{
+	LoadingThread::ParsedPreset p;
+
+	if (loadingThread == nullptr || !loadingThread->getParsedPreset(p))
+		return;
+
+	if (!isLatestLoadRequest(p.requestId))
+		return;
+
+	if (p.needsVersionUpdate)
+		p.preset = UserPresetHelpers::parseAndUpdateUserPreset(mc->getMainSynthChain(), p.file);
+
+	if (p.preset.isValid() && isLatestLoadRequest(p.requestId))
+		restoreUserPreset(p.preset, p.file, p.requestId);
 }
 
 File MainController::UserPresetHandler::getCurrentlyLoadedFile() const
@@ -132,7 +287,7 @@ void MainController::UserPresetHandler::loadUserPresetInternal(const ValueTree&
 
 		if (v.isValid())
 		{
-			sp->getScriptingContent()->restoreAllControlsFromPreset(v);
+			sp->getScriptingContent()->restoreAllControlsFromPreset(v, true);
 		}
 	}
 
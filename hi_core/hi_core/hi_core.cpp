@@ -59,12 +59,12 @@
 
 #include "CustomDataContainers.cpp"
 
-#if USE_IPP
+#include "PortableFFT.cpp"
 #include "IppFFT.cpp"
-#endif
 
 #include "UtilityClasses.cpp"
 #include "DebugLogger.cpp"
+#include "TelemetryRing.cpp"
 #include "ThreadWithQuasiModalProgressWindow.cpp"
 #include "HI_LookAndFeels.cpp"
 #include "Tables.cpp"
@@ -56,9 +56,8 @@ struct TestGlobalNamespace
 #include "VariantBuffer.h"
 
 
-#if USE_IPP
+#include "PortableFFT.h"
 #include "IppFFT.h"
-#endif
 
 
 #include "CustomDataContainers.h"
@@ -75,6 +74,7 @@ struct TestGlobalNamespace
 #include "HI_LookAndFeels.h"
 #include "HiseEventBuffer.h"
 #include "DebugLogger.h"
+#include "TelemetryRing.h"
 
 
 #include "ThreadWithQuasiModalProgressWindow.h"
@@ -176,22 +176,29 @@ void ModulatorSynthChain::addProcessorsWhenEmpty()
 
 void ModulatorSynthChain::compileAllScripts()
 {
+	TRACE_STARTUP_ZONE("compileAllScripts");
+
 	if (getMainController()->isCompilingAllScriptsOnPresetLoad())
 	{
 		Processor::Iterator<JavascriptProcessor> it(this);
 
 		JavascriptProcessor *sp;
 
+		Array<JavascriptProcessor*> processors;
+		OwnedArray<ValueTreeUpdateWatcher::ScopedDelayer> delayers;
+
 		while ((sp = it.getNextProcessor()) != 0)
 		{
 			auto c = sp->getContent();
 
-			ValueTreeUpdateWatcher::ScopedDelayer sd(c->getUpdateWatcher());
+			delayers.add(new ValueTreeUpdateWatcher::ScopedDelayer(c->getUpdateWatcher()));
 
 			sp->getContent()->resetContentProperties();
 
-			sp->compileScript();
+			processors.add(sp);
 		}
+
+		JavascriptProcessor::compileAll(processors);
 	}
 }
 
@@ -149,7 +149,7 @@ void Modulator::addValueToPlotter(float v) const
 {
 	if(attachedPlotter.getComponent() != nullptr) 
 	{
-		attachedPlotter.getComponent()->addValue(this, v);
+		getMainController()->getTelemetryRing().push(this, TelemetryRing::ModulatorValue, v);
 	}
 };
 
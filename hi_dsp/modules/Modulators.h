@@ -213,7 +213,8 @@ private:
 	@ingroup modulator
 	@see ModulatorChain, ModulatorEditor
 */
-class Modulator: public Processor
+class Modulator: public Processor,
+				 public TelemetryRing::Source
 {
 public:
 
@@ -255,6 +256,8 @@ public:
 	bool isPlotted() const;
 
 	/** Adds a value to the plotter. It is okay to do this on a sample level, the Plotter automatically interpolates it.
+	*
+	*	The value is pushed into the TelemetryRing of the MainController, so this can be called from the audio thread.
 	*/
 	void addValueToPlotter(float v) const;
 
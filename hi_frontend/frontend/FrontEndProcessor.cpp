@@ -99,6 +99,8 @@ unlocker(TURBOACTIVATE_FILE_PATH)
 unlockCounter(0)
 #endif
 {
+	TRACE_STARTUP_ZONE("FrontendProcessor()");
+
 	LOG_START("Checking license");
 
     HiseDeviceSimulator::init(wrapperType);
@@ -130,6 +132,8 @@ unlockCounter(0)
     
 	if (impulseData != nullptr)
 	{
+		TRACE_STARTUP_ZONE("Load impulses");
+
 		getSampleManager().getAudioSampleBufferPool()->restoreFromValueTree(*impulseData);
 	}
 	else
@@ -142,6 +146,8 @@ unlockCounter(0)
 
 			LOG_START("Load impulses");
 
+			TRACE_STARTUP_ZONE("Load impulses");
+
 			ValueTree impulseDataFile = ValueTree::readFromStream(fis);
 
 			if (impulseDataFile.isValid())
@@ -166,7 +172,10 @@ unlockCounter(0)
 
 		LOG_START("Restoring main container");
 
-		synthChain->restoreFromValueTree(synthData);
+		{
+			TRACE_STARTUP_ZONE("restoreFromValueTree");
+			synthChain->restoreFromValueTree(synthData);
+		}
 
 		setSkipCompileAtPresetLoad(false);
 
@@ -178,7 +187,10 @@ unlockCounter(0)
 
 		LOG_START("Adding plugin parameters");
 
-		addScriptedParameters();
+		{
+			TRACE_STARTUP_ZONE("Add plugin parameters");
+			addScriptedParameters();
+		}
 
 		CHECK_COPY_AND_RETURN_6(synthChain);
 
@@ -186,6 +198,8 @@ unlockCounter(0)
 		{
 			LOG_START("Initialising audio callback");
 
+			TRACE_STARTUP_ZONE("prepareToPlay");
+
 			synthChain->prepareToPlay(getSampleRate(), getBlockSize());
 		}
 
@@ -196,6 +210,8 @@ unlockCounter(0)
 		}
 #endif
 
+		TRACE_STARTUP_ZONE("Create user preset data");
+
 		createUserPresetData();
 	}
 
@@ -228,6 +244,8 @@ void FrontendProcessor::setCurrentProgram(int /*index*/)
 
 void FrontendProcessor::loadImages(ValueTree *imageData)
 {
+	TRACE_STARTUP_ZONE("Load images");
+
 #if HISE_IOS
     
     // The images are loaded from actual files here...
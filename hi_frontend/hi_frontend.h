@@ -86,7 +86,8 @@ AudioProcessor* createPlugin(ValueTree &presetData, ValueTree &imageData, ValueT
 
 #if DONT_EMBED_FILES_IN_FRONTEND
 
-#define CREATE_PLUGIN(deviceManager, callback) {ValueTree presetData = ValueTree::readFromData(PresetData::preset, PresetData::presetSize);\
+#define CREATE_PLUGIN(deviceManager, callback) {TRACE_STARTUP_ZONE("Create plugin");\
+	ValueTree presetData = ValueTree::readFromData(PresetData::preset, PresetData::presetSize);\
 ValueTree externalFiles = hise::PresetHandler::loadValueTreeFromData(PresetData::externalFiles, PresetData::externalFilesSize, true);\
 	\
 	hise::FrontendProcessor* fp = new hise::FrontendProcessor(presetData, deviceManager, callback, nullptr, nullptr, &externalFiles, nullptr);\
@@ -99,7 +100,8 @@ ValueTree externalFiles = hise::PresetHandler::loadValueTreeFromData(PresetData:
 #define CREATE_PLUGIN_WITH_AUDIO_FILES CREATE_PLUGIN // same same
 
 #else
-#define CREATE_PLUGIN(deviceManager, callback) {ValueTree presetData = ValueTree::readFromData(PresetData::preset, PresetData::presetSize);\
+#define CREATE_PLUGIN(deviceManager, callback) {TRACE_STARTUP_ZONE("Create plugin");\
+	ValueTree presetData = ValueTree::readFromData(PresetData::preset, PresetData::presetSize);\
 	ValueTree externalFiles = hise::PresetHandler::loadValueTreeFromData(PresetData::externalFiles, PresetData::externalFilesSize, true);\
 	\
 	auto fp = new hise::FrontendProcessor(presetData, deviceManager, callback, nullptr, nullptr, &externalFiles, nullptr);\
@@ -110,6 +112,7 @@ ValueTree externalFiles = hise::PresetHandler::loadValueTreeFromData(PresetData:
 }
 
 #define CREATE_PLUGIN_WITH_AUDIO_FILES(deviceManager, callback) {\
+	TRACE_STARTUP_ZONE("Create plugin");\
     LOG_START("Loading embedded instrument data")\
     ValueTree presetData = ValueTree::readFromData(PresetData::preset, PresetData::presetSize);\
 	LOG_START("Loading embedded image data")\
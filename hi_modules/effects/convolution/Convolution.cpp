@@ -45,6 +45,7 @@ AudioSampleProcessor(this),
 dryGain(0.0f),
 wetGain(1.0f),
 wetBuffer(2, 0),
+partitionedBuffer(2, 0),
 latency(0),
 isReloading(false),
 rampFlag(false),
@@ -59,6 +60,7 @@ wdlPimpl(new WdlPimpl())
 	parameterNames.add("Latency");
 	parameterNames.add("ImpulseLength");
 	parameterNames.add("ProcessInput");
+	parameterNames.add("UseBackgroundThread");
 
 	smoothedGainerWet.setParameter((int)ScriptingDsp::SmoothedGainer::Parameters::FastMode, 1.0f);
 	smoothedGainerDry.setParameter((int)ScriptingDsp::SmoothedGainer::Parameters::FastMode, 1.0f);
@@ -80,6 +82,52 @@ void ConvolutionEffect::setImpulse()
 
 	ScopedValueSetter<bool> s(isReloading, true);
 
+	if (useBackgroundThread)
+	{
+		const int numChannels = jmin(2, getSampleBuffer()->getNumChannels());
+		const int numSamples = jmin(length, getSampleBuffer()->getNumSamples() - sampleRange.getStart());
+
+		if (numSamples <= 0)
+		{
+			ScopedLock sl(getImpulseLock());
+			partitionedEngine.setImpulse(nullptr);
+			return;
+		}
+
+		const float* impulseData[2] = { getSampleBuffer()->getReadPointer(0, sampleRange.getStart()),
+										getSampleBuffer()->getReadPointer(numChannels - 1, sampleRange.getStart()) };
+
+		// The spectra only depend on these properties, so other instances with the same impulse can use the same data.
+		// The content hash makes sure that a changed impulse response with the same name is not served from the pool.
+		String key = getFileName() + "@" + String(sampleRange.getStart()) + ":" + String(numSamples) + 
+					 "@" + String(getSampleRate()) + "@" + String(getBlockSize());
+
+		for (int i = 0; i < numChannels; i++)
+			key << "@" << MD5(impulseData[i], sizeof(float) * (size_t)numSamples).toHexString();
+
+		auto pool = getMainController()->getSampleManager().getAudioSampleBufferPool();
+
+		PartitionedConvolutionEngine::ImpulseSpectra::Ptr spectra;
+
+		if (getFileName().isNotEmpty())
+			spectra = dynamic_cast<PartitionedConvolutionEngine::ImpulseSpectra*>(pool->getSharedData(key).get());
+
+		if (spectra == nullptr)
+		{
+			spectra = new PartitionedConvolutionEngine::ImpulseSpectra(impulseData, numChannels, numSamples, getBlockSize());
+
+			if (getFileName().isNotEmpty())
+				pool->addSharedData(key, spectra.get());
+		}
+
+		// The spectra are calculated without holding the lock, so this only blocks the audio thread for the allocation of the buffers.
+		ScopedLock sl(getImpulseLock());
+
+		partitionedEngine.setImpulse(spectra.get());
+
+		return;
+	}
+
 	ScopedLock sl(getImpulseLock());
 
 	wdlPimpl->convolutionEngine.Reset();
@@ -109,6 +157,7 @@ float ConvolutionEffect::getAttribute(int parameterIndex) const
 	case Latency:		return (float)latency;
 	case ImpulseLength:	return 1.0f;
 	case ProcessInput:	return processFlag ? 1.0f : 0.0f;
+	case UseBackgroundThread: return useBackgroundThread ? 1.0f : 0.0f;
 	default:			jassertfalse; return 1.0f;
 	}
 }
@@ -130,6 +179,22 @@ void ConvolutionEffect::setInternalAttribute(int parameterIndex, float newValue)
 	case ImpulseLength:	setImpulse();
 		break;
 	case ProcessInput:	enableProcessing(newValue >= 0.5f); break;
+	case UseBackgroundThread:
+	{
+		const bool shouldUseBackgroundThread = newValue >= 0.5f;
+
+		if (shouldUseBackgroundThread != useBackgroundThread)
+		{
+			{
+				ScopedLock sl(getImpulseLock());
+				useBackgroundThread = shouldUseBackgroundThread;
+			}
+
+			setImpulse();
+		}
+
+		break;
+	}
 	default:			jassertfalse; return;
 	}
 }
@@ -143,6 +208,7 @@ void ConvolutionEffect::restoreFromValueTree(const ValueTree &v)
 	loadAttribute(Latency, "Latency");
 	loadAttribute(ImpulseLength, "ImpulseLength");
 	loadAttribute(ProcessInput, "ProcessInput");
+	loadAttribute(UseBackgroundThread, "UseBackgroundThread");
 
 	AudioSampleProcessor::restoreFromValueTree(v);
 }
@@ -156,6 +222,7 @@ ValueTree ConvolutionEffect::exportAsValueTree() const
 	saveAttribute(Latency, "Latency");
 	saveAttribute(ImpulseLength, "ImpulseLength");
 	saveAttribute(ProcessInput, "ProcessInput");
+	saveAttribute(UseBackgroundThread, "UseBackgroundThread");
 
 	AudioSampleProcessor::saveToValueTree(v);
 
@@ -167,6 +234,7 @@ void ConvolutionEffect::prepareToPlay(double sampleRate, int samplesPerBlock)
 	EffectProcessor::prepareToPlay(sampleRate, samplesPerBlock);
 
 	ProcessorHelpers::increaseBufferIfNeeded(wetBuffer, samplesPerBlock);
+	ProcessorHelpers::increaseBufferIfNeeded(partitionedBuffer, samplesPerBlock);
 
 	if (sampleRate != lastSampleRate)
 	{
@@ -178,9 +246,15 @@ void ConvolutionEffect::prepareToPlay(double sampleRate, int samplesPerBlock)
 		smoothedGainerDry.prepareToPlay(sampleRate, samplesPerBlock);
 
 		wdlPimpl->convolutionEngine.Reset();
+		partitionedEngine.reset();
 	}
 
-	
+	if (useBackgroundThread && partitionedEngine.getBlockSize() != jlimit<int>(PartitionedConvolutionEngine::MinBlockSize, 
+																			   PartitionedConvolutionEngine::MaxBlockSize, 
+																			   nextPowerOfTwo(samplesPerBlock)))
+	{
+		setImpulse();
+	}
 }
 
 void ConvolutionEffect::applyEffect(AudioSampleBuffer &buffer, int startSample, int numSamples)
@@ -214,7 +288,17 @@ void ConvolutionEffect::applyEffect(AudioSampleBuffer &buffer, int startSample,
 		return;
 	}
 
-	wdlPimpl->convolutionEngine.Add(channels, numSamples, 2);
+	if (useBackgroundThread)
+	{
+		FloatVectorOperations::copy(partitionedBuffer.getWritePointer(0), l, numSamples);
+		FloatVectorOperations::copy(partitionedBuffer.getWritePointer(1), r, numSamples);
+
+		partitionedEngine.processBlock(partitionedBuffer.getArrayOfWritePointers(), 2, numSamples);
+	}
+	else
+	{
+		wdlPimpl->convolutionEngine.Add(channels, numSamples, 2);
+	}
 
 	smoothedGainerDry.processBlock(channels, 2, numSamples);
 
@@ -223,12 +307,12 @@ void ConvolutionEffect::applyEffect(AudioSampleBuffer &buffer, int startSample,
 	currentValues.inR = FloatVectorOperations::findMaximum(l, numSamples);
 #endif
 
-	const int availableSamples = jmin(wdlPimpl->convolutionEngine.Avail(numSamples), numSamples);
+	const int availableSamples = useBackgroundThread ? numSamples : jmin(wdlPimpl->convolutionEngine.Avail(numSamples), numSamples);
 
 	if (availableSamples > 0)
 	{
-		const float *convolutedL = wdlPimpl->convolutionEngine.Get()[0];
-		const float *convolutedR = wdlPimpl->convolutionEngine.Get()[1];
+		const float *convolutedL = useBackgroundThread ? partitionedBuffer.getReadPointer(0) : wdlPimpl->convolutionEngine.Get()[0];
+		const float *convolutedR = useBackgroundThread ? partitionedBuffer.getReadPointer(1) : wdlPimpl->convolutionEngine.Get()[1];
 
 #if ENABLE_ALL_PEAK_METERS
 		currentValues.outL = wetGain * FloatVectorOperations::findMaximum(convolutedL, availableSamples);
@@ -252,13 +336,15 @@ void ConvolutionEffect::applyEffect(AudioSampleBuffer &buffer, int startSample,
 				rampIndex++;
 			}
 
-			wdlPimpl->convolutionEngine.Advance(availableSamples);
+			if (!useBackgroundThread)
+				wdlPimpl->convolutionEngine.Advance(availableSamples);
 
 			if (rampIndex >= rampingTime)
 			{
 				if (!processFlag)
 				{
 					wdlPimpl->convolutionEngine.Reset();
+					partitionedEngine.reset();
 				}
 
 				rampFlag = false;
@@ -275,7 +361,8 @@ void ConvolutionEffect::applyEffect(AudioSampleBuffer &buffer, int startSample,
 			FloatVectorOperations::add(l, wetBuffer.getReadPointer(0), availableSamples);
 			FloatVectorOperations::add(r, wetBuffer.getReadPointer(1), availableSamples);
 
-			wdlPimpl->convolutionEngine.Advance(availableSamples);
+			if (!useBackgroundThread)
+				wdlPimpl->convolutionEngine.Advance(availableSamples);
 		}
 	}
 
@@ -109,6 +109,9 @@ private:
 *	This is a wrapper for the convolution engine found in WDL (the sole MIT licenced convolution engine available)
 *	It is not designed to replace real convolution reverbs (as the CPU usage for impulses > 0.6 seconds is unreasonable),
 *	but your early reflection impulses or other filter impulses will be thankful for this effect.
+*
+*	If UseBackgroundThread is enabled, it uses a PartitionedConvolutionEngine instead, which calculates the larger 
+*	partitions of the tail on a background thread, so longer impulse responses can be used without spikes in the audio callback.
 */
 class ConvolutionEffect: public MasterEffectProcessor,
 						 public AudioSampleProcessor
@@ -126,6 +129,7 @@ public:
 		Latency, ///< you can change the latency (unused)
 		ImpulseLength, ///< the Impulse length (deprecated, use the SampleArea of the AudioSampleBufferComponent to change the impulse response)
 		ProcessInput, ///< if this attribute is set, the engine will fade out in a short time and reset itself.
+		UseBackgroundThread, ///< uses the non-uniform partitioned engine which calculates the tail on a background thread.
 		numEffectParameters
 	};
 
@@ -195,6 +199,11 @@ private:
 
 	ScopedPointer<WdlPimpl> wdlPimpl;
 
+	bool useBackgroundThread = false;
+
+	PartitionedConvolutionEngine partitionedEngine;
+	AudioSampleBuffer partitionedBuffer;
+
 	double lastSampleRate = 0.0;
 };
 
@@ -0,0 +1,741 @@
+/*  ===========================================================================
+*
+*   This file is part of HISE.
+*   Copyright 2016 Christoph Hart
+*
+*   HISE is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   HISE is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with HISE.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Commercial licenses for using HISE in an closed source project are
+*   available on request. Please visit the project's website to get more
+*   information about commercial licensing:
+*
+*   http://www.hise.audio/
+*
+*   HISE is based on the JUCE library,
+*   which must be separately licensed for closed source applications:
+*
+*   http://www.juce.com
+*
+*   ===========================================================================
+*/
+
+namespace hise { using namespace juce;
+
+class PartitionedConvolutionEngine::BackgroundThread : public Thread
+{
+public:
+
+	BackgroundThread() :
+		Thread("Convolution Tail Thread")
+	{
+		startThread(8);
+	}
+
+	~BackgroundThread()
+	{
+		stopThread(1000);
+	}
+
+	void addEngine(PartitionedConvolutionEngine* e)
+	{
+		ScopedLock sl(engineLock);
+		engines.addIfNotAlreadyThere(e);
+	}
+
+	void removeEngine(PartitionedConvolutionEngine* e)
+	{
+		ScopedLock sl(engineLock);
+		engines.removeAllInstancesOf(e);
+	}
+
+	void run() override
+	{
+		while (!threadShouldExit())
+		{
+			bool didSomething = false;
+
+			{
+				ScopedLock sl(engineLock);
+
+				for (auto e : engines)
+					didSomething |= e->processPendingTailBlocks();
+			}
+
+			if (!didSomething)
+				wait(100);
+		}
+	}
+
+private:
+
+	CriticalSection engineLock;
+	Array<PartitionedConvolutionEngine*> engines;
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(BackgroundThread)
+};
+
+namespace PartitionedConvolutionHelpers
+{
+
+static void writeToRing(float* ring, int mask, int64 position, const float* source, int numSamples)
+{
+	const int start = (int)(position & mask);
+	const int numBeforeWrap = jmin(numSamples, mask + 1 - start);
+
+	FloatVectorOperations::copy(ring + start, source, numBeforeWrap);
+
+	if (numBeforeWrap < numSamples)
+		FloatVectorOperations::copy(ring, source + numBeforeWrap, numSamples - numBeforeWrap);
+}
+
+static void readFromRing(float* destination, const float* ring, int mask, int64 position, int numSamples)
+{
+	const int start = (int)(position & mask);
+	const int numBeforeWrap = jmin(numSamples, mask + 1 - start);
+
+	FloatVectorOperations::copy(destination, ring + start, numBeforeWrap);
+
+	if (numBeforeWrap < numSamples)
+		FloatVectorOperations::copy(destination + numBeforeWrap, ring, numSamples - numBeforeWrap);
+}
+
+static void addFromRing(float* destination, const float* ring, int mask, int64 position, int numSamples)
+{
+	const int start = (int)(position & mask);
+	const int numBeforeWrap = jmin(numSamples, mask + 1 - start);
+
+	FloatVectorOperations::add(destination, ring + start, numBeforeWrap);
+
+	if (numBeforeWrap < numSamples)
+		FloatVectorOperations::add(destination + numBeforeWrap, ring, numSamples - numBeforeWrap);
+}
+
+}
+
+PartitionedConvolutionEngine::ImpulseSpectra::ImpulseSpectra(const float* const* impulseData, int numImpulseChannels, int newImpulseLength, int maxBlockSize) :
+	blockSize(jlimit<int>(MinBlockSize, MaxBlockSize, nextPowerOfTwo(maxBlockSize))),
+	impulseLength(jmax<int>(0, newImpulseLength)),
+	numChannels(jlimit<int>(1, MaxNumChannels, numImpulseChannels))
+{
+	if (impulseData == nullptr)
+		impulseLength = 0;
+
+	if (impulseLength == 0)
+		return;
+
+	IppFFT headFFT(IppFFT::DataType::RealFloat, (int)std::log2(2 * blockSize) + 1);
+
+	const int headLength = jmin<int>(impulseLength, NumHeadPartitions * blockSize);
+
+	head.partitionSize = blockSize;
+	head.offset = 0;
+	head.numPartitions = (headLength + blockSize - 1) / blockSize;
+
+	for (int i = 0; i < numChannels; i++)
+	{
+		head.spectra[i].calloc(2 * blockSize * head.numPartitions);
+		createSpectra(headFFT, head.spectra[i], impulseData[i], impulseLength, 0, blockSize, head.numPartitions);
+	}
+
+	memoryUsage += sizeof(float) * 2 * blockSize * head.numPartitions * numChannels;
+
+	if (headLength == impulseLength)
+		return;
+
+	IppFFT tailFFT(IppFFT::DataType::RealFloat, (int)std::log2(2 * MaxPartitionSize) + 1);
+
+	// Every tail stage starts at twice its partition size, so there is one block period left for the background thread.
+
+	int offset = NumHeadPartitions * blockSize;
+	int partitionSize = 4 * blockSize;
+
+	while (offset < impulseLength)
+	{
+		partitionSize = jmin<int>(partitionSize, MaxPartitionSize);
+
+		jassert(offset >= 2 * partitionSize);
+
+		const int stageEnd = partitionSize < MaxPartitionSize ? jmin<int>(impulseLength, 8 * partitionSize) : impulseLength;
+
+		auto stage = new Stage();
+
+		stage->partitionSize = partitionSize;
+		stage->offset = offset;
+		stage->numPartitions = (stageEnd - offset + partitionSize - 1) / partitionSize;
+
+		for (int i = 0; i < numChannels; i++)
+		{
+			stage->spectra[i].calloc(2 * partitionSize * stage->numPartitions);
+			createSpectra(tailFFT, stage->spectra[i], impulseData[i], impulseLength, offset, partitionSize, stage->numPartitions);
+		}
+
+		memoryUsage += sizeof(float) * 2 * partitionSize * stage->numPartitions * numChannels;
+
+		stages.add(stage);
+
+		offset += stage->numPartitions * partitionSize;
+		partitionSize *= 4;
+	}
+}
+
+PartitionedConvolutionEngine::TailStage::TailStage(const ImpulseSpectra& spectra, int stageIndex, int numChannels) :
+	partitionSize(spectra.stages[stageIndex]->partitionSize),
+	offset(spectra.stages[stageIndex]->offset),
+	numPartitions(spectra.stages[stageIndex]->numPartitions),
+	requestedBlocks(0),
+	claimedBlocks(0),
+	completedBlocks(0),
+	fallbackActive(false)
+{
+	// The output of a block is written up to offset + partitionSize samples ahead of the read position
+	const int ringSize = nextPowerOfTwo(offset + partitionSize);
+
+	outputRingMask = ringSize - 1;
+
+	for (int i = 0; i < numChannels; i++)
+	{
+		irSpectra[i] = spectra.getStageSpectra(stageIndex, i);
+		frequencyDelayLine[i].calloc(2 * partitionSize * numPartitions);
+		outputRing[i].calloc(ringSize);
+		fallbackOutput[i].calloc(partitionSize);
+	}
+}
+
+PartitionedConvolutionEngine::PartitionedConvolutionEngine() :
+	resetPending(false)
+{
+	
+}
+
+PartitionedConvolutionEngine::~PartitionedConvolutionEngine()
+{
+	if (backgroundThread != nullptr)
+		(*backgroundThread)->removeEngine(this);
+}
+
+void PartitionedConvolutionEngine::updateBackgroundThread()
+{
+	if (tailStages.isEmpty())
+	{
+		if (backgroundThread != nullptr)
+		{
+			(*backgroundThread)->removeEngine(this);
+			backgroundThread = nullptr;
+		}
+	}
+	else if (backgroundThread == nullptr)
+	{
+		backgroundThread = new SharedResourcePointer<BackgroundThread>();
+		(*backgroundThread)->addEngine(this);
+	}
+}
+
+void PartitionedConvolutionEngine::setImpulse(const float* const* impulseData, int numChannels, int newImpulseLength, int maxBlockSize)
+{
+	if (impulseData == nullptr || newImpulseLength <= 0)
+		setImpulse(nullptr);
+	else
+		setImpulse(new ImpulseSpectra(impulseData, numChannels, newImpulseLength, maxBlockSize));
+}
+
+void PartitionedConvolutionEngine::setImpulse(ImpulseSpectra* newSpectra)
+{
+	ImpulseSpectra::Ptr oldSpectra;
+
+	{
+		SpinLock::ScopedLockType sl(tailLock);
+		setSpectraInternal(newSpectra, oldSpectra);
+	}
+
+	// The thread is started outside the lock (and only if this impulse response needs it).
+	updateBackgroundThread();
+}
+
+void PartitionedConvolutionEngine::setSpectraInternal(ImpulseSpectra* newSpectra, ImpulseSpectra::Ptr& oldSpectra)
+{
+	tailStages.clear();
+
+	// The old spectra might be deleted here, so make sure that this happens after the stages are gone.
+	oldSpectra = spectra;
+	spectra = newSpectra;
+
+	if (spectra == nullptr || spectra->getImpulseLength() == 0)
+	{
+		spectra = nullptr;
+		impulseLength = 0;
+		return;
+	}
+
+	impulseLength = spectra->getImpulseLength();
+	blockSize = spectra->getBlockSize();
+	numHeadPartitions = spectra->head.numPartitions;
+
+	const int headFFTSize = 2 * blockSize;
+
+	headFFT = new IppFFT(IppFFT::DataType::RealFloat, (int)std::log2(headFFTSize) + 1);
+
+	// The FFT objects are not thread safe, so both threads need their own
+	for (auto w : { &backgroundWorkspace, &audioWorkspace })
+	{
+		if (!spectra->stages.isEmpty() && w->fft == nullptr)
+			w->fft = new IppFFT(IppFFT::DataType::RealFloat, (int)std::log2(2 * MaxPartitionSize) + 1);
+
+		w->scratch.calloc(2 * MaxPartitionSize);
+		w->spectrum.calloc(2 * MaxPartitionSize);
+	}
+
+	headScratch.calloc(headFFTSize);
+
+	for (int i = 0; i < MaxNumChannels; i++)
+	{
+		headSpectra[i] = spectra->getHeadSpectra(i);
+		headFdl[i].calloc(headFFTSize * numHeadPartitions);
+		headAccumulator[i].calloc(headFFTSize);
+		headInput[i].calloc(headFFTSize);
+	}
+
+	for (int i = 0; i < spectra->stages.size(); i++)
+		tailStages.add(new TailStage(*spectra, i, MaxNumChannels));
+
+	// A block might be calculated as late as when its output is needed, so the history must keep the input of the
+	// block (and the block before for a fallback block) until offset samples after the block.
+	int historyLength = 3 * blockSize;
+
+	for (auto stage : tailStages)
+		historyLength = jmax<int>(historyLength, stage->offset + 3 * stage->partitionSize);
+
+	const int historySize = nextPowerOfTwo(historyLength + blockSize);
+
+	historyMask = historySize - 1;
+
+	for (int i = 0; i < MaxNumChannels; i++)
+		history[i].calloc(historySize);
+
+	clearBuffers();
+}
+
+void PartitionedConvolutionEngine::reset()
+{
+	resetPending.store(true);
+
+	performPendingReset();
+}
+
+void PartitionedConvolutionEngine::performPendingReset()
+{
+	// The background thread does not start another block while a reset is pending, so the lock is free after its current block.
+	GenericScopedTryLock<SpinLock> sl(tailLock);
+
+	if (sl.isLocked())
+	{
+		clearBuffers();
+		resetPending.store(false);
+	}
+}
+
+void PartitionedConvolutionEngine::clearBuffers()
+{
+	if (!isActive())
+		return;
+
+	const int headFFTSize = 2 * blockSize;
+
+	sampleCounter = 0;
+	headFill = 0;
+	headFdlPosition = 0;
+
+	for (int i = 0; i < MaxNumChannels; i++)
+	{
+		FloatVectorOperations::clear(headFdl[i], headFFTSize * numHeadPartitions);
+		FloatVectorOperations::clear(headAccumulator[i], headFFTSize);
+		FloatVectorOperations::clear(headInput[i], headFFTSize);
+		FloatVectorOperations::clear(history[i], historyMask + 1);
+	}
+
+	for (auto stage : tailStages)
+	{
+		for (int i = 0; i < MaxNumChannels; i++)
+		{
+			FloatVectorOperations::clear(stage->frequencyDelayLine[i], 2 * stage->partitionSize * stage->numPartitions);
+			FloatVectorOperations::clear(stage->outputRing[i], stage->outputRingMask + 1);
+			FloatVectorOperations::clear(stage->fallbackOutput[i], stage->partitionSize);
+		}
+
+		stage->fallbackBlock = -1;
+		stage->requestedBlocks.store(0);
+		stage->claimedBlocks.store(0);
+		stage->completedBlocks.store(0);
+	}
+}
+
+void PartitionedConvolutionEngine::processBlock(float** data, int numChannels, int numSamples)
+{
+	numChannels = jmin<int>(numChannels, MaxNumChannels);
+
+	if (resetPending.load())
+		performPendingReset();
+
+	if (!isActive())
+	{
+		for (int i = 0; i < numChannels; i++)
+			FloatVectorOperations::clear(data[i], numSamples);
+
+		return;
+	}
+
+	int offset = 0;
+
+	while (numSamples > 0)
+	{
+		const int numThisTime = jmin<int>(numSamples, blockSize - headFill);
+
+		float* chunk[MaxNumChannels];
+
+		for (int i = 0; i < numChannels; i++)
+			chunk[i] = data[i] + offset;
+
+		processChunk(chunk, numChannels, numThisTime);
+
+		offset += numThisTime;
+		numSamples -= numThisTime;
+	}
+}
+
+void PartitionedConvolutionEngine::processChunk(float** data, int numChannels, int numSamples)
+{
+	using namespace PartitionedConvolutionHelpers;
+
+	const int fftSize = 2 * blockSize;
+
+	// A chunk never crosses a partition boundary of the tail stages, so one check per stage is enough.
+	uint32 fallbackStages = 0;
+
+	jassert(tailStages.size() <= 32);
+
+	for (int s = 0; s < tailStages.size(); s++)
+	{
+		if (prepareTailOutput(*tailStages.getUnchecked(s)))
+			fallbackStages |= (1u << s);
+	}
+
+	for (int i = 0; i < numChannels; i++)
+	{
+		float* input = headInput[i];
+
+		FloatVectorOperations::copy(input + blockSize + headFill, data[i], numSamples);
+
+		if (!tailStages.isEmpty())
+			writeToRing(history[i], historyMask, sampleCounter, data[i], numSamples);
+
+		// The spectrum of the (partially filled) current block. When the block is full, this is the entry for the delay line.
+		float* currentSpectrum = headFdl[i] + headFdlPosition * fftSize;
+
+		FloatVectorOperations::copy(currentSpectrum, input, fftSize);
+		headFFT->realFFTInplace(currentSpectrum, fftSize);
+
+		FloatVectorOperations::copy(headScratch, headAccumulator[i], fftSize);
+		multiplyAddSpectrum(headScratch, currentSpectrum, headSpectra[i], fftSize);
+		headFFT->realFFTInverseInplace(headScratch, fftSize);
+
+		FloatVectorOperations::copy(data[i], headScratch + blockSize + headFill, numSamples);
+
+		for (int s = 0; s < tailStages.size(); s++)
+		{
+			auto stage = tailStages.getUnchecked(s);
+
+			if ((fallbackStages & (1u << s)) != 0)
+			{
+				const int positionInBlock = (int)((sampleCounter - stage->offset) % stage->partitionSize);
+				FloatVectorOperations::add(data[i], stage->fallbackOutput[i] + positionInBlock, numSamples);
+			}
+			else
+			{
+				addFromRing(data[i], stage->outputRing[i], stage->outputRingMask, sampleCounter, numSamples);
+			}
+		}
+	}
+
+	headFill += numSamples;
+	sampleCounter += numSamples;
+
+	if (headFill == blockSize)
+	{
+		advanceHeadBlock(numChannels);
+		triggerTailStages();
+	}
+}
+
+void PartitionedConvolutionEngine::advanceHeadBlock(int numChannels)
+{
+	const int fftSize = 2 * blockSize;
+
+	headFill = 0;
+	headFdlPosition = (headFdlPosition + 1) % numHeadPartitions;
+
+	for (int i = 0; i < numChannels; i++)
+	{
+		float* input = headInput[i];
+
+		FloatVectorOperations::copy(input, input + blockSize, blockSize);
+		FloatVectorOperations::clear(input + blockSize, blockSize);
+
+		// Sum up the contribution of all previous blocks once, so the audio callback only needs the first partition.
+		float* accumulator = headAccumulator[i];
+
+		FloatVectorOperations::clear(accumulator, fftSize);
+
+		for (int k = 1; k < numHeadPartitions; k++)
+		{
+			const int index = (headFdlPosition - k + numHeadPartitions) % numHeadPartitions;
+			multiplyAddSpectrum(accumulator, headFdl[i] + index * fftSize, headSpectra[i] + k * fftSize, fftSize);
+		}
+	}
+}
+
+void PartitionedConvolutionEngine::triggerTailStages()
+{
+	bool needsNotify = false;
+
+	for (auto stage : tailStages)
+	{
+		if (sampleCounter % stage->partitionSize != 0)
+			continue;
+
+		stage->requestedBlocks.store(sampleCounter / stage->partitionSize, std::memory_order_release);
+		needsNotify = true;
+	}
+
+	if (needsNotify && backgroundThread != nullptr)
+		(*backgroundThread)->notify();
+}
+
+bool PartitionedConvolutionEngine::claimTailBlock(TailStage& stage, int64 blockIndex)
+{
+	// claimedBlocks is either completedBlocks or one more if a thread is calculating the next block
+	int64 expected = blockIndex;
+	return stage.claimedBlocks.compare_exchange_strong(expected, blockIndex + 1);
+}
+
+bool PartitionedConvolutionEngine::prepareTailOutput(TailStage& stage)
+{
+	// Nothing was written to the output ring yet
+	if (sampleCounter < stage.offset)
+		return false;
+
+	const int64 neededBlock = (sampleCounter - stage.offset) / stage.partitionSize;
+
+	if (stage.fallbackBlock == neededBlock)
+		return true;
+
+	for (;;)
+	{
+		const int64 completed = stage.completedBlocks.load(std::memory_order_acquire);
+
+		if (completed > neededBlock)
+			return false;
+
+		// The background thread didn't start the block yet, so we calculate it here
+		if (!claimTailBlock(stage, completed))
+			break;
+
+		calculateTailBlock(stage, completed, audioWorkspace);
+	}
+
+	// The background thread is calculating the block right now. Instead of waiting, we calculate the output 
+	// into the fallback buffer. The flag keeps the background thread from starting the next block, which 
+	// would overwrite a delay line entry that we need.
+	stage.fallbackActive.store(true);
+
+	const int64 completed = stage.completedBlocks.load();
+	const bool usesFallback = completed <= neededBlock;
+
+	if (usesFallback)
+		calculateFallbackBlock(stage, neededBlock, completed);
+
+	stage.fallbackActive.store(false);
+
+	return usesFallback;
+}
+
+void PartitionedConvolutionEngine::calculateTailBlock(TailStage& stage, int64 blockIndex, TailWorkspace& workspace)
+{
+	using namespace PartitionedConvolutionHelpers;
+
+	const int partitionSize = stage.partitionSize;
+	const int fftSize = 2 * partitionSize;
+	const int numPartitions = stage.numPartitions;
+	const int fdlPosition = (int)(blockIndex % numPartitions);
+
+	const int64 blockEnd = (blockIndex + 1) * partitionSize;
+
+	for (int i = 0; i < MaxNumChannels; i++)
+	{
+		float* currentSpectrum = stage.frequencyDelayLine[i] + fdlPosition * fftSize;
+
+		readFromRing(currentSpectrum, history[i], historyMask, blockEnd - fftSize, fftSize);
+		workspace.fft->realFFTInplace(currentSpectrum, fftSize);
+
+		FloatVectorOperations::clear(workspace.scratch, fftSize);
+
+		for (int k = 0; k < numPartitions; k++)
+		{
+			const int index = (fdlPosition - k + numPartitions) % numPartitions;
+			multiplyAddSpectrum(workspace.scratch, stage.frequencyDelayLine[i] + index * fftSize, stage.irSpectra[i] + k * fftSize, fftSize);
+		}
+
+		workspace.fft->realFFTInverseInplace(workspace.scratch, fftSize);
+
+		// The block [blockEnd - P, blockEnd) convolved with the partitions starting at offset
+		writeToRing(stage.outputRing[i], stage.outputRingMask, blockEnd - partitionSize + stage.offset, workspace.scratch + partitionSize, partitionSize);
+	}
+
+	stage.completedBlocks.store(blockIndex + 1, std::memory_order_release);
+}
+
+void PartitionedConvolutionEngine::calculateFallbackBlock(TailStage& stage, int64 blockIndex, int64 firstMissingBlock)
+{
+	using namespace PartitionedConvolutionHelpers;
+
+	const int partitionSize = stage.partitionSize;
+	const int fftSize = 2 * partitionSize;
+	const int numPartitions = stage.numPartitions;
+	const int fdlPosition = (int)(blockIndex % numPartitions);
+
+	auto& w = audioWorkspace;
+
+	for (int i = 0; i < MaxNumChannels; i++)
+	{
+		FloatVectorOperations::clear(w.scratch, fftSize);
+
+		for (int k = 0; k < numPartitions && k <= blockIndex; k++)
+		{
+			const int64 inputBlock = blockIndex - k;
+			const float* inputSpectrum;
+
+			if (inputBlock >= firstMissingBlock)
+			{
+				readFromRing(w.spectrum, history[i], historyMask, (inputBlock + 1) * partitionSize - fftSize, fftSize);
+				w.fft->realFFTInplace(w.spectrum, fftSize);
+				inputSpectrum = w.spectrum;
+			}
+			else
+			{
+				inputSpectrum = stage.frequencyDelayLine[i] + ((fdlPosition - k + numPartitions) % numPartitions) * fftSize;
+			}
+
+			multiplyAddSpectrum(w.scratch, inputSpectrum, stage.irSpectra[i] + k * fftSize, fftSize);
+		}
+
+		w.fft->realFFTInverseInplace(w.scratch, fftSize);
+
+		FloatVectorOperations::copy(stage.fallbackOutput[i], w.scratch + partitionSize, partitionSize);
+	}
+
+	stage.fallbackBlock = blockIndex;
+}
+
+bool PartitionedConvolutionEngine::processPendingTailBlocks()
+{
+	SpinLock::ScopedLockType sl(tailLock);
+
+	// Don't start anything so that the audio thread gets the lock for the reset
+	if (resetPending.load())
+		return false;
+
+	// Only calculate the most urgent block (the stages are sorted by their partition size)
+	// so that the lock is released as soon as possible.
+	for (auto stage : tailStages)
+	{
+		const int64 nextBlock = stage->completedBlocks.load(std::memory_order_acquire);
+
+		if (nextBlock >= stage->requestedBlocks.load(std::memory_order_acquire) || !claimTailBlock(*stage, nextBlock))
+			continue;
+
+		if (stage->fallbackActive.load())
+		{
+			// The audio thread reads the delay line, so we try again later.
+			stage->claimedBlocks.store(nextBlock);
+			return true;
+		}
+
+		calculateTailBlock(*stage, nextBlock, backgroundWorkspace);
+		return true;
+	}
+
+	return false;
+}
+
+void PartitionedConvolutionEngine::multiplyAddSpectrum(float* output, const float* a, const float* b, int fftSize)
+{
+	// Perm format: the first two values are the (real) DC and Nyquist bins
+	output[0] += a[0] * b[0];
+	output[1] += a[1] * b[1];
+
+	output[2] += a[2] * b[2] - a[3] * b[3];
+	output[3] += a[2] * b[3] + a[3] * b[2];
+
+#if JUCE_USE_SSE_INTRINSICS
+
+	const __m128 sign = _mm_setr_ps(-1.0f, 1.0f, -1.0f, 1.0f);
+
+	for (int i = 4; i < fftSize; i += 4)
+	{
+		const __m128 va = _mm_loadu_ps(a + i);
+		const __m128 vb = _mm_loadu_ps(b + i);
+
+		const __m128 br = _mm_shuffle_ps(vb, vb, _MM_SHUFFLE(2, 2, 0, 0));
+		const __m128 bi = _mm_shuffle_ps(vb, vb, _MM_SHUFFLE(3, 3, 1, 1));
+		const __m128 as = _mm_shuffle_ps(va, va, _MM_SHUFFLE(2, 3, 0, 1));
+
+		const __m128 product = _mm_add_ps(_mm_mul_ps(va, br), _mm_mul_ps(_mm_mul_ps(as, bi), sign));
+
+		_mm_storeu_ps(output + i, _mm_add_ps(_mm_loadu_ps(output + i), product));
+	}
+
+#else
+
+	for (int i = 4; i < fftSize; i += 2)
+	{
+		const float re = a[i] * b[i] - a[i + 1] * b[i + 1];
+		const float im = a[i] * b[i + 1] + a[i + 1] * b[i];
+
+		output[i] += re;
+		output[i + 1] += im;
+	}
+
+#endif
+}
+
+void PartitionedConvolutionEngine::ImpulseSpectra::createSpectra(IppFFT& fft, float* spectra, const float* impulse, int length, int offset, int partitionSize, int numPartitions)
+{
+	const int fftSize = 2 * partitionSize;
+
+	// The FFT is not normalized, so the scaling of the roundtrip is applied to the impulse response
+	const float scale = 1.0f / (float)fftSize;
+
+	for (int k = 0; k < numPartitions; k++)
+	{
+		float* s = spectra + k * fftSize;
+
+		const int start = offset + k * partitionSize;
+		const int numToCopy = jlimit<int>(0, partitionSize, length - start);
+
+		FloatVectorOperations::clear(s, fftSize);
+		FloatVectorOperations::copyWithMultiply(s, impulse + start, scale, numToCopy);
+
+		fft.realFFTInplace(s, fftSize);
+	}
+}
+
+} // namespace hise
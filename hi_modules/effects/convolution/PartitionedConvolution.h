@@ -0,0 +1,267 @@
+/*  ===========================================================================
+*
+*   This file is part of HISE.
+*   Copyright 2016 Christoph Hart
+*
+*   HISE is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   HISE is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with HISE.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Commercial licenses for using HISE in an closed source project are
+*   available on request. Please visit the project's website to get more
+*   information about commercial licensing:
+*
+*   http://www.hise.audio/
+*
+*   HISE is based on the JUCE library,
+*   which must be separately licensed for closed source applications:
+*
+*   http://www.juce.com
+*
+*   ===========================================================================
+*/
+
+#ifndef PARTITIONEDCONVOLUTION_H_INCLUDED
+#define PARTITIONEDCONVOLUTION_H_INCLUDED
+
+namespace hise { using namespace juce;
+
+/** A non-uniform partitioned convolution engine that calculates the tail on a background thread.
+*
+*	The impulse response is split into a head with uniform partitions of the block size, which is calculated
+*	in the audio callback, and a few tail stages with partitions that grow by a factor of four up to MaxPartitionSize.
+*
+*	Every tail stage of the size P starts at an offset of at least 2 * P, so a block can be calculated by the background 
+*	thread during the next P samples without adding latency. Each block is claimed with an atomic counter by the thread 
+*	that calculates it, and its output is published with the completed block counter, so the audio thread reads the 
+*	output without a lock. If a block is not finished when its output is needed, the audio thread calculates it itself.
+*	If the background thread is calculating this block at that moment, the audio thread does not wait, but calculates 
+*	the output into a second buffer without changing the delay line.
+*
+*	All engines with tail stages share one background thread, so the amount of threads does not grow with the number of 
+*	instances (and if no engine needs it, the thread is not running).
+*/
+class PartitionedConvolutionEngine
+{
+public:
+
+	enum
+	{
+		MinBlockSize = 64,
+		MaxBlockSize = 1024,
+		NumHeadPartitions = 8,
+		MaxPartitionSize = 8192,
+		MaxNumChannels = 2
+	};
+
+	/** The partitioned spectra of an impulse response.
+	*
+	*	This data is never changed after its creation, so it can be shared between multiple engines 
+	*	(eg. by storing it in the AudioSampleBufferPool).
+	*/
+	class ImpulseSpectra : public ReferenceCountedObject
+	{
+	public:
+
+		typedef ReferenceCountedObjectPtr<ImpulseSpectra> Ptr;
+
+		/** Creates the partitions and calculates their spectra. This is an expensive operation. */
+		ImpulseSpectra(const float* const* impulseData, int numImpulseChannels, int impulseLength, int maxBlockSize);
+
+		int getBlockSize() const noexcept { return blockSize; }
+
+		int getImpulseLength() const noexcept { return impulseLength; }
+
+		/** Returns the amount of bytes allocated for the spectra. */
+		size_t getMemoryUsage() const noexcept { return memoryUsage; }
+
+	private:
+
+		friend class PartitionedConvolutionEngine;
+
+		struct Stage
+		{
+			int partitionSize;
+			int offset;
+			int numPartitions;
+
+			HeapBlock<float> spectra[MaxNumChannels];
+		};
+
+		const float* getHeadSpectra(int channel) const noexcept { return head.spectra[jmin(channel, numChannels - 1)]; }
+		const float* getStageSpectra(int stageIndex, int channel) const noexcept { return stages[stageIndex]->spectra[jmin(channel, numChannels - 1)]; }
+
+		static void createSpectra(IppFFT& fft, float* spectra, const float* impulse, int impulseLength, int offset, int partitionSize, int numPartitions);
+
+		int blockSize = 0;
+		int impulseLength = 0;
+		int numChannels = 0;
+		size_t memoryUsage = 0;
+
+		Stage head;
+		OwnedArray<Stage> stages;
+
+		JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ImpulseSpectra)
+	};
+
+	PartitionedConvolutionEngine();
+	~PartitionedConvolutionEngine();
+
+	/** Creates the partitions and their spectra for the given impulse response. 
+	*
+	*	This allocates and calculates the FFT of the whole impulse response, so you must not call it on the audio thread
+	*	(and you need to make sure that the audio thread does not call processBlock() at the same time).
+	*/
+	void setImpulse(const float* const* impulseData, int numImpulseChannels, int impulseLength, int maxBlockSize);
+
+	/** Uses the precalculated spectra. This is much faster than calculating the spectra, but it still allocates the buffers. */
+	void setImpulse(ImpulseSpectra* newSpectra);
+
+	/** Returns the spectra that are currently used (or nullptr if no impulse response is loaded). */
+	ImpulseSpectra* getImpulseSpectra() const noexcept { return spectra.get(); }
+
+	/** Clears all internal buffers. 
+	*
+	*	This can be called on the audio thread. If the background thread is calculating a block, the reset is 
+	*	performed at the beginning of the next processBlock() call.
+	*/
+	void reset();
+
+	/** Replaces the input signal with the convolved signal. There is no latency. */
+	void processBlock(float** data, int numChannels, int numSamples);
+
+	/** Returns the size of the head partitions. */
+	int getBlockSize() const noexcept { return blockSize; }
+
+	/** Returns true if an impulse response is loaded. */
+	bool isActive() const noexcept { return impulseLength > 0; }
+
+private:
+
+	class BackgroundThread;
+
+	/** A uniform partitioned convolution stage of the tail. */
+	struct TailStage
+	{
+		TailStage(const ImpulseSpectra& spectra, int stageIndex, int numChannels);
+
+		const int partitionSize;
+		const int offset;
+		const int numPartitions;
+
+		const float* irSpectra[MaxNumChannels];
+		HeapBlock<float> frequencyDelayLine[MaxNumChannels];
+		HeapBlock<float> outputRing[MaxNumChannels];
+
+		/** The output of a block that the audio thread calculated while the background thread was busy with it. */
+		HeapBlock<float> fallbackOutput[MaxNumChannels];
+
+		int outputRingMask = 0;
+
+		/** The index of the block in fallbackOutput (only used by the audio thread). */
+		int64 fallbackBlock = -1;
+
+		std::atomic<int64> requestedBlocks;
+		std::atomic<int64> claimedBlocks;
+		std::atomic<int64> completedBlocks;
+
+		/** Set while the audio thread reads the delay line for a fallback block, so the background thread doesn't start another block. */
+		std::atomic<bool> fallbackActive;
+
+		JUCE_DECLARE_NON_COPYABLE(TailStage)
+	};
+
+	/** The FFT and the buffers that are needed to calculate a tail block. The audio thread and the background thread have their own. */
+	struct TailWorkspace
+	{
+		ScopedPointer<IppFFT> fft;
+		HeapBlock<float> scratch;
+		HeapBlock<float> spectrum;
+	};
+
+	// ============================================================================================= internal methods
+
+	void setSpectraInternal(ImpulseSpectra* newSpectra, ImpulseSpectra::Ptr& oldSpectra);
+	void clearBuffers();
+	void processChunk(float** data, int numChannels, int numSamples);
+	void advanceHeadBlock(int numChannels);
+	void triggerTailStages();
+	void performPendingReset();
+
+	/** Claims the block for the calling thread. This only succeeds if it is the next block and no other thread has claimed it. */
+	static bool claimTailBlock(TailStage& stage, int64 blockIndex);
+
+	/** Calculates the block into the delay line and the output ring and publishes it. The block must be claimed by the calling thread. */
+	void calculateTailBlock(TailStage& stage, int64 blockIndex, TailWorkspace& workspace);
+
+	/** Calculates the output of the block into the fallback buffer without changing the delay line. 
+	*
+	*	The spectra of the blocks from firstMissingBlock on are calculated from the history, all older ones are read from the delay line.
+	*/
+	void calculateFallbackBlock(TailStage& stage, int64 blockIndex, int64 firstMissingBlock);
+
+	/** Makes sure that the output of the stage for the current position is available. 
+	*
+	*	If the background thread is late, the missing blocks are calculated on the audio thread. Returns true if
+	*	the output was calculated into the fallback buffer because the background thread is busy with the block.
+	*/
+	bool prepareTailOutput(TailStage& stage);
+
+	/** Attaches the engine to the shared background thread if it has tail stages (or detaches it if not). */
+	void updateBackgroundThread();
+
+	/** Called by the background thread. Returns true if there was anything to do. */
+	bool processPendingTailBlocks();
+
+	static void multiplyAddSpectrum(float* output, const float* a, const float* b, int fftSize);
+
+	// ============================================================================================= member variables
+
+	ImpulseSpectra::Ptr spectra;
+
+	int blockSize = 0;
+	int impulseLength = 0;
+
+	int64 sampleCounter = 0;
+	int headFill = 0;
+	int numHeadPartitions = 0;
+	int headFdlPosition = 0;
+
+	const float* headSpectra[MaxNumChannels];
+	HeapBlock<float> headFdl[MaxNumChannels];
+	HeapBlock<float> headAccumulator[MaxNumChannels];
+	HeapBlock<float> headInput[MaxNumChannels];
+	HeapBlock<float> headScratch;
+
+	HeapBlock<float> history[MaxNumChannels];
+	int historyMask = 0;
+
+	OwnedArray<TailStage> tailStages;
+
+	ScopedPointer<IppFFT> headFFT;
+
+	TailWorkspace backgroundWorkspace;
+	TailWorkspace audioWorkspace;
+
+	/** Held by the background thread while it calculates a block and by everything that changes the buffers. */
+	SpinLock tailLock;
+
+	std::atomic<bool> resetPending;
+
+	ScopedPointer<SharedResourcePointer<BackgroundThread>> backgroundThread;
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(PartitionedConvolutionEngine)
+};
+
+} // namespace hise
+
+#endif  // PARTITIONEDCONVOLUTION_H_INCLUDED
@@ -62,6 +62,11 @@ ConvolutionEditor::ConvolutionEditor (ProcessorEditor *p)
     resetButton->addListener (this);
     resetButton->setColour (ToggleButton::textColourId, Colours::white);
 
+    addAndMakeVisible (backgroundButton = new HiToggleButton ("new toggle button"));
+    backgroundButton->setButtonText (TRANS("Background Tail"));
+    backgroundButton->addListener (this);
+    backgroundButton->setColour (ToggleButton::textColourId, Colours::white);
+
     addAndMakeVisible (label = new Label ("new label",
                                           TRANS("convolution")));
     label->setFont (Font ("Arial", 26.00f, Font::bold));
@@ -94,6 +99,7 @@ ConvolutionEditor::ConvolutionEditor (ProcessorEditor *p)
 	wetMeter->setColour (VuMeter::outlineColour, Colour (0x45FFFFFF));
 
 	resetButton->setup(getProcessor(), ConvolutionEffect::ProcessInput, "Process Input");
+	backgroundButton->setup(getProcessor(), ConvolutionEffect::UseBackgroundThread, "Background Tail");
 
 	#if JUCE_DEBUG
 	startTimer(150);
@@ -129,6 +135,7 @@ ConvolutionEditor::~ConvolutionEditor()
     wetMeter = nullptr;
     impulseDisplay = nullptr;
     resetButton = nullptr;
+    backgroundButton = nullptr;
     label = nullptr;
 
 
@@ -162,7 +169,8 @@ void ConvolutionEditor::resized()
     dryMeter->setBounds ((getWidth() / 2) + 255, 123, 24, 48);
     wetMeter->setBounds ((getWidth() / 2) + 255, 67, 24, 48);
     impulseDisplay->setBounds ((getWidth() / 2) + -282, 24, 360, 184);
-    resetButton->setBounds ((getWidth() / 2) + 165 - (128 / 2), 175, 128, 32);
+    resetButton->setBounds ((getWidth() / 2) + 134 - (110 / 2), 175, 110, 32);
+    backgroundButton->setBounds ((getWidth() / 2) + 245 - (110 / 2), 175, 110, 32);
     label->setBounds ((getWidth() / 2) + 284 - 264, 15, 264, 40);
     //[UserResized] Add your own custom resize handling here..
     //[/UserResized]
@@ -201,6 +209,11 @@ void ConvolutionEditor::buttonClicked (Button* buttonThatWasClicked)
         //[UserButtonCode_resetButton] -- add your button handler code here..
         //[/UserButtonCode_resetButton]
     }
+    else if (buttonThatWasClicked == backgroundButton)
+    {
+        //[UserButtonCode_backgroundButton] -- add your button handler code here..
+        //[/UserButtonCode_backgroundButton]
+    }
 
     //[UserbuttonClicked_Post]
     //[/UserbuttonClicked_Post]
@@ -251,9 +264,13 @@ BEGIN_JUCER_METADATA
                     virtualName="" explicitFocusOrder="0" pos="-282C 24 360 184"
                     class="AudioSampleBufferComponent" params="getProcessor()"/>
   <TOGGLEBUTTON name="new toggle button" id="e6345feaa3cb5bea" memberName="resetButton"
-                virtualName="HiToggleButton" explicitFocusOrder="0" pos="165Cc 175 128 32"
+                virtualName="HiToggleButton" explicitFocusOrder="0" pos="134Cc 175 110 32"
                 posRelativeX="410a230ddaa2f2e8" txtcol="ffffffff" buttonText="Process Input"
                 connectedEdges="0" needsCallback="1" radioGroupId="0" state="0"/>
+  <TOGGLEBUTTON name="new toggle button" id="8c3e1b5f27d94a06" memberName="backgroundButton"
+                virtualName="HiToggleButton" explicitFocusOrder="0" pos="245Cc 175 110 32"
+                posRelativeX="410a230ddaa2f2e8" txtcol="ffffffff" buttonText="Background Tail"
+                connectedEdges="0" needsCallback="1" radioGroupId="0" state="0"/>
   <LABEL name="new label" id="bd1d8d6ad6d04bdc" memberName="label" virtualName=""
          explicitFocusOrder="0" pos="284Cr 15 264 40" textCol="52ffffff"
          edTextCol="ff000000" edBkgCol="0" labelText="convolution" editableSingleClick="0"
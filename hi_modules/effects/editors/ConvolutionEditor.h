@@ -74,6 +74,7 @@ public:
 		wetSlider->updateValue();
 
 		resetButton->updateValue();
+		backgroundButton->updateValue();
 
 		AudioSampleProcessor *sampleProcessor = dynamic_cast<AudioSampleProcessor*>(getProcessor());
 
@@ -118,6 +119,7 @@ private:
     ScopedPointer<VuMeter> wetMeter;
     ScopedPointer<AudioSampleBufferComponent> impulseDisplay;
     ScopedPointer<HiToggleButton> resetButton;
+    ScopedPointer<HiToggleButton> backgroundButton;
     ScopedPointer<Label> label;
 
 
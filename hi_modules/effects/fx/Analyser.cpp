@@ -257,8 +257,6 @@ void FFTDisplay::paint(Graphics& g)
 {
 	g.fillAll(getColourForAnalyser(AudioAnalyserComponent::bgColour));
 
-#if USE_IPP
-    
 	auto an = getAnalyser();
 
 	ScopedReadLock sl(an->getBufferLock());
@@ -403,14 +401,6 @@ void FFTDisplay::paint(Graphics& g)
 	
 	g.setColour(getColourForAnalyser(AudioAnalyserComponent::fillColour));
 	g.fillPath(lPath);
-    
-#else
-    
-    g.setColour(getColourForAnalyser(AudioAnalyserComponent::fillColour));
-    g.setFont(GLOBAL_BOLD_FONT());
-    g.drawText("You need IPP for the FFT Analyser", 0.0f, 0.0f, (float)getWidth(), (float)getHeight(), Justification::centred, false);
-    
-#endif
 }
 
 Component* AudioAnalyserComponent::Panel::createContentComponent(int index)
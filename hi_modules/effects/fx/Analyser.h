@@ -196,7 +196,7 @@ private:
 
 
 class AudioAnalyserComponent : public Component,
-	public Timer
+	public MeterRepaintDispatcher::Client
 {
 public:
 
@@ -210,13 +210,15 @@ public:
 
 	AudioAnalyserComponent(Processor* p) :
 		processor(p)
-	{
-		startTimer(30);
-	};
+	{};
 
 	Colour getColourForAnalyser(ColourId id);
 
-	void timerCallback() override { repaint(); }
+	void refreshMeter() override 
+	{ 
+		if (isShowing())
+			repaint(); 
+	}
 
 	class Panel : public PanelWithProcessorConnection
 	{
@@ -257,21 +259,15 @@ class FFTDisplay : public AudioAnalyserComponent
 public:
 
 	FFTDisplay(Processor* p) :
-#if USE_IPP
         AudioAnalyserComponent(p),
 		fftObject(IppFFT::DataType::RealFloat)
-#else
-       AudioAnalyserComponent(p)
-#endif
 	{};
 
 	void paint(Graphics& g) override;
 
 private:
 
-#if USE_IPP
 	IppFFT fftObject;
-#endif
 
 	Path lPath;
 	Path rPath;
@@ -0,0 +1,280 @@
+/*  ===========================================================================
+*
+*   This file is part of HISE.
+*   Copyright 2016 Christoph Hart
+*
+*   HISE is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   HISE is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with HISE.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Commercial licenses for using HISE in an closed source project are
+*   available on request. Please visit the project's website to get more
+*   information about commercial licensing:
+*
+*   http://www.hise.audio/
+*
+*   HISE is based on the JUCE library,
+*   which must be separately licensed for closed source applications:
+*
+*   http://www.juce.com
+*
+*   ===========================================================================
+*/
+
+#if JUCE_USE_SSE_INTRINSICS
+#include <emmintrin.h>
+#endif
+
+namespace hise { using namespace juce;
+
+BiquadCascade::BiquadCascade()
+{
+	setNumBands(0);
+}
+
+void BiquadCascade::setNumBands(int newNumBands)
+{
+	const int newNumPaddedBands = jmax<int>(4, (newNumBands + 3) & ~3);
+	const int numToKeep = jmin<int>(numBands, newNumBands);
+
+	HeapBlock<float> newCurrent, newTarget, newStates[MaxNumChannels];
+
+	newCurrent.calloc(NumCoefficients * newNumPaddedBands);
+	newTarget.calloc(NumCoefficients * newNumPaddedBands);
+
+	// Every new band is initialised to pass the signal unchanged
+	FloatVectorOperations::fill(newCurrent, 1.0f, newNumPaddedBands);
+	FloatVectorOperations::fill(newTarget, 1.0f, newNumPaddedBands);
+
+	for (int c = 0; c < NumCoefficients; c++)
+	{
+		if (numToKeep > 0)
+		{
+			FloatVectorOperations::copy(newCurrent + c * newNumPaddedBands, currentCoefficients + c * numPaddedBands, numToKeep);
+			FloatVectorOperations::copy(newTarget + c * newNumPaddedBands, targetCoefficients + c * numPaddedBands, numToKeep);
+		}
+	}
+
+	for (int i = 0; i < MaxNumChannels; i++)
+	{
+		newStates[i].calloc(2 * newNumPaddedBands);
+
+		if (numToKeep > 0)
+		{
+			FloatVectorOperations::copy(newStates[i], states[i], numToKeep);
+			FloatVectorOperations::copy(newStates[i] + newNumPaddedBands, states[i] + numPaddedBands, numToKeep);
+		}
+
+		states[i].swapWith(newStates[i]);
+	}
+
+	currentCoefficients.swapWith(newCurrent);
+	targetCoefficients.swapWith(newTarget);
+
+	rampCoefficients.calloc(NumCoefficients * newNumPaddedBands);
+	deltaCoefficients.calloc(NumCoefficients * newNumPaddedBands);
+	lastOutput.calloc(newNumPaddedBands);
+
+	numBands = newNumBands;
+	numPaddedBands = newNumPaddedBands;
+}
+
+void BiquadCascade::setCoefficients(int bandIndex, const IIRCoefficients& newCoefficients)
+{
+	jassert(isPositiveAndBelow(bandIndex, numBands));
+
+	for (int c = 0; c < NumCoefficients; c++)
+		targetCoefficients[c * numPaddedBands + bandIndex] = newCoefficients.coefficients[c];
+
+	coefficientsChanged = true;
+}
+
+void BiquadCascade::setBypassed(int bandIndex)
+{
+	jassert(isPositiveAndBelow(bandIndex, numBands));
+
+	for (int c = 0; c < NumCoefficients; c++)
+		targetCoefficients[c * numPaddedBands + bandIndex] = c == B0 ? 1.0f : 0.0f;
+
+	coefficientsChanged = true;
+}
+
+void BiquadCascade::reset()
+{
+	for (int i = 0; i < MaxNumChannels; i++)
+		FloatVectorOperations::clear(states[i], 2 * numPaddedBands);
+
+	FloatVectorOperations::copy(currentCoefficients, targetCoefficients, NumCoefficients * numPaddedBands);
+	coefficientsChanged = false;
+}
+
+void BiquadCascade::processBlock(float** data, int numChannels, int numSamples)
+{
+	if (numBands == 0 || numSamples == 0)
+		return;
+
+	numChannels = jmin<int>(numChannels, MaxNumChannels);
+
+	const int numValues = NumCoefficients * numPaddedBands;
+	const bool interpolate = coefficientsChanged;
+
+	if (interpolate)
+	{
+		FloatVectorOperations::copy(deltaCoefficients, targetCoefficients, numValues);
+		FloatVectorOperations::subtract(deltaCoefficients, currentCoefficients, numValues);
+		FloatVectorOperations::multiply(deltaCoefficients, 1.0f / (float)numSamples, numValues);
+	}
+
+	for (int i = 0; i < numChannels; i++)
+	{
+		if (interpolate)
+		{
+			FloatVectorOperations::copy(rampCoefficients, currentCoefficients, numValues);
+
+			// Band k processes its first sample in step k, so its ramp is shifted by k steps. 
+			for (int c = 0; c < NumCoefficients; c++)
+			{
+				for (int k = 0; k < numPaddedBands; k++)
+					rampCoefficients[c * numPaddedBands + k] += (float)(1 - k) * deltaCoefficients[c * numPaddedBands + k];
+			}
+
+			workingCoefficients = rampCoefficients;
+		}
+		else
+		{
+			workingCoefficients = currentCoefficients;
+		}
+
+		processChannel(data[i], states[i], states[i] + numPaddedBands, interpolate ? deltaCoefficients.getData() : nullptr, numSamples);
+	}
+
+	if (interpolate)
+	{
+		FloatVectorOperations::copy(currentCoefficients, targetCoefficients, numValues);
+		coefficientsChanged = false;
+	}
+}
+
+void BiquadCascade::processChannel(float* data, float* z1, float* z2, const float* delta, int numSamples)
+{
+	const int lastBand = numPaddedBands - 1;
+	const int numSteps = numSamples + lastBand;
+	const int numValues = NumCoefficients * numPaddedBands;
+
+	for (int step = 0; step < numSteps; step++)
+	{
+		if (delta != nullptr && step >= numSamples - 1)
+		{
+			// This band processes its last sample, so it uses the exact target instead of the accumulated ramp
+			const int k = step - (numSamples - 1);
+
+			for (int c = 0; c < NumCoefficients; c++)
+				workingCoefficients[c * numPaddedBands + k] = targetCoefficients[c * numPaddedBands + k];
+		}
+
+		if (step >= lastBand && step < numSamples)
+			processStep(data, z1, z2, step);
+		else
+			processEdgeStep(data, z1, z2, step, numSamples);
+
+		if (delta != nullptr)
+			FloatVectorOperations::add(workingCoefficients, delta, numValues);
+	}
+}
+
+void BiquadCascade::processEdgeStep(float* data, float* z1, float* z2, int step, int numSamples)
+{
+	const float* b0 = workingCoefficients + B0 * numPaddedBands;
+	const float* b1 = workingCoefficients + B1 * numPaddedBands;
+	const float* b2 = workingCoefficients + B2 * numPaddedBands;
+	const float* a1 = workingCoefficients + A1 * numPaddedBands;
+	const float* a2 = workingCoefficients + A2 * numPaddedBands;
+
+	const int lastBand = numPaddedBands - 1;
+
+	// Go backwards so that the output of the previous band is still the one from the last step
+	for (int k = lastBand; k >= 0; k--)
+	{
+		const int samplePosition = step - k;
+
+		if (samplePosition < 0 || samplePosition >= numSamples)
+			continue;
+
+		const float input = k == 0 ? data[samplePosition] : lastOutput[k - 1];
+		const float output = b0[k] * input + z1[k];
+
+		z1[k] = b1[k] * input - a1[k] * output + z2[k];
+		z2[k] = b2[k] * input - a2[k] * output;
+
+		lastOutput[k] = output;
+
+		if (k == lastBand)
+			data[samplePosition] = output;
+	}
+}
+
+void BiquadCascade::processStep(float* data, float* z1, float* z2, int step)
+{
+	const int lastBand = numPaddedBands - 1;
+
+#if JUCE_USE_SSE_INTRINSICS
+
+	for (int offset = numPaddedBands - 4; offset >= 0; offset -= 4)
+	{
+		const float firstInput = offset == 0 ? data[step] : lastOutput[offset - 1];
+
+		// Shift the outputs of the last step one lane up and insert the input of the first band of this group
+		__m128 input = _mm_loadu_ps(lastOutput + offset);
+		input = _mm_castsi128_ps(_mm_slli_si128(_mm_castps_si128(input), 4));
+		input = _mm_move_ss(input, _mm_set_ss(firstInput));
+
+		const __m128 b0 = _mm_loadu_ps(workingCoefficients + B0 * numPaddedBands + offset);
+		const __m128 b1 = _mm_loadu_ps(workingCoefficients + B1 * numPaddedBands + offset);
+		const __m128 b2 = _mm_loadu_ps(workingCoefficients + B2 * numPaddedBands + offset);
+		const __m128 a1 = _mm_loadu_ps(workingCoefficients + A1 * numPaddedBands + offset);
+		const __m128 a2 = _mm_loadu_ps(workingCoefficients + A2 * numPaddedBands + offset);
+
+		const __m128 s1 = _mm_loadu_ps(z1 + offset);
+		const __m128 s2 = _mm_loadu_ps(z2 + offset);
+
+		const __m128 output = _mm_add_ps(_mm_mul_ps(b0, input), s1);
+
+		_mm_storeu_ps(z1 + offset, _mm_add_ps(_mm_sub_ps(_mm_mul_ps(b1, input), _mm_mul_ps(a1, output)), s2));
+		_mm_storeu_ps(z2 + offset, _mm_sub_ps(_mm_mul_ps(b2, input), _mm_mul_ps(a2, output)));
+		_mm_storeu_ps(lastOutput + offset, output);
+	}
+
+#else
+
+	const float* b0 = workingCoefficients + B0 * numPaddedBands;
+	const float* b1 = workingCoefficients + B1 * numPaddedBands;
+	const float* b2 = workingCoefficients + B2 * numPaddedBands;
+	const float* a1 = workingCoefficients + A1 * numPaddedBands;
+	const float* a2 = workingCoefficients + A2 * numPaddedBands;
+
+	for (int k = lastBand; k >= 0; k--)
+	{
+		const float input = k == 0 ? data[step] : lastOutput[k - 1];
+		const float output = b0[k] * input + z1[k];
+
+		z1[k] = b1[k] * input - a1[k] * output + z2[k];
+		z2[k] = b2[k] * input - a2[k] * output;
+
+		lastOutput[k] = output;
+	}
+
+#endif
+
+	data[step - lastBand] = lastOutput[lastBand];
+}
+
+} // namespace hise
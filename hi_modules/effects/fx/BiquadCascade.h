@@ -0,0 +1,120 @@
+/*  ===========================================================================
+*
+*   This file is part of HISE.
+*   Copyright 2016 Christoph Hart
+*
+*   HISE is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   HISE is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with HISE.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Commercial licenses for using HISE in an closed source project are
+*   available on request. Please visit the project's website to get more
+*   information about commercial licensing:
+*
+*   http://www.hise.audio/
+*
+*   HISE is based on the JUCE library,
+*   which must be separately licensed for closed source applications:
+*
+*   http://www.juce.com
+*
+*   ===========================================================================
+*/
+
+#ifndef BIQUADCASCADE_H_INCLUDED
+#define BIQUADCASCADE_H_INCLUDED
+
+namespace hise { using namespace juce;
+
+/** A cascade of biquad filters that processes all bands in one pass over the buffer.
+*
+*	The bands are packed into groups of four, so one SSE register holds the state of four bands. Because every band
+*	needs the output of the previous band, the bands are skewed by one sample (while the first band processes sample n,
+*	the second band processes sample n - 1 and so on), which makes the four lanes independent. The first and last
+*	samples of each block are processed lane by lane, so the cascade doesn't add latency.
+*
+*	If the coefficients of a band change, the cascade interpolates linearly to the new coefficients over the next block.
+*	The ramp of each band follows its skew, so the last sample of the block is processed with the exact target coefficients.
+*/
+class BiquadCascade
+{
+public:
+
+	enum
+	{
+		MaxNumChannels = 2
+	};
+
+	BiquadCascade();
+
+	/** Changes the number of bands. The coefficients and states of the existing bands are kept. This allocates, so don't call it on the audio thread. */
+	void setNumBands(int newNumBands);
+
+	int getNumBands() const noexcept { return numBands; }
+
+	/** Sets the coefficients of the given band. */
+	void setCoefficients(int bandIndex, const IIRCoefficients& newCoefficients);
+
+	/** Lets the band pass the signal unchanged. */
+	void setBypassed(int bandIndex);
+
+	/** Clears the state of all bands and skips any pending coefficient interpolation. */
+	void reset();
+
+	/** Processes the data in place. */
+	void processBlock(float** data, int numChannels, int numSamples);
+
+private:
+
+	enum
+	{
+		B0 = 0,
+		B1,
+		B2,
+		A1,
+		A2,
+		NumCoefficients
+	};
+
+	void processChannel(float* data, float* z1, float* z2, const float* delta, int numSamples);
+
+	/** Processes one step only for the bands that have a valid sample at this position. */
+	void processEdgeStep(float* data, float* z1, float* z2, int step, int numSamples);
+
+	/** Processes one step for all bands. */
+	void processStep(float* data, float* z1, float* z2, int step);
+
+	int numBands = 0;
+	int numPaddedBands = 0;
+
+	bool coefficientsChanged = false;
+
+	// The coefficients with the layout [coefficient][band]
+	HeapBlock<float> currentCoefficients;
+	HeapBlock<float> targetCoefficients;
+	HeapBlock<float> rampCoefficients;
+	HeapBlock<float> deltaCoefficients;
+
+	// Points to either the current or the interpolated coefficients
+	float* workingCoefficients = nullptr;
+
+	// The state of each band with the layout [z1...][z2...]
+	HeapBlock<float> states[MaxNumChannels];
+
+	HeapBlock<float> lastOutput;
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(BiquadCascade)
+};
+
+} // namespace hise
+
+#endif  // BIQUADCASCADE_H_INCLUDED
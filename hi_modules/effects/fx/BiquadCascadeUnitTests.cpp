@@ -0,0 +1,237 @@
+/*  ===========================================================================
+*
+*   This file is part of HISE.
+*   Copyright 2016 Christoph Hart
+*
+*   HISE is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   HISE is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with HISE.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Commercial licenses for using HISE in an closed source project are
+*   available on request. Please visit the project's website to get more
+*   information about commercial licensing:
+*
+*   http://www.hise.audio/
+*
+*   HISE is based on the JUCE library,
+*   which must be separately licensed for closed source applications:
+*
+*   http://www.juce.com
+*
+*   ===========================================================================
+*/
+
+
+#include "AppConfig.h"
+
+#if HI_RUN_UNIT_TESTS
+
+#include  "JuceHeader.h"
+
+using namespace hise;
+
+class BiquadCascadeUnitTests : public UnitTest
+{
+public:
+
+	BiquadCascadeUnitTests() :
+		UnitTest("Testing the biquad cascade")
+	{
+
+	}
+
+	void runTest() override
+	{
+		testRampEndsAtTarget(4);
+		testRampEndsAtTarget(6);
+
+		testRampMatchesReference(4, 64);
+		testRampMatchesReference(6, 64);
+		testRampMatchesReference(6, 5);
+	}
+
+private:
+
+	/** A scalar cascade that ramps from the start to the target coefficients. Sample p uses start + (p + 1) / N * (target - start). */
+	struct Reference
+	{
+		Reference(int numBands_) :
+			numBands(numBands_)
+		{
+			z1.calloc(numBands);
+			z2.calloc(numBands);
+		}
+
+		void process(float* data, int numSamples, const Array<IIRCoefficients>& start, const Array<IIRCoefficients>& target)
+		{
+			for (int p = 0; p < numSamples; p++)
+			{
+				const float alpha = (float)(p + 1) / (float)numSamples;
+
+				float value = data[p];
+
+				for (int k = 0; k < numBands; k++)
+				{
+					float c[5];
+
+					for (int i = 0; i < 5; i++)
+						c[i] = start[k].coefficients[i] + alpha * (target[k].coefficients[i] - start[k].coefficients[i]);
+
+					const float output = c[0] * value + z1[k];
+
+					z1[k] = c[1] * value - c[3] * output + z2[k];
+					z2[k] = c[2] * value - c[4] * output;
+
+					value = output;
+				}
+
+				data[p] = value;
+			}
+		}
+
+		const int numBands;
+		HeapBlock<float> z1, z2;
+	};
+
+	Array<IIRCoefficients> createCoefficients(int numBands, double gainOffset)
+	{
+		Array<IIRCoefficients> coefficients;
+
+		for (int k = 0; k < numBands; k++)
+		{
+			const double frequency = 200.0 * std::pow(2.0, (double)k);
+			coefficients.add(IIRCoefficients::makePeakFilter(44100.0, frequency, 1.0, (float)Decibels::decibelsToGain(gainOffset + 2.0 * (double)k)));
+		}
+
+		return coefficients;
+	}
+
+	Array<IIRCoefficients> createPassthrough(int numBands)
+	{
+		Array<IIRCoefficients> coefficients;
+
+		for (int k = 0; k < numBands; k++)
+			coefficients.add(IIRCoefficients(1.0, 0.0, 0.0, 1.0, 0.0, 0.0));
+
+		return coefficients;
+	}
+
+	void fillRandom(float* data, int numSamples)
+	{
+		Random r = getRandom();
+
+		for (int i = 0; i < numSamples; i++)
+			data[i] = r.nextFloat() * 2.0f - 1.0f;
+	}
+
+	void testRampEndsAtTarget(int numBands)
+	{
+		beginTest("Testing that a ramp ends at the target coefficients with " + String(numBands) + " bands");
+
+		// With one sample per block, the ramp consists of its last sample only, so it must match a cascade
+		// that uses the target coefficients without interpolation exactly.
+		BiquadCascade ramped, fixed;
+
+		ramped.setNumBands(numBands);
+		fixed.setNumBands(numBands);
+
+		auto target = createCoefficients(numBands, 6.0);
+
+		for (int k = 0; k < numBands; k++)
+		{
+			ramped.setCoefficients(k, target[k]);
+			fixed.setCoefficients(k, target[k]);
+		}
+
+		fixed.reset();
+
+		const int numSamples = 256;
+
+		HeapBlock<float> a, b;
+		a.calloc(numSamples);
+		b.calloc(numSamples);
+
+		fillRandom(a, numSamples);
+		FloatVectorOperations::copy(b, a, numSamples);
+
+		for (int i = 0; i < numSamples; i++)
+		{
+			float* da = a + i;
+			float* db = b + i;
+
+			ramped.processBlock(&da, 1, 1);
+			fixed.processBlock(&db, 1, 1);
+		}
+
+		for (int i = 0; i < numSamples; i++)
+		{
+			if (a[i] != b[i])
+			{
+				expectEquals<float>(a[i], b[i], "Sample " + String(i));
+				return;
+			}
+		}
+	}
+
+	void testRampMatchesReference(int numBands, int numSamples)
+	{
+		beginTest("Testing the coefficient ramp with " + String(numBands) + " bands and " + String(numSamples) + " samples");
+
+		BiquadCascade cascade;
+		Reference reference(numBands);
+
+		cascade.setNumBands(numBands);
+
+		auto start = createCoefficients(numBands, -6.0);
+		auto target = createCoefficients(numBands, 6.0);
+
+		for (int k = 0; k < numBands; k++)
+			cascade.setCoefficients(k, start[k]);
+
+		cascade.reset();
+
+		HeapBlock<float> a, b;
+		a.calloc(numSamples);
+		b.calloc(numSamples);
+
+		// One block with the start coefficients, one ramp and one block with the target coefficients
+		for (int block = 0; block < 3; block++)
+		{
+			if (block == 1)
+			{
+				for (int k = 0; k < numBands; k++)
+					cascade.setCoefficients(k, target[k]);
+			}
+
+			fillRandom(a, numSamples);
+			FloatVectorOperations::copy(b, a, numSamples);
+
+			float* data = a;
+			cascade.processBlock(&data, 1, numSamples);
+
+			reference.process(b, numSamples, block == 2 ? target : start, block == 0 ? start : target);
+
+			for (int i = 0; i < numSamples; i++)
+			{
+				if (std::abs(a[i] - b[i]) > 1e-3f)
+				{
+					expectWithinAbsoluteError<float>(a[i], b[i], 1e-3f, "Block " + String(block) + ", sample " + String(i));
+					return;
+				}
+			}
+		}
+	}
+};
+
+static BiquadCascadeUnitTests biquadCascadeUnitTests;
+
+#endif
@@ -94,6 +94,7 @@ public:
 			SpinLock::ScopedLockType sl(processLock);
 
 			enabled = shouldBeEnabled;
+			changed = true;
 		}
 
 		bool isEnabled() const
@@ -147,20 +148,26 @@ public:
 
 			sampleRate = newSampleRate;
 			updateCoefficients();
-			leftFilter.reset();
-			rightFilter.reset();
 		}
 
-		void process(AudioSampleBuffer &b, int startSample, int numSamples)
+		/** Copies the coefficients to the given band of the cascade if they have changed since the last call. */
+		void updateCascade(BiquadCascade& cascade, int bandIndex)
 		{
-			if(!enabled) return;
+			if (!changed) return;
 
 			SpinLock::ScopedLockType sl(processLock);
 
-			leftFilter.processSamples(b.getWritePointer(0, startSample), numSamples);
-			rightFilter.processSamples(b.getWritePointer(1, startSample), numSamples);
+			if (enabled)
+				cascade.setCoefficients(bandIndex, currentCoefficients);
+			else
+				cascade.setBypassed(bandIndex);
+
+			changed = false;
 		}
 
+		/** Forces the next call to updateCascade() to copy the coefficients. */
+		void markAsChanged() { changed = true; }
+
 		IIRCoefficients getCoefficients() const
 		{
 			return currentCoefficients;
@@ -187,8 +194,7 @@ public:
                 case numFilterTypes: break;
 			}
 
-			leftFilter.setCoefficients(currentCoefficients);
-			rightFilter.setCoefficients(currentCoefficients);
+			changed = true;
 		};
 
 		IIRCoefficients currentCoefficients;
@@ -200,8 +206,7 @@ public:
 		bool enabled;
 		FilterType type;
 
-		IIRFilter leftFilter;
-		IIRFilter rightFilter;
+		std::atomic<bool> changed { true };
 	};
 
 	CurveEq(MainController *mc, const String &id):
@@ -229,11 +234,17 @@ public:
 
 	void applyEffect(AudioSampleBuffer &buffer, int startSample, int numSamples) override
 	{
+		jassert(cascade.getNumBands() == filterBands.size());
+
 		for(int i = 0; i < filterBands.size(); i++)
 		{
-			filterBands[i]->process(buffer, startSample, numSamples);
+			filterBands[i]->updateCascade(cascade, i);
 		}
 
+		float* channels[2] = { buffer.getWritePointer(0, startSample), buffer.getWritePointer(1, startSample) };
+
+		cascade.processBlock(channels, 2, numSamples);
+
 		if(fftBufferIndex < FFT_SIZE_FOR_EQ)
 		{
 			const int numSamplesToCopy = jmin<int>(numSamples, FFT_SIZE_FOR_EQ - fftBufferIndex);
@@ -277,6 +288,8 @@ public:
 
 		filterBands.add(f);
 
+		updateCascadeBands();
+
 		sendChangeMessage();
 	}
 
@@ -286,6 +299,8 @@ public:
 
 		filterBands.remove(filterIndex);
 
+		updateCascadeBands();
+
 		sendChangeMessage();
 	}
 
@@ -302,7 +317,10 @@ public:
 			for (int i = 0; i < filterBands.size(); i++)
 			{
 				filterBands[i]->setSampleRate(sampleRate);
+				filterBands[i]->updateCascade(cascade, i);
 			}
+
+			cascade.reset();
 		}
 	};
 
@@ -335,6 +353,8 @@ public:
 			filterBands.add(new StereoFilter());
 		}
 
+		updateCascadeBands();
+
 		for(int i = 0; i < numFilters * numBandParameters; i++)
 		{
 #if HI_USE_BACKWARD_COMPATIBILITY
@@ -391,6 +411,15 @@ private:
 
 	const CriticalSection& getLock() const { return getMainController()->getLock(); }
 
+	/** Resizes the cascade to the number of bands. The bands after a removed band will interpolate to their new position. */
+	void updateCascadeBands()
+	{
+		cascade.setNumBands(filterBands.size());
+
+		for (int i = 0; i < filterBands.size(); i++)
+			filterBands[i]->markAsChanged();
+	}
+
 	float fftData[FFT_SIZE_FOR_EQ];
 
 	double externalFftData[FFT_SIZE_FOR_EQ];
@@ -399,6 +428,8 @@ private:
 
 	OwnedArray<StereoFilter> filterBands;
 
+	BiquadCascade cascade;
+
 	double lastSampleRate = 0.0;
 
 };
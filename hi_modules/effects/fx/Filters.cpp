@@ -621,10 +621,15 @@ void StaticBiquad::updateCoefficients()
 	default:							jassertfalse; break;
 	}
 
-	for (int i = 0; i < numChannels; i++)
-	{
-		filters[i].setCoefficients(currentCoefficients);
-	}
+	Coefficients& c = coefficientSets[writeCoefficients];
+
+	c.b0 = currentCoefficients.coefficients[0];
+	c.b1 = currentCoefficients.coefficients[1];
+	c.b2 = currentCoefficients.coefficients[2];
+	c.a1 = currentCoefficients.coefficients[3];
+	c.a2 = currentCoefficients.coefficients[4];
+
+	writeCoefficients = sharedCoefficients.exchange(writeCoefficients | NewCoefficientsFlag, std::memory_order_acq_rel) & IndexMask;
 }
 
 } // namespace hise
@@ -81,9 +81,12 @@ public:
 
 	void setFreqAndQ(double newFrequency, double newQ)
 	{
-		frequency = newFrequency;
-		q = newQ;
-		updateCoefficients();
+		if (frequency != newFrequency || q != newQ)
+		{
+			frequency = newFrequency;
+			q = newQ;
+			updateCoefficients();
+		}
 	}
 
     /** Set the resonance. */
@@ -415,12 +418,15 @@ public:
 	};
 
 
+	StaticBiquad()
+	{
+		reset();
+	}
+
 	void reset() override
 	{
-		for (int i = 0; i < numChannels; i++)
-		{
-			filters[i].reset();
-		}
+		memset(z1, 0, sizeof(float)*NUM_MAX_CHANNELS);
+		memset(z2, 0, sizeof(float)*NUM_MAX_CHANNELS);
 	}
 
 	void processSamples(AudioSampleBuffer& b, int startSample, int numSamples)
@@ -430,10 +436,36 @@ public:
 			setNumChannels(b.getNumChannels());
 		}
 
-		for (int i = 0; i < numChannels; i++)
+		// Pick up the latest coefficient set once per block.
+		if (sharedCoefficients.load(std::memory_order_relaxed) & NewCoefficientsFlag)
+			readCoefficients = sharedCoefficients.exchange(readCoefficients, std::memory_order_acq_rel) & IndexMask;
+
+		const Coefficients c = coefficientSets[readCoefficients];
+
+#if JUCE_USE_SSE_INTRINSICS
+		if (numChannels == 2)
+		{
+			processStereo(c, b.getWritePointer(0, startSample), b.getWritePointer(1, startSample), numSamples);
+			return;
+		}
+#endif
+
+		for (int ch = 0; ch < numChannels; ch++)
 		{
-			float* d = b.getWritePointer(i, startSample);
-			filters[i].processSamples(d, numSamples);
+			float* d = b.getWritePointer(ch, startSample);
+
+			for (int i = 0; i < numSamples; i++)
+			{
+				const float input = d[i];
+				const float output = c.b0 * input + z1[ch];
+
+				z1[ch] = c.b1 * input - c.a1 * output + z2[ch];
+				z2[ch] = c.b2 * input - c.a2 * output;
+				d[i] = output;
+			}
+
+			JUCE_SNAP_TO_ZERO(z1[ch]);
+			JUCE_SNAP_TO_ZERO(z2[ch]);
 		}
 	}
 
@@ -441,7 +473,80 @@ public:
 
 	IIRCoefficients currentCoefficients;
 
-	IIRFilter filters[NUM_MAX_CHANNELS];
+private:
+
+	struct Coefficients
+	{
+		// The coefficients are initialised to pass the signal unchanged.
+		float b0 = 1.0f;
+		float b1 = 0.0f;
+		float b2 = 0.0f;
+		float a1 = 0.0f;
+		float a2 = 0.0f;
+	};
+
+	enum
+	{
+		IndexMask = 3,
+		NewCoefficientsFlag = 4
+	};
+
+#if JUCE_USE_SSE_INTRINSICS
+
+	/** Processes both channels in the lower two lanes of one SSE register. */
+	void processStereo(const Coefficients& c, float* l, float* r, int numSamples)
+	{
+		const __m128 vb0 = _mm_set1_ps(c.b0);
+		const __m128 vb1 = _mm_set1_ps(c.b1);
+		const __m128 vb2 = _mm_set1_ps(c.b2);
+		const __m128 va1 = _mm_set1_ps(c.a1);
+		const __m128 va2 = _mm_set1_ps(c.a2);
+
+		__m128 s1 = _mm_setr_ps(z1[0], z1[1], 0.0f, 0.0f);
+		__m128 s2 = _mm_setr_ps(z2[0], z2[1], 0.0f, 0.0f);
+
+		for (int i = 0; i < numSamples; i++)
+		{
+			const __m128 input = _mm_unpacklo_ps(_mm_load_ss(l + i), _mm_load_ss(r + i));
+			const __m128 output = _mm_add_ps(_mm_mul_ps(vb0, input), s1);
+
+			s1 = _mm_add_ps(_mm_sub_ps(_mm_mul_ps(vb1, input), _mm_mul_ps(va1, output)), s2);
+			s2 = _mm_sub_ps(_mm_mul_ps(vb2, input), _mm_mul_ps(va2, output));
+
+			_mm_store_ss(l + i, output);
+			_mm_store_ss(r + i, _mm_shuffle_ps(output, output, _MM_SHUFFLE(1, 1, 1, 1)));
+		}
+
+		float tmp[4];
+
+		_mm_storeu_ps(tmp, s1);
+		z1[0] = tmp[0]; z1[1] = tmp[1];
+
+		_mm_storeu_ps(tmp, s2);
+		z2[0] = tmp[0]; z2[1] = tmp[1];
+
+		for (int c = 0; c < 2; c++)
+		{
+			JUCE_SNAP_TO_ZERO(z1[c]);
+			JUCE_SNAP_TO_ZERO(z2[c]);
+		}
+	}
+
+#endif
+
+	/** Triple buffer between updateCoefficients() and the audio thread.
+	*
+	*	The writer fills its own set and swaps it into the shared slot, the audio thread swaps
+	*	the shared slot with its own set at the start of a block if a new one was published.
+	*	Neither side ever touches a set that the other one owns, so no lock is needed.
+	*/
+	Coefficients coefficientSets[3];
+	int writeCoefficients = 0;
+	int readCoefficients = 1;
+	std::atomic<int> sharedCoefficients { 2 };
+
+	float z1[NUM_MAX_CHANNELS];
+	float z2[NUM_MAX_CHANNELS];
 };
 
 
@@ -584,6 +689,14 @@ public:
 
 	void processSamples(AudioSampleBuffer& b, int startSample, int numSamples)
 	{
+#if JUCE_USE_SSE_INTRINSICS
+		if (b.getNumChannels() == 2)
+		{
+			processStereo(b.getWritePointer(0, startSample), b.getWritePointer(1, startSample), numSamples);
+			return;
+		}
+#endif
+
 		for (int c = 0; c < b.getNumChannels(); c++)
 		{
 			for (int i = 0; i < numSamples; i++)
@@ -620,6 +733,48 @@ private:
 		return 2.0f * buffer[3];
 	}
 
+#if JUCE_USE_SSE_INTRINSICS
+
+	/** Processes both channels in one SSE register. */
+	void processStereo(float* l, float* r, int numSamples)
+	{
+		const __m128 vCut = _mm_set1_ps(cut);
+		const __m128 vRes = _mm_set1_ps(res);
+		const __m128 two = _mm_set1_ps(2.0f);
+
+		__m128 s[4];
+
+		for (int i = 0; i < 4; i++)
+			s[i] = _mm_setr_ps(buf[0][i], buf[1][i], 0.0f, 0.0f);
+
+		for (int i = 0; i < numSamples; i++)
+		{
+			const __m128 input = _mm_unpacklo_ps(_mm_load_ss(l + i), _mm_load_ss(r + i));
+			const __m128 in = _mm_sub_ps(input, _mm_mul_ps(s[3], vRes));
+
+			s[0] = _mm_add_ps(_mm_mul_ps(_mm_sub_ps(in, s[0]), vCut), s[0]);
+			s[1] = _mm_add_ps(_mm_mul_ps(_mm_sub_ps(s[0], s[1]), vCut), s[1]);
+			s[2] = _mm_add_ps(_mm_mul_ps(_mm_sub_ps(s[1], s[2]), vCut), s[2]);
+			s[3] = _mm_add_ps(_mm_mul_ps(_mm_sub_ps(s[2], s[3]), vCut), s[3]);
+
+			const __m128 output = _mm_mul_ps(two, s[3]);
+
+			_mm_store_ss(l + i, output);
+			_mm_store_ss(r + i, _mm_shuffle_ps(output, output, _MM_SHUFFLE(1, 1, 1, 1)));
+		}
+
+		for (int i = 0; i < 4; i++)
+		{
+			float tmp[4];
+			_mm_storeu_ps(tmp, s[i]);
+
+			buf[0][i] = tmp[0];
+			buf[1][i] = tmp[1];
+		}
+	}
+
+#endif
+
 	float buf[NUM_MAX_CHANNELS][4];
 
 	float cut;
@@ -988,6 +1143,25 @@ public:
 			setNumChannels(buffer.getNumChannels());
 		}
 
+#if JUCE_USE_SSE_INTRINSICS
+		if (numChannels == 2 && type != ALLPASS)
+		{
+			float* l = buffer.getWritePointer(0, startSample);
+			float* r = buffer.getWritePointer(1, startSample);
+
+			switch (type)
+			{
+			case LP:	processStereo<LP>(l, r, numSamples); break;
+			case HP:	processStereo<HP>(l, r, numSamples); break;
+			case BP:	processStereo<BP>(l, r, numSamples); break;
+			case NOTCH:	processStereo<NOTCH>(l, r, numSamples); break;
+			default:	break;
+			}
+
+			return;
+		}
+#endif
+
 		switch (type)
 		{
 		case LP:
@@ -1106,6 +1280,60 @@ public:
 	}
 
 private:
+
+#if JUCE_USE_SSE_INTRINSICS
+
+	/** Processes both channels in one SSE register. */
+	template <int FilterMode> void processStereo(float* l, float* r, int numSamples)
+	{
+		const __m128 vg1 = _mm_set1_ps(g1);
+		const __m128 vg2 = _mm_set1_ps(g2);
+		const __m128 vg3 = _mm_set1_ps(g3);
+		const __m128 vg4 = _mm_set1_ps(g4);
+		const __m128 vk = _mm_set1_ps(k);
+		const __m128 two = _mm_set1_ps(2.0f);
+
+		__m128 s0 = _mm_setr_ps(v0z[0], v0z[1], 0.0f, 0.0f);
+		__m128 s1 = _mm_setr_ps(z1_A[0], z1_A[1], 0.0f, 0.0f);
+		__m128 s2 = _mm_setr_ps(v2[0], v2[1], 0.0f, 0.0f);
+
+		for (int i = 0; i < numSamples; i++)
+		{
+			const __m128 input = _mm_unpacklo_ps(_mm_load_ss(l + i), _mm_load_ss(r + i));
+			const __m128 v1z = s1;
+			const __m128 v3 = _mm_sub_ps(_mm_add_ps(input, s0), _mm_mul_ps(two, s2));
+
+			s1 = _mm_add_ps(s1, _mm_sub_ps(_mm_mul_ps(vg1, v3), _mm_mul_ps(vg2, v1z)));
+			s2 = _mm_add_ps(s2, _mm_add_ps(_mm_mul_ps(vg3, v3), _mm_mul_ps(vg4, v1z)));
+			s0 = input;
+
+			__m128 output;
+
+			switch (FilterMode)
+			{
+			case LP:	output = s2; break;
+			case BP:	output = s1; break;
+			case HP:	output = _mm_sub_ps(_mm_sub_ps(input, _mm_mul_ps(vk, s1)), s2); break;
+			default:	output = _mm_sub_ps(input, _mm_mul_ps(vk, s1)); break;
+			}
+
+			_mm_store_ss(l + i, output);
+			_mm_store_ss(r + i, _mm_shuffle_ps(output, output, _MM_SHUFFLE(1, 1, 1, 1)));
+		}
+
+		float tmp[4];
+
+		_mm_storeu_ps(tmp, s0);
+		v0z[0] = tmp[0]; v0z[1] = tmp[1];
+
+		_mm_storeu_ps(tmp, s1);
+		z1_A[0] = tmp[0]; z1_A[1] = tmp[1];
+
+		_mm_storeu_ps(tmp, s2);
+		v2[0] = tmp[0]; v2[1] = tmp[1];
+	}
+
+#endif
 	
 	float v0z[NUM_MAX_CHANNELS];
 	float z1_A[NUM_MAX_CHANNELS];
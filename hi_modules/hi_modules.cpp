@@ -104,6 +104,7 @@ namespace wdl
 #include "effects/fx/RouteFX.cpp"
 #include "effects/fx/Filters.cpp"
 #include "effects/fx/HarmonicFilter.cpp"
+#include "effects/fx/BiquadCascade.cpp"
 #include "effects/fx/CurveEq.cpp"
 #include "effects/fx/StereoFX.cpp"
 #include "effects/fx/SimpleReverb.cpp"
@@ -113,6 +114,7 @@ namespace wdl
 #include "effects/fx/Phaser.cpp"
 #include "effects/fx/GainCollector.cpp"
 #include "effects/convolution/AtkConvolution.cpp"
+#include "effects/convolution/PartitionedConvolution.cpp"
 #include "effects/convolution/Convolution.cpp"
 #include "effects/mda/mdaLimiter.cpp"
 #include "effects/mda/mdaDegrade.cpp"
@@ -141,6 +141,7 @@ END_JUCE_MODULE_DECLARATION
 #include "effects/fx/RouteFX.h"
 #include "effects/fx/Filters.h"
 #include "effects/fx/HarmonicFilter.h"
+#include "effects/fx/BiquadCascade.h"
 #include "effects/fx/CurveEq.h"
 #include "effects/fx/StereoFX.h"
 #include "effects/fx/SimpleReverb.h"
@@ -150,6 +151,7 @@ END_JUCE_MODULE_DECLARATION
 #include "effects/fx/Phaser.h"
 #include "effects/fx/GainCollector.h"
 #include "effects/convolution/AtkConvolution.h"
+#include "effects/convolution/PartitionedConvolution.h"
 #include "effects/convolution/Convolution.h"
 #include "effects/mda/mdaLimiter.h"
 #include "effects/mda/mdaDegrade.h"
@@ -703,28 +703,40 @@ void ModulatorSampler::SamplePropertyUpdater::handlePendingChanges()
 	{
 		ScopedLock sl(arrayLock);
 		thisTime.swapWith(pendingChanges);
+		pendingChangeIndexes.clear();
 	}
 
-	for (auto c : thisTime)
+	Array<PropertyChange> allSampleChanges;
+
+	for (const auto& c : thisTime)
 	{
 		if (c.allSamples)
 		{
 			jassert(c.sound == nullptr);
+			allSampleChanges.add(c);
+		}
+	}
 
-			ModulatorSampler::SoundIterator iter(sampler, false);
+	// All changes that apply to every sample are done in a single pass over the sample map. 
+	// addNewPropertyChange() removes older single sample changes of the same property, so 
+	// the remaining single sample changes are newer and must be applied afterwards.
+	if (!allSampleChanges.isEmpty())
+	{
+		ModulatorSampler::SoundIterator iter(sampler, false);
 
-			while (auto s = iter.getNextSound())
-			{
+		while (auto s = iter.getNextSound())
+		{
+			for (const auto& c : allSampleChanges)
 				s->setProperty(ModulatorSamplerSound::Property(c.index), c.newValue, dontSendNotification);
-			}
 		}
-		else
+	}
+
+	for (const auto& c : thisTime)
+	{
+		if (!c.allSamples && c.sound != nullptr)
 		{
-			if (c.sound != nullptr)
-			{
-				dynamic_cast<ModulatorSamplerSound*>(c.sound.get())->setProperty(ModulatorSamplerSound::Property(c.index),
-				                                                                 c.newValue, dontSendNotification);
-			}
+			dynamic_cast<ModulatorSamplerSound*>(c.sound.get())->setProperty(ModulatorSamplerSound::Property(c.index),
+			                                                                 c.newValue, dontSendNotification);
 		}
 	}
 
@@ -736,13 +748,32 @@ void ModulatorSampler::SamplePropertyUpdater::addNewPropertyChange(ModulatorSamp
 {
 	ScopedLock sl(arrayLock);
 
-	for (auto& c : pendingChanges)
+	if (allSamples)
 	{
-		if (c.sound == sound && c.index == index && c.allSamples == allSamples)
+		// The new value overwrites every pending change of this property
+		for (int i = 0; i < pendingChanges.size(); i++)
 		{
-			c.newValue = newValue;
+			if (pendingChanges.getReference(i).index == index)
+				pendingChanges.remove(i--);
+		}
+
+		pendingChangeIndexes.clear();
+
+		for (int i = 0; i < pendingChanges.size(); i++)
+			pendingChangeIndexes.set(getChangeKey(pendingChanges.getReference(i).sound, pendingChanges.getReference(i).index), i);
+	}
+	else
+	{
+		// Use the lookup table instead of searching the pending changes for every sample of a big selection
+		const int64 key = getChangeKey(sound, index);
+
+		if (pendingChangeIndexes.contains(key))
+		{
+			pendingChanges.getReference(pendingChangeIndexes[key]).newValue = newValue;
 			return;
 		}
+
+		pendingChangeIndexes.set(key, pendingChanges.size());
 	}
 
 	pendingChanges.add(PropertyChange(sound, index, newValue, allSamples));
@@ -791,6 +822,8 @@ void ModulatorSampler::setPreloadSizeAsync(int newPreloadSize)
 void ModulatorSampler::setCurrentPlayingPosition(double normalizedPosition)
 {
 	samplerDisplayValues.currentSamplePos = normalizedPosition;
+
+	getMainController()->getTelemetryRing().push(this, TelemetryRing::PlaybackPosition, (float)samplerDisplayValues.currentSampleStartPos, 0, normalizedPosition);
 }
 
 void ModulatorSampler::setCrossfadeTableValue(float newValue)
@@ -810,7 +843,7 @@ void ModulatorSampler::resetNoteDisplay(int noteNumber)
 	lastStartedVoice = nullptr;
 	samplerDisplayValues.currentNotes[noteNumber] = 0;
 	samplerDisplayValues.currentSamplePos = -1.0;
-	sendAllocationFreeChangeMessage();
+	getMainController()->getTelemetryRing().push(this, TelemetryRing::SamplerNotes, 0.0f, noteNumber);
 }
 
 void ModulatorSampler::resetNotes()
@@ -988,16 +1021,12 @@ void ModulatorSampler::preHiseEventCallback(const HiseEvent &m)
 			samplerDisplayValues.currentGroup = currentRRGroupIndex;
 		}
 
-		if (m.isNoteOn())
-		{
-			samplerDisplayValues.currentNotes[m.getNoteNumber() + m.getTransposeAmount()] = m.getVelocity();
-		}
-		else
-		{
-            samplerDisplayValues.currentNotes[m.getNoteNumber() + m.getTransposeAmount()] = 0;
-		}
+		const int noteNumber = m.getNoteNumber() + m.getTransposeAmount();
+		const uint8 velocity = m.isNoteOn() ? m.getVelocity() : 0;
+
+		samplerDisplayValues.currentNotes[noteNumber] = velocity;
 		
-        sendAllocationFreeChangeMessage();
+		getMainController()->getTelemetryRing().push(this, TelemetryRing::SamplerNotes, (float)velocity, noteNumber);
 	}
 
 	if (!m.isNoteOff() || !oneShotEnabled)
@@ -1230,6 +1259,8 @@ void ModulatorSampler::setRRGroupAmount(int newGroupLimit)
 
 bool ModulatorSampler::preloadAllSamples()
 {
+	TRACE_STARTUP_ZONE_WITH_DETAIL("preloadAllSamples", getId());
+
 	const int preloadSizeToUse = (int)getAttribute(ModulatorSampler::PreloadSize) * getPreloadScaleFactor();
 
 	resetNotes();
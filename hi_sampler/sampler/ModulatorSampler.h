@@ -57,7 +57,8 @@ class SampleEditHandler;
 */
 class ModulatorSampler: public ModulatorSynth,
 						public ExternalFileProcessor,
-						public LookupTableProcessor
+						public LookupTableProcessor,
+						public TelemetryRing::Source
 {
 public:
 
@@ -593,11 +594,21 @@ private:
 
 		void addNewPropertyChange(ModulatorSamplerSound* sound, int index, int newValue, bool allSamples);
 
+		/** Creates a unique key for the sound / property combination (the properties fit into the lower six bits). */
+		static int64 getChangeKey(const ModulatorSamplerSound* sound, int index)
+		{
+			static_assert(ModulatorSamplerSound::numProperties <= 64, "Too many properties for the key");
+			return (int64)(reinterpret_cast<pointer_sized_int>(sound) * 64 + index);
+		}
+
 		CriticalSection arrayLock;
 
 		ModulatorSampler* sampler;
 
 		Array<PropertyChange> pendingChanges;
+
+		/** The position of the single sample changes in pendingChanges. */
+		HashMap<int64, int> pendingChangeIndexes;
 	};
 	
 
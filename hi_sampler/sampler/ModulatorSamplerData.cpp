@@ -73,6 +73,49 @@ void ThumbnailHandler::saveNewThumbNails(ModulatorSampler *sampler, const String
 	new ThumbnailHandler(directory, newAudioFiles, sampler);
 }
 
+File ThumbnailHandler::getPeakCacheDirectory(ModulatorSampler *sampler)
+{
+	return GET_PROJECT_HANDLER(sampler).getWorkDirectory().getChildFile("peaks");
+}
+
+void ThumbnailHandler::saveThumbnail(AudioThumbnailCache *cache, AudioFormatManager &afm, const File &file)
+{
+	AudioThumbnail thumb(256, afm, *cache);
+	ScopedPointer<AudioFormatReader> afr = afm.createReaderFor(new FileInputStream(file));
+
+	if (afr != nullptr)
+	{
+		const int64 numSamples = afr->lengthInSamples;
+
+		AudioSampleBuffer chunk(afr->numChannels, PeakPyramid::ChunkSize);
+		PeakPyramid::Builder builder(afr->numChannels, numSamples);
+
+		thumb.reset(afr->numChannels, afr->sampleRate, numSamples);
+
+		for (int64 position = 0; position < numSamples; position += PeakPyramid::ChunkSize)
+		{
+			if (threadShouldExit())
+				return;
+
+			const int numThisTime = (int)jmin<int64>(PeakPyramid::ChunkSize, numSamples - position);
+
+			afr->read(&chunk, 0, numThisTime, position, true, true);
+
+			thumb.addBlock(position, chunk, 0, numThisTime);
+			builder.addBlock(chunk, numThisTime);
+		}
+
+		cache->storeThumb(thumb, file.hashCode64());
+
+		PeakPyramid::Ptr pyramid = builder.createPyramid();
+		pyramid->saveToFile(PeakPyramid::getCacheFile(getPeakCacheDirectory(sampler), file.hashCode64()));
+	}
+	else
+	{
+		jassertfalse;
+	}
+}
+
 void ThumbnailHandler::run()
 {
 	AudioFormatManager &afm = sampler->getMainController()->getSampleManager().getModulatorSamplerSoundPool()->afm;
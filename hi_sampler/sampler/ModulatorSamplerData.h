@@ -65,6 +65,9 @@ public:
 
 	static void saveNewThumbNails(ModulatorSampler *sampler, const StringArray &newAudioFiles);
 
+	/** Returns the directory that contains the PeakPyramid files of the samples. */
+	static File getPeakCacheDirectory(ModulatorSampler *sampler);
+
 private:
 
 	ThumbnailHandler(const File &directoryToLoad, ModulatorSampler *s);;
@@ -81,26 +84,8 @@ private:
 		new ThumbnailHandler(directoryToLoad, sampler);
 	}
 
-	void saveThumbnail(AudioThumbnailCache *cache, AudioFormatManager &afm, const File &file)
-	{
-		AudioThumbnail thumb(256, afm, *cache);
-		ScopedPointer<AudioFormatReader> afr = afm.createReaderFor(new FileInputStream(file));
-		
-        if(afr != nullptr)
-        {
-            AudioSampleBuffer buffer(afr->numChannels, (int)afr->lengthInSamples);
-            
-            thumb.reset(afr->numChannels, afr->sampleRate, afr->lengthInSamples);
-            afr->read(&buffer, 0, (int)afr->lengthInSamples, 0, true, true);
-            thumb.addBlock(0, buffer, 0, buffer.getNumSamples());
-            cache->storeThumb(thumb, file.hashCode64());
-        }
-        else
-        {
-            jassertfalse;
-        }
-        
-	}
+	/** Reads the file in chunks and creates the thumbnail and the PeakPyramid. */
+	void saveThumbnail(AudioThumbnailCache *cache, AudioFormatManager &afm, const File &file);
 
 	void run() override;
 
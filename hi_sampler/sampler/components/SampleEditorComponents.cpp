@@ -122,13 +122,6 @@ void SampleComponent::changeListenerCallback(SafeChangeBroadcaster *b)
 {
 	jassert(b == sound);
 	map->updateSampleComponentWithSound(sound);
-
-	SampleMapEditor *editor = map->findParentComponentOfClass<SampleMapEditor>();
-
-	if (editor != nullptr)
-	{
-		editor->refreshRootNotes();
-	}
 }
 
 #pragma warning( pop )
@@ -411,7 +404,10 @@ void SamplerSoundMap::refreshSelectedSoundsFromLasso()
 {
 	lassoSelectedComponents.clear();
 
-	for (int i = 0; i < sampleComponents.size(); i++)
+	Array<int> indexes;
+	getComponentsInArea(currentLassoRectangle, indexes);
+
+	for (auto i : indexes)
 	{
 		SampleComponent *c = sampleComponents[i];
 
@@ -480,7 +476,10 @@ void SamplerSoundMap::drawSoundMap(Graphics &g)
         //g.drawLine(i * noteWidth, 0, i * noteWidth, (float)getHeight(), 1.0f);
     }
     
-    for(int i = 0; i < sampleComponents.size(); i++)
+	Array<int> indexes;
+	getComponentsInArea(g.getClipBounds(), indexes);
+
+    for(auto i : indexes)
     {
         SampleComponent *c = sampleComponents[i];
 		
@@ -492,9 +491,138 @@ void SamplerSoundMap::drawSoundMap(Graphics &g)
 
 void SamplerSoundMap::paint(Graphics &g)
 {
-    g.drawImageAt(currentSnapshot, 0, 0);
+	// The viewport was scrolled, so the snapshot needs to be rendered for the new area
+	if (getVisibleArea() != snapshotArea)
+		renderSnapshot();
+
+    g.drawImageAt(currentSnapshot, snapshotArea.getX(), snapshotArea.getY());
 };
 
+void SamplerSoundMap::timerCallback()
+{
+	if (rootNotesNeedRefresh)
+	{
+		rootNotesNeedRefresh = false;
+
+		if (auto editor = findParentComponentOfClass<SampleMapEditor>())
+			editor->refreshRootNotes();
+	}
+
+	if (getWidth() > 0 && getHeight() > 0)
+	{
+		renderSnapshot();
+		repaint();
+	}
+
+	stopTimer();
+}
+
+Rectangle<int> SamplerSoundMap::getVisibleArea() const
+{
+	if (auto viewport = findParentComponentOfClass<Viewport>())
+	{
+		if (auto viewedComponent = viewport->getViewedComponent())
+			return getLocalArea(viewedComponent, viewport->getViewArea()).getIntersection(getLocalBounds());
+	}
+
+	return getLocalBounds();
+}
+
+void SamplerSoundMap::renderSnapshot()
+{
+	snapshotArea = getVisibleArea();
+
+	if (snapshotArea.isEmpty())
+	{
+		currentSnapshot = Image();
+		return;
+	}
+
+	currentSnapshot = Image(Image::RGB, snapshotArea.getWidth(), snapshotArea.getHeight(), true);
+
+	Graphics g2(currentSnapshot);
+
+	g2.setOrigin(-snapshotArea.getX(), -snapshotArea.getY());
+
+	drawSoundMap(g2);
+}
+
+void SamplerSoundMap::getComponentsInArea(Rectangle<int> area, Array<int>& indexes)
+{
+	if (spatialIndexDirty)
+	{
+		spatialIndex.rebuild(sampleComponents, getLocalBounds());
+		spatialIndexDirty = false;
+	}
+
+	spatialIndex.getComponentsInArea(area, indexes);
+}
+
+void SamplerSoundMap::SpatialIndex::rebuild(const OwnedArray<SampleComponent>& components, Rectangle<int> totalArea)
+{
+	indexedArea = totalArea;
+
+	for (auto& cell : cells)
+		cell.clearQuick();
+
+	if (indexedArea.isEmpty())
+		return;
+
+	for (int i = 0; i < components.size(); i++)
+	{
+		auto c = components.getUnchecked(i);
+
+		if (!c->isVisible())
+			continue;
+
+		const auto b = c->getBoundsInParent();
+
+		const auto xRange = getCellRange(b.getX(), b.getRight(), indexedArea.getX(), indexedArea.getWidth());
+		const auto yRange = getCellRange(b.getY(), b.getBottom(), indexedArea.getY(), indexedArea.getHeight());
+
+		for (int y = yRange.getStart(); y < yRange.getEnd(); y++)
+			for (int x = xRange.getStart(); x < xRange.getEnd(); x++)
+				cells[y * NumCellsPerAxis + x].add(i);
+	}
+}
+
+void SamplerSoundMap::SpatialIndex::getComponentsInArea(Rectangle<int> area, Array<int>& indexes) const
+{
+	indexes.clearQuick();
+
+	if (indexedArea.isEmpty())
+		return;
+
+	const auto xRange = getCellRange(area.getX(), area.getRight(), indexedArea.getX(), indexedArea.getWidth());
+	const auto yRange = getCellRange(area.getY(), area.getBottom(), indexedArea.getY(), indexedArea.getHeight());
+
+	for (int y = yRange.getStart(); y < yRange.getEnd(); y++)
+		for (int x = xRange.getStart(); x < xRange.getEnd(); x++)
+			indexes.addArray(cells[y * NumCellsPerAxis + x]);
+
+	// A sample that spans multiple cells is added more than once, and the 
+	// original order is needed so that overlapping samples are drawn the same way.
+	indexes.sort();
+
+	int numUnique = 0;
+
+	for (int i = 0; i < indexes.size(); i++)
+	{
+		if (numUnique == 0 || indexes.getUnchecked(numUnique - 1) != indexes.getUnchecked(i))
+			indexes.set(numUnique++, indexes.getUnchecked(i));
+	}
+
+	indexes.resize(numUnique);
+}
+
+Range<int> SamplerSoundMap::SpatialIndex::getCellRange(int start, int end, int totalStart, int totalSize) const
+{
+	const int first = jlimit<int>(0, NumCellsPerAxis - 1, ((start - totalStart) * NumCellsPerAxis) / totalSize);
+	const int last = jlimit<int>(0, NumCellsPerAxis - 1, ((jmax<int>(start, end - 1) - totalStart) * NumCellsPerAxis) / totalSize);
+
+	return Range<int>(first, last + 1);
+}
+
 void SamplerSoundMap::paintOverChildren(Graphics &g)
 {
     const float noteWidth = (float)getWidth() / 128.0f;
@@ -588,6 +716,7 @@ void SamplerSoundMap::updateSampleComponentWithSound(ModulatorSamplerSound *soun
     if(index < sampleComponents.size())
     {
         updateSampleComponent(index);
+		rootNotesNeedRefresh = true;
     }
     else
     {
@@ -614,6 +743,7 @@ void SamplerSoundMap::updateSampleComponent(int index)
 		const int y_max = getHeight() - (int)s->getProperty(ModulatorSamplerSound::VeloLow) * velocityHeight;
 
 		sampleComponents[index]->setSampleBounds((int)x, (int)y, (int)(x_max - x), (int)(y_max-y));
+		spatialIndexDirty = true;
 		
         refreshGraphics();
 	}
@@ -641,6 +771,8 @@ void SamplerSoundMap::updateSoundData()
 		{
 			sampleComponents.add(new SampleComponent(sound, this));
 		}
+
+		spatialIndexDirty = true;
 	}
 	else
 	{
@@ -847,7 +979,15 @@ void SamplerSoundMap::setPressedKeys(const uint8 *pressedKeyData)
 
 		if(newNote)
 		{
-			for(int j = 0; j < sampleComponents.size(); j++)
+			const float noteWidth = (float)getWidth() / 128.0f;
+
+			// Only the samples in the column of the key can apply to the note
+			const int x = (int)((float)number * noteWidth);
+
+			Array<int> indexes;
+			getComponentsInArea(Rectangle<int>(x, 0, jmax<int>(1, (int)noteWidth), getHeight()), indexes);
+
+			for(auto j : indexes)
 			{
 				if(sampleComponents[j]->isVisible() && sampleComponents[j]->getSound() != nullptr &&
 					sampleComponents[j]->getSound()->appliesToMessage(1, number, velocity) &&
@@ -868,7 +1008,10 @@ void SamplerSoundMap::setPressedKeys(const uint8 *pressedKeyData)
 
 SampleComponent* SamplerSoundMap::getSampleComponentAt(Point<int> point)
 {
-	for(int i = 0; i < sampleComponents.size(); i++)
+	Array<int> indexes;
+	getComponentsInArea(Rectangle<int>(point.getX(), point.getY(), 1, 1), indexes);
+
+	for(auto i : indexes)
 	{
 		if (sampleComponents[i]->isVisible() && sampleComponents[i]->samplePathContains(point)) return sampleComponents[i];
 	}
@@ -910,11 +1053,32 @@ void SamplerSoundMap::setSelectedIds(const SampleSelection& newSelectionList)
 {
 	selectedSounds->deselectAll();
 
-	for(int i = 0; i < sampleComponents.size(); i++)
+	for (int i = 0; i < newSelectionList.size(); i++)
 	{
-		if(newSelectionList.contains(sampleComponents[i]->getSound()))
+		auto sound = newSelectionList[i].get();
+
+		if (sound == nullptr)
+			continue;
+
+		// The ID of a sound is its index in the sample map, so the component can be found without a search
+		const int index = (int)sound->getProperty(ModulatorSamplerSound::ID);
+
+		if (auto c = sampleComponents[index])
 		{
-			selectedSounds->addToSelection(sampleComponents[i]);
+			if (c->getSound() == sound)
+			{
+				selectedSounds->addToSelection(c);
+				continue;
+			}
+		}
+
+		for (auto c : sampleComponents)
+		{
+			if (c->getSound() == sound)
+			{
+				selectedSounds->addToSelection(c);
+				break;
+			}
 		}
 	}
 
@@ -934,6 +1098,8 @@ void SamplerSoundMap::soloGroup(int groupIndex)
 		sampleComponents[i]->setEnabled(visible);
 	}
 
+	spatialIndexDirty = true;
+
     refreshGraphics();
 }
 
@@ -970,8 +1136,8 @@ MapWithKeyboard::MapWithKeyboard(ModulatorSampler *ownerSampler):
 	sampler(ownerSampler),
 	lastNoteNumber(-1)
 {
-    setBufferedToImage(true);
-    
+	// The map renders its own snapshot of the visible area, so this isn't buffered 
+	// (it would create an image with the size of the whole zoomed map).
 	addAndMakeVisible(map = new SamplerSoundMap(ownerSampler));
 };
 
@@ -1193,12 +1359,23 @@ void SamplerSoundTable::soundsSelected(const SampleSelection &selectedSounds)
 	table.deselectAllRows();
 
     SparseSet<int> selection;
+
+	// Sort the selection once, so every row needs a binary search instead of a linear search
+	Array<ModulatorSamplerSound*> sortedSelection;
+	sortedSelection.ensureStorageAllocated(selectedSounds.size());
+
+	for (const auto& s : selectedSounds)
+		sortedSelection.add(s.get());
+
+	sortedSelection.sort();
+
+	DefaultElementComparator<ModulatorSamplerSound*> comparator;
     
 	for (int i = 0; i < sortedSoundList.size(); i++)
 	{
 		ModulatorSamplerSound *sound = sortedSoundList[i];
 
-		if (selectedSounds.contains(sound))
+		if (sortedSelection.indexOfSorted(comparator, sound) != -1)
 		{
 			selection.addRange(Range<int>(i, i + 1));
 		}
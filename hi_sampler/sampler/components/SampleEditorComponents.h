@@ -307,6 +307,9 @@ private:
 
 /** A component which displays all loaded ModulatorSamplerSounds and allows editing of their properties. 
 *	@ingroup components
+*
+*	In order to handle big sample maps, the map only renders the area that is visible in the parent Viewport and uses a 
+*	SpatialIndex to find the samples within an area (for painting, hit tests, lasso selection and the note display).
 */
 class SamplerSoundMap: public Component,
 					   public ChangeListener,
@@ -340,21 +343,7 @@ public:
 		sampleComponents.clear();
 	};
 
-	void timerCallback() override
-	{
-		if (getWidth() > 0 && getHeight() > 0)
-		{
-			currentSnapshot = Image(Image::RGB, getWidth(), getHeight(), true);
-
-			Graphics g2(currentSnapshot);
-
-			drawSoundMap(g2);
-
-			repaint();
-		}
-
-        stopTimer();
-	}
+	void timerCallback() override;
 
 	void modifierKeysChanged(const ModifierKeys &modifiers) override;
 
@@ -433,6 +422,30 @@ public:
 
 private:
 
+	/** A grid that contains the indexes of the visible SampleComponents that overlap each cell. */
+	class SpatialIndex
+	{
+	public:
+
+		enum
+		{
+			NumCellsPerAxis = 16
+		};
+
+		/** Sorts the visible components into the cells. */
+		void rebuild(const OwnedArray<SampleComponent>& components, Rectangle<int> totalArea);
+
+		/** Fills the array with the indexes of the components that might overlap the area in ascending order. */
+		void getComponentsInArea(Rectangle<int> area, Array<int>& indexes) const;
+
+	private:
+
+		Range<int> getCellRange(int start, int end, int totalStart, int totalSize) const;
+
+		Rectangle<int> indexedArea;
+		Array<int> cells[NumCellsPerAxis * NumCellsPerAxis];
+	};
+
 	/** A POD object containing data for a dragged sound. */
 	struct DragData
 	{
@@ -447,6 +460,15 @@ private:
 	/** checks if the sampler contains new samples that are not displayed yet. */
 	bool newSamplesDetected();
 
+	/** Returns the part of the map that is visible in the Viewport. */
+	Rectangle<int> getVisibleArea() const;
+
+	/** Draws the visible area into the snapshot image. */
+	void renderSnapshot();
+
+	/** Returns the indexes of the visible components that might overlap the area. */
+	void getComponentsInArea(Rectangle<int> area, Array<int>& indexes);
+
 	SampleComponent* getSampleComponentAt(Point<int> point);
 
 	void checkEventForSampleDragging(const MouseEvent &e);
@@ -473,6 +495,10 @@ private:
 	Array<int> selectedIds;
 	OwnedArray<SampleComponent> sampleComponents;
 
+	SpatialIndex spatialIndex;
+	bool spatialIndexDirty = true;
+	bool rootNotesNeedRefresh = false;
+
 	Array<WeakReference<SampleComponent>> lassoSelectedComponents;
 
 	ScopedPointer<SelectedItemSet<WeakReference<SampleComponent>>> selectedSounds;
@@ -483,6 +509,7 @@ private:
 	uint32 milliSecondsSinceLastLassoCheck;
     
     Image currentSnapshot;
+	Rectangle<int> snapshotArea;
 };
 
 /** A wrapper class around a SamplerSoundMap which adds a keyboard that can be clicked to trigger the note. 
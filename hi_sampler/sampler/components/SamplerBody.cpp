@@ -112,6 +112,8 @@ SamplerBody::SamplerBody (ProcessorEditor *p)
 
 	getSampleEditHandler()->addSelectionListener(this);
 
+	getProcessor()->getMainController()->getTelemetryRing().addSubscriber(dynamic_cast<ModulatorSampler*>(getProcessor()), this);
+
 #if SAMPLER_DEPRECATED
 	selectionListener = new SelectionListener(this);
 #endif
@@ -173,6 +175,8 @@ SamplerBody::~SamplerBody()
 
 	getSampleEditHandler()->removeSelectionListener(this);
 
+	getProcessor()->getMainController()->getTelemetryRing().removeSubscriber(this);
+
     //[/Destructor_pre]
 
     sampleEditor = nullptr;
@@ -41,7 +41,8 @@
 */
 class SamplerBody  : public ProcessorEditorBody,
                      public ButtonListener,
-					 public SampleEditHandler::Listener
+					 public SampleEditHandler::Listener,
+					 public TelemetryRing::Subscriber
 {
 public:
     //==============================================================================
@@ -63,6 +64,22 @@ public:
 		map->updateInterface();
 	};
 
+	/** The note display of the sampler is sent through the TelemetryRing instead of a change message. */
+	void telemetryReceived(const TelemetryRing::Record& r) override
+	{
+		if (r.type == TelemetryRing::SamplerNotes)
+			notesChanged = true;
+	}
+
+	void telemetryDrained() override
+	{
+		if (notesChanged)
+		{
+			notesChanged = false;
+			updateGui();
+		}
+	}
+
 
 	/** This is called whenever the selection changes.
 	*
@@ -176,6 +193,8 @@ public:
 
 private:
     //[UserVariables]   -- You can add your own custom variables in this section.
+	bool notesChanged = false;
+
 	int h;
 	int settingsHeight;
 	int waveFormHeight;
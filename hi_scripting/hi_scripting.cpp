@@ -49,11 +49,13 @@
 #include "scripting/engine/JavascriptApiClass.cpp"
 #include "scripting/api/ScriptingBaseObjects.cpp"
 #include "scripting/engine/DebugHelpers.cpp"
+#include "scripting/engine/ScriptProfiler.cpp"
 #include "scripting/engine/HiseJavascriptEngine.cpp"
 #include "scripting/engine/JavascriptEngineExpressions.cpp"
 #include "scripting/engine/JavascriptEngineStatements.cpp"
 #include "scripting/engine/JavascriptEngineOperators.cpp"
 #include "scripting/engine/JavascriptEngineCustom.cpp"
+#include "scripting/engine/JavascriptEngineBytecode.cpp"
 #include "scripting/engine/JavascriptEngineParser.cpp"
 #include "scripting/engine/JavascriptEngineObjects.cpp"
 #include "scripting/engine/JavascriptEngineMathObject.cpp"
@@ -62,6 +64,7 @@
 
 #include "scripting/api/XmlApi.cpp"
 #include "scripting/api/ScriptingApiObjects.cpp"
+#include "scripting/api/TypedArray.cpp"
 #include "scripting/api/ScriptingApi.cpp"
 #include "scripting/api/ScriptComponentEditBroadcaster.cpp"
 #include "scripting/api/ScriptingApiWrappers.cpp"
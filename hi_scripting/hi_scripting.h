@@ -87,10 +87,12 @@ END_JUCE_MODULE_DECLARATION
 #include "scripting/scripting_audio_processor/ScriptedAudioProcessor.h"
 
 #include "scripting/engine/DebugHelpers.h"
+#include "scripting/engine/ScriptProfiler.h"
 #include "scripting/engine/HiseJavascriptEngine.h"
 
 #include "scripting/api/XmlApi.h"
 #include "scripting/api/ScriptingApiObjects.h"
+#include "scripting/api/TypedArray.h"
 #include "scripting/api/ScriptingApi.h"
 #include "scripting/api/ScriptingApiContent.h"
 #include "scripting/api/ScriptComponentEditBroadcaster.h"
@@ -417,6 +417,50 @@ ValueTree FileChangeListener::collectAllScriptFiles(ModulatorSynthChain *chainTo
 		}
 	}
 
+	// Store the tokens of every script so that the exported plugin doesn't need to tokenize them again
+	ValueTree precompiledTokens("PrecompiledTokens");
+
+	auto addTokens = [&precompiledTokens](const String& code)
+	{
+		static const Identifier hash("Hash");
+		static const Identifier data("Data");
+
+		if (code.isEmpty())
+			return;
+
+		const int64 codeHash = code.hashCode64();
+
+		if (precompiledTokens.getChildWithProperty(hash, codeHash).isValid())
+			return;
+
+		MemoryBlock mb = HiseJavascriptEngine::createPrecompiledTokens(code);
+
+		if (mb.getSize() == 0 || !HiseJavascriptEngine::checkPrecompiledTokens(code, mb).wasOk())
+			return;
+
+		ValueTree tokens("Tokens");
+		tokens.setProperty(hash, codeHash, nullptr);
+		tokens.setProperty(data, var(mb), nullptr);
+
+		precompiledTokens.addChild(tokens, -1, nullptr);
+	};
+
+	Processor::Iterator<JavascriptProcessor> tokenIter(chainToExport);
+
+	while (JavascriptProcessor *sp = tokenIter.getNextProcessor())
+	{
+		for (int i = 0; i < sp->getNumSnippets(); i++)
+		{
+			if (!sp->getSnippet(i)->isSnippetEmpty())
+				addTokens(sp->getSnippet(i)->getSnippetAsFunction());
+		}
+	}
+
+	for (int i = 0; i < externalScriptFiles.getNumChildren(); i++)
+		addTokens(externalScriptFiles.getChild(i).getProperty("Content").toString());
+
+	externalScriptFiles.addChild(precompiledTokens, -1, nullptr);
+
 	return externalScriptFiles;
 }
 
@@ -507,8 +551,56 @@ void JavascriptProcessor::clearExternalWindows()
 
 JavascriptProcessor::SnippetResult JavascriptProcessor::compileInternal()
 {
-	
+	prepareCompilation();
+
+	// The tokens don't depend on the engine, so the code is tokenized before the locks are acquired.
+	const Array<int64> addedTokens = precompileTokens();
+
+	auto thisAsProcessor = dynamic_cast<Processor*>(this);
+
+	SnippetResult result(Result::ok(), 0);
+
+	{
+		ScopedLock callbackLock(thisAsProcessor->isOnAir() ? mainController->getLock() : thisAsProcessor->getDummyLockWhenNotOnAir());
+
+		ScopedWriteLock sl(mainController->getCompileLock());
+
+		initialiseEngine();
+
+		result = executeSnippets();
+
+		if (result.r.wasOk())
+			finishCompilation();
+	}
+
+	mainController->removePrecompiledTokens(addedTokens);
+
+	return result;
+}
+
+Array<int64> JavascriptProcessor::precompileTokens() const
+{
+	Array<int64> addedTokens;
+
+	for (int i = 0; i < getNumSnippets(); i++)
+	{
+		const String code = getSnippet(i)->getSnippetAsFunction();
+		const int64 codeHash = code.hashCode64();
+
+		if (code.isEmpty() || mainController->hasPrecompiledTokens(codeHash))
+			continue;
+
+		const MemoryBlock tokens = HiseJavascriptEngine::createPrecompiledTokens(code);
 
+		if (tokens.getSize() > 0 && mainController->addPrecompiledTokens(codeHash, tokens))
+			addedTokens.add(codeHash);
+	}
+
+	return addedTokens;
+}
+
+void JavascriptProcessor::prepareCompilation()
+{
 	ProcessorWithScriptingContent* thisAsScriptBaseProcessor = dynamic_cast<ProcessorWithScriptingContent*>(this);
 
 	ScriptingApi::Content* content = thisAsScriptBaseProcessor->getScriptingContent();
@@ -518,31 +610,52 @@ JavascriptProcessor::SnippetResult JavascriptProcessor::compileInternal()
 	if (saveThisContent) 
 		thisAsScriptBaseProcessor->restoredContentValues = content->exportAsValueTree();
 
-	auto thisAsProcessor = dynamic_cast<Processor*>(this);
-
-	thisAsProcessor->getMainController()->getScriptComponentEditBroadcaster()->clearSelection(sendNotification);
-
-    ScopedLock callbackLock(thisAsProcessor->isOnAir() ? mainController->getLock() : thisAsProcessor->getDummyLockWhenNotOnAir());
+	mainController->getScriptComponentEditBroadcaster()->clearSelection(sendNotification);
+}
 
-    
-	ScopedWriteLock sl(mainController->getCompileLock());
-    
+void JavascriptProcessor::initialiseEngine()
+{
+	ProcessorWithScriptingContent* thisAsScriptBaseProcessor = dynamic_cast<ProcessorWithScriptingContent*>(this);
 
 	scriptEngine->clearDebugInformation();
 
-	content->beginInitialization();
+	thisAsScriptBaseProcessor->getScriptingContent()->beginInitialization();
 
 	setupApi();
 
-	content = thisAsScriptBaseProcessor->getScriptingContent();
+	scriptEngine->setIsInitialising(true);
 
-	
-    scriptEngine->setIsInitialising(true);
-    
 	if(cycleReferenceCheckEnabled)
 		scriptEngine->setUseCycleReferenceCheckForNextCompilation();
 
 	thisAsScriptBaseProcessor->allowObjectConstructors = true;
+}
+
+void JavascriptProcessor::setBreakpointsForCallback(const Identifier& callbackId)
+{
+#if ENABLE_SCRIPTING_BREAKPOINTS
+	Array<HiseJavascriptEngine::Breakpoint> breakpointsForCallback;
+
+	for (int k = 0; k < breakpoints.size(); k++)
+	{
+		if (breakpoints[k].snippetId == callbackId || breakpoints[k].snippetId.toString().startsWith("File_"))
+			breakpointsForCallback.add(breakpoints[k]);
+	}
+
+	if (!breakpointsForCallback.isEmpty())
+		scriptEngine->setBreakpoints(breakpointsForCallback);
+#else
+	ignoreUnused(callbackId);
+#endif
+}
+
+JavascriptProcessor::SnippetResult JavascriptProcessor::executeSnippets()
+{
+	ProcessorWithScriptingContent* thisAsScriptBaseProcessor = dynamic_cast<ProcessorWithScriptingContent*>(this);
+
+	ScriptingApi::Content* content = thisAsScriptBaseProcessor->getScriptingContent();
+
+	auto thisAsProcessor = dynamic_cast<Processor*>(this);
 
 	const static Identifier onInit("onInit");
 
@@ -554,20 +667,7 @@ JavascriptProcessor::SnippetResult JavascriptProcessor::compileInternal()
 		{
 			const Identifier callbackId = getSnippet(i)->getCallbackName();
 
-#if ENABLE_SCRIPTING_BREAKPOINTS
-			Array<HiseJavascriptEngine::Breakpoint> breakpointsForCallback;
-
-			for (int k = 0; k < breakpoints.size(); k++)
-			{
-				if (breakpoints[k].snippetId == callbackId || breakpoints[k].snippetId.toString().startsWith("File_"))
-					breakpointsForCallback.add(breakpoints[k]);
-			}
-
-			if (!breakpointsForCallback.isEmpty())
-				scriptEngine->setBreakpoints(breakpointsForCallback);
-
-
-#endif
+			setBreakpointsForCallback(callbackId);
 
 			lastResult = scriptEngine->execute(getSnippet(i)->getSnippetAsFunction(), callbackId == onInit);
 
@@ -576,7 +676,7 @@ JavascriptProcessor::SnippetResult JavascriptProcessor::compileInternal()
 				debugError(thisAsProcessor, lastResult.getErrorMessage());
 
 				content->endInitialization();
-                scriptEngine->setIsInitialising(false);
+				scriptEngine->setIsInitialising(false);
 				thisAsScriptBaseProcessor->allowObjectConstructors = false;
 
 				// Check the rest of the snippets or they will be deleted on failed compile...
@@ -609,21 +709,25 @@ JavascriptProcessor::SnippetResult JavascriptProcessor::compileInternal()
 
 	content->endInitialization();
 
-    scriptEngine->setIsInitialising(false);
+	scriptEngine->setIsInitialising(false);
     
 	thisAsScriptBaseProcessor->allowObjectConstructors = false;
 
 	lastCompileWasOK = true;
 
-	if (thisAsProcessor->getMainController()->getScriptComponentEditBroadcaster()->isBeingEdited(thisAsProcessor))
+	return SnippetResult(Result::ok(), getNumSnippets());
+}
+
+void JavascriptProcessor::finishCompilation()
+{
+	auto thisAsProcessor = dynamic_cast<Processor*>(this);
+
+	if (mainController->getScriptComponentEditBroadcaster()->isBeingEdited(thisAsProcessor))
 	{
 		debugToConsole(thisAsProcessor, "Compiled OK");
 	}
-	
 
 	postCompileCallback();
-
-	return SnippetResult(Result::ok(), getNumSnippets());
 }
 
 JavascriptProcessor::SnippetResult JavascriptProcessor::compileScript()
@@ -649,6 +753,109 @@ JavascriptProcessor::SnippetResult JavascriptProcessor::compileScript()
 		result = compileInternal();
 	}
 
+	updateAfterCompilation(result);
+
+	return result;
+}
+
+void JavascriptProcessor::compileAll(const Array<JavascriptProcessor*>& processors)
+{
+	if (processors.isEmpty())
+		return;
+
+	class TokenizeJob : public ThreadPoolJob
+	{
+	public:
+
+		TokenizeJob(MainController* mc_, const String& code_) :
+			ThreadPoolJob("Tokenizing script"),
+			mc(mc_),
+			code(code_)
+		{}
+
+		JobStatus runJob() override
+		{
+			TRACE_STARTUP_ZONE("Tokenize script");
+
+			const MemoryBlock tokens = HiseJavascriptEngine::createPrecompiledTokens(code);
+
+			if (tokens.getSize() > 0)
+				added = mc->addPrecompiledTokens(code.hashCode64(), tokens);
+
+			return jobHasFinished;
+		}
+
+		int64 getCodeHash() const { return code.hashCode64(); }
+
+		bool wasAdded() const { return added; }
+
+	private:
+
+		MainController* mc;
+		const String code;
+		bool added = false;
+	};
+
+	MainController* mc = processors.getFirst()->mainController;
+
+	// The code is collected on this thread, so the jobs don't access the snippet documents.
+	OwnedArray<TokenizeJob> jobs;
+	Array<int64> codeHashes;
+
+	for (auto jp : processors)
+	{
+		for (int i = 0; i < jp->getNumSnippets(); i++)
+		{
+			const String code = jp->getSnippet(i)->getSnippetAsFunction();
+			const int64 codeHash = code.hashCode64();
+
+			if (code.isEmpty() || codeHashes.contains(codeHash) || mc->hasPrecompiledTokens(codeHash))
+				continue;
+
+			codeHashes.add(codeHash);
+			jobs.add(new TokenizeJob(mc, code));
+		}
+	}
+
+	// The tokens don't depend on any engine, so all scripts are tokenized in parallel without a lock.
+	if (jobs.size() > 1)
+	{
+		ThreadPool pool(jmin(jobs.size(), SystemStats::getNumCpus()));
+
+		for (auto job : jobs)
+			pool.addJob(job, false);
+
+		for (auto job : jobs)
+			pool.waitForJobToFinish(job, -1);
+	}
+	else
+	{
+		for (auto job : jobs)
+			job->runJob();
+	}
+
+	Array<int64> addedTokens;
+
+	for (auto job : jobs)
+	{
+		if (job->wasAdded())
+			addedTokens.add(job->getCodeHash());
+	}
+
+	// Parsing, onInit and the post compile callbacks run in the order of the array. compileScript() only holds 
+	// the audio lock and the compile lock while one processor is compiled, so the audio thread can run in between.
+	for (auto jp : processors)
+	{
+		TRACE_STARTUP_ZONE_WITH_DETAIL("Compile script", dynamic_cast<Processor*>(jp)->getId());
+
+		jp->compileScript();
+	}
+
+	mc->removePrecompiledTokens(addedTokens);
+}
+
+void JavascriptProcessor::updateAfterCompilation(const SnippetResult& result)
+{
 	if (lastCompileWasOK)
 	{
 		String x;
@@ -664,6 +871,22 @@ JavascriptProcessor::SnippetResult JavascriptProcessor::compileScript()
 		setFileResult(scriptEngine->getIncludedFile(i), scriptEngine->getIncludedFileResult(i));
 	}
 
+#if USE_BACKEND
+	if (lastCompileWasOK)
+	{
+		for (int i = 0; i < getNumSnippets(); i++)
+		{
+			const Identifier callbackId = getSnippet(i)->getCallbackName();
+
+			if (!isRealtimeCallback(callbackId))
+				continue;
+
+			for (const auto& w : scriptEngine->getAllocationWarnings(callbackId))
+				debugToConsole(dynamic_cast<Processor*>(this), "Warning: " + w);
+		}
+	}
+#endif
+
 	const String fileName = ApiHelpers::getFileNameFromErrorMessage(result.r.getErrorMessage());
 
 	if (fileName.isNotEmpty())
@@ -678,8 +901,6 @@ JavascriptProcessor::SnippetResult JavascriptProcessor::compileScript()
 	}
 
 	mainController->sendScriptCompileMessage(this);
-
-	return result;
 }
 
 
@@ -689,8 +910,14 @@ void JavascriptProcessor::setupApi()
 
 	dynamic_cast<ProcessorWithScriptingContent*>(this)->getScriptingContent()->cleanJavascriptObjects();
 
+	// The profiler needs the objects of the old engine to describe the recorded frames
+	if (profiler != nullptr)
+		profiler->clearFrameIds();
+
 	scriptEngine = new HiseJavascriptEngine(this);
 
+	scriptEngine->setProfiler(profiler);
+
 	scriptEngine->addBreakpointListener(this);
 
 	scriptEngine->setCallStackEnabled(callStackEnabled);
@@ -739,6 +966,49 @@ const JavascriptProcessor::SnippetDocument * JavascriptProcessor::getSnippet(con
 	return nullptr;
 }
 
+void JavascriptProcessor::startProfiling(bool recordStatements)
+{
+	if (profiler == nullptr)
+	{
+		profiler = new ScriptProfiler();
+
+		if (scriptEngine != nullptr)
+			scriptEngine->setProfiler(profiler);
+	}
+
+	profiler->start(recordStatements);
+}
+
+void JavascriptProcessor::stopProfiling()
+{
+	if (profiler != nullptr)
+		profiler->stop();
+}
+
+Result JavascriptProcessor::exportProfile(const File& f, ScriptProfiler::ExportFormat format)
+{
+	if (profiler == nullptr)
+		return Result::fail("The profiler was never started");
+
+	{
+		// The engine must not be replaced while the frames are described
+		ScopedReadLock sl(mainController->getCompileLock());
+
+		profiler->createFrameInfos();
+	}
+
+	return profiler->exportToFile(f, format);
+}
+
+bool JavascriptProcessor::isRealtimeCallback(const Identifier& callbackId) const
+{
+	static const Identifier onInit("onInit");
+	static const Identifier onControl("onControl");
+	static const Identifier prepareToPlay("prepareToPlay");
+
+	return callbackId != onInit && callbackId != onControl && callbackId != prepareToPlay;
+}
+
 #if 0
 void JavascriptProcessor::DelayedPositionUpdater::scriptComponentChanged(ReferenceCountedObject *componentThatWasChanged, Identifier idThatWasChanged)
 {
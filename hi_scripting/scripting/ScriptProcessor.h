@@ -364,6 +364,14 @@ public:
 
 	SnippetResult compileScript();
 
+	/** Compiles all given processors in the order of the array.
+	*
+	*	The callbacks of all processors are tokenized in parallel on a thread pool first. Then each processor is 
+	*	compiled with compileScript(), so the locks are only held for one processor at a time and the background 
+	*	thread is used if MainController::isUsingBackgroundThreadForCompiling() is enabled.
+	*/
+	static void compileAll(const Array<JavascriptProcessor*>& processors);
+
 	void setupApi();
 
 	virtual void registerApiClasses() = 0;
@@ -376,6 +384,9 @@ public:
 	SnippetDocument *getSnippet(const Identifier& id);
 	const SnippetDocument *getSnippet(const Identifier& id) const;
 
+	/** Returns true if the callback is executed on the audio thread (then it must not allocate memory). */
+	virtual bool isRealtimeCallback(const Identifier& callbackId) const;
+
 
 	
 
@@ -404,6 +415,24 @@ public:
 
 	HiseJavascriptEngine *getScriptEngine() { return scriptEngine; }
 
+	/** Starts recording the execution times of all callbacks and functions of this processor.
+	*
+	*	If recordStatements is true, every statement will be recorded too. The bytecode is not used then, so the
+	*	absolute times will be higher than usual.
+	*/
+	void startProfiling(bool recordStatements);
+
+	/** Stops the profiler. You can export the recorded data with exportProfile(). */
+	void stopProfiling();
+
+	/** Writes the recorded data to the given file. */
+	Result exportProfile(const File& f, ScriptProfiler::ExportFormat format);
+
+	bool isProfiling() const { return profiler != nullptr && profiler->isRecording(); }
+
+	/** Returns the profiler of this processor or nullptr if it was never started. */
+	const ScriptProfiler* getProfiler() const { return profiler; }
+
 	void mergeCallbacksToScript(String &x, const String& sepString=String()) const;
 	bool parseSnippetsFromString(const String &x, bool clearUndoHistory = false);
 
@@ -536,12 +565,36 @@ protected:
 
 	virtual SnippetResult compileInternal();
 
+	/** Saves the control values. This is the first step of the compilation and doesn't need any lock. */
+	void prepareCompilation();
+
+	/** Tokenizes the callbacks and passes the tokens to the MainController, so that the parser doesn't scan the code 
+	*	while the locks are held. Returns the hash codes of the added tokens, remove them after the compilation.
+	*/
+	Array<int64> precompileTokens() const;
+
+	/** Creates a new engine and registers the API classes. The compile lock must be held. */
+	void initialiseEngine();
+
+	/** Executes all callbacks and restores the control values. The compile lock must be held. */
+	SnippetResult executeSnippets();
+
+	/** Calls postCompileCallback(). The audio lock and the compile lock must be held. */
+	void finishCompilation();
+
+	/** Updates the file watchers and sends the compile message. */
+	void updateAfterCompilation(const SnippetResult& result);
+
+	void setBreakpointsForCallback(const Identifier& callbackId);
+
 	friend class CompileThread;
 
 	String connectedFileReference;
 
 	CompileThread *currentCompileThread;
 
+	ScopedPointer<ScriptProfiler> profiler;
+
 	ScopedPointer<HiseJavascriptEngine> scriptEngine;
 
 	MainController* mainController;
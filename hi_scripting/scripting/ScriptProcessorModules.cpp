@@ -198,6 +198,7 @@ void JavascriptMidiProcessor::registerApiClasses()
     
     scriptEngine->registerNativeObject("Libraries", new DspFactory::LibraryLoader(this));
     scriptEngine->registerNativeObject("Buffer", new VariantBuffer::Factory(64));
+    scriptEngine->registerNativeObject("TypedArray", new TypedArray::Factory());
     
 }
 
@@ -580,6 +581,7 @@ void JavascriptMasterEffect::registerApiClasses()
 
 	scriptEngine->registerNativeObject("Libraries", new DspFactory::LibraryLoader(this));
 	scriptEngine->registerNativeObject("Buffer", new VariantBuffer::Factory(64));
+	scriptEngine->registerNativeObject("TypedArray", new TypedArray::Factory());
 
 }
 
@@ -1018,6 +1020,7 @@ void JavascriptTimeVariantModulator::registerApiClasses()
 
 	scriptEngine->registerNativeObject("Libraries", new DspFactory::LibraryLoader(this));
 	scriptEngine->registerNativeObject("Buffer", new VariantBuffer::Factory(64));
+	scriptEngine->registerNativeObject("TypedArray", new TypedArray::Factory());
 }
 
 
@@ -1289,6 +1292,7 @@ void JavascriptEnvelopeModulator::registerApiClasses()
 
 	scriptEngine->registerNativeObject("Libraries", new DspFactory::LibraryLoader(this));
 	scriptEngine->registerNativeObject("Buffer", new VariantBuffer::Factory(64));
+	scriptEngine->registerNativeObject("TypedArray", new TypedArray::Factory());
 }
 
 void JavascriptEnvelopeModulator::postCompileCallback()
@@ -1626,6 +1630,7 @@ void JavascriptModulatorSynth::registerApiClasses()
 
 	scriptEngine->registerNativeObject("Libraries", new DspFactory::LibraryLoader(this));
 	scriptEngine->registerNativeObject("Buffer", new VariantBuffer::Factory(64));
+	scriptEngine->registerNativeObject("TypedArray", new TypedArray::Factory());
 }
 
 
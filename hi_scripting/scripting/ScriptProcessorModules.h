@@ -99,6 +99,11 @@ public:
 	void deferCallbacks(bool addToFront_);
 	bool isDeferred() const { return deferred; };
 
+	bool isRealtimeCallback(const Identifier& callbackId) const override
+	{
+		return !isDeferred() && JavascriptProcessor::isRealtimeCallback(callbackId);
+	}
+
 	void handleAsyncUpdate() override;
 
 	
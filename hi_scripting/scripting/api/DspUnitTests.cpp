@@ -207,6 +207,215 @@ public:
 static DspUnitTests dspUnitTest;
 
 
+class ScriptOperatorTest : public UnitTest
+{
+public:
+
+	ScriptOperatorTest() :
+		UnitTest("Testing script operators")
+	{
+
+	}
+
+	void runTest() override
+	{
+		testNumbers();
+
+		testStrings();
+
+		testBufferChains();
+
+		testMixedChains();
+	}
+
+private:
+
+	enum
+	{
+		BufferSize = 100 // not a multiple of the block size of the fused operators
+	};
+
+	HiseJavascriptEngine* createEngine()
+	{
+		auto engine = new HiseJavascriptEngine(nullptr);
+
+		engine->registerNativeObject("Buffer", new VariantBuffer::Factory(64));
+
+		return engine;
+	}
+
+	var evaluate(HiseJavascriptEngine& engine, const String& code)
+	{
+		Result r = Result::ok();
+		var result = engine.evaluate(code, &r);
+
+		expect(r.wasOk(), code + ": " + r.getErrorMessage());
+
+		return result;
+	}
+
+	void execute(HiseJavascriptEngine& engine, const String& code)
+	{
+		Result r = engine.execute(code);
+
+		expect(r.wasOk(), code + ": " + r.getErrorMessage());
+	}
+
+	/** Creates the buffers a, b, c and t. */
+	void createBuffers(HiseJavascriptEngine& engine)
+	{
+		execute(engine, "var a = Buffer.create(" + String(BufferSize) + ");\n"
+						"var b = Buffer.create(" + String(BufferSize) + ");\n"
+						"var c = Buffer.create(" + String(BufferSize) + ");\n"
+						"var t = Buffer.create(" + String(BufferSize) + ");\n");
+
+		resetBuffers(engine);
+	}
+
+	void resetBuffers(HiseJavascriptEngine& engine)
+	{
+		execute(engine, "for (i = 0; i < " + String(BufferSize) + "; i++)\n"
+						"{\n"
+						"	a[i] = i * 0.01;\n"
+						"	b[i] = 0.5;\n"
+						"	c[i] = -0.25;\n"
+						"	t[i] = 0.0;\n"
+						"}\n");
+	}
+
+	float getA(int i) const { return (float)i * 0.01f; }
+
+	/** Checks the buffer against the expected value of each sample. */
+	void expectBuffer(HiseJavascriptEngine& engine, const String& name, const std::function<float(int)>& expected, const String& message)
+	{
+		auto b = evaluate(engine, name).getBuffer();
+
+		expect(b != nullptr, message + ": " + name + " is not a buffer");
+
+		if (b == nullptr)
+			return;
+
+		for (int i = 0; i < BufferSize; i++)
+		{
+			const float value = b->buffer.getSample(0, i);
+
+			if (std::abs(value - expected(i)) > 0.0001f)
+			{
+				expect(false, message + ": " + name + "[" + String(i) + "] is " + String(value) + ", expected " + String(expected(i)));
+				return;
+			}
+		}
+	}
+
+	void testNumbers()
+	{
+		beginTest("Testing operator chains with numbers");
+
+		ScopedPointer<HiseJavascriptEngine> engine = createEngine();
+
+		expectEquals<int>(evaluate(*engine, "3 * 4 + 2"), 14, "Int chain");
+		expectEquals<int>(evaluate(*engine, "7 - 2 * 3"), 1, "Precedence");
+		expectEquals<int>(evaluate(*engine, "1 + 2 * 3 - 4"), 3, "Mixed precedence");
+		expectEquals<double>(evaluate(*engine, "2.5 * 2 - 1"), 4.0, "Double chain");
+		expect(evaluate(*engine, "2.5 * 2 - 1").isDouble(), "Double chain type");
+		expectEquals<int>(evaluate(*engine, "1 << 1 + 1 + 1"), 8, "Left shift with a chain");
+	}
+
+	void testStrings()
+	{
+		beginTest("Testing operator chains with strings");
+
+		ScopedPointer<HiseJavascriptEngine> engine = createEngine();
+
+		expectEquals<String>(evaluate(*engine, "\"a\" + 1 + 2").toString(), "a12", "String first");
+		expectEquals<String>(evaluate(*engine, "1 + 2 + \"a\"").toString(), "3a", "String last");
+		expectEquals<String>(evaluate(*engine, "\"x\" + 2 * 3").toString(), "x6", "String with precedence");
+	}
+
+	void testBufferChains()
+	{
+		beginTest("Testing operator chains with buffers");
+
+		ScopedPointer<HiseJavascriptEngine> engine = createEngine();
+
+		createBuffers(*engine);
+
+		execute(*engine, "t << a * b + c;");
+
+		expectBuffer(*engine, "t", [this](int i) { return getA(i) * 0.5f - 0.25f; }, "Fused assignment");
+		expectBuffer(*engine, "a", [this](int i) { return getA(i) * 0.5f - 0.25f; }, "The first operand contains the result");
+		expectBuffer(*engine, "b", [](int) { return 0.5f; }, "The other operands are not changed");
+
+		resetBuffers(*engine);
+
+		execute(*engine, "b << a * b - c;");
+
+		expectBuffer(*engine, "b", [this](int i) { return getA(i) * 0.5f + 0.25f; }, "Target is an operand");
+
+		resetBuffers(*engine);
+
+		execute(*engine, "a << a + b * c;");
+
+		expectBuffer(*engine, "a", [this](int i) { return getA(i) - 0.125f; }, "Chain on the right-hand side");
+		expectBuffer(*engine, "b", [](int) { return -0.125f; }, "Chain on the right-hand side changes its first operand");
+
+		resetBuffers(*engine);
+
+		engine->registerCallbackName("onTest", 0, 0.0);
+
+		execute(*engine, "function onTest()\n{\n	t << a - b * c;\n}\n");
+
+		Result r = Result::ok();
+		engine->executeCallback(0, &r);
+
+		expect(r.wasOk(), r.getErrorMessage());
+		expectBuffer(*engine, "t", [this](int i) { return getA(i) - 0.125f; }, "Assignment in a compiled callback");
+
+		resetBuffers(*engine);
+
+		execute(*engine, "function onTest()\n{\n	t << a * b * b + c - c;\n}\n");
+
+		r = Result::ok();
+		engine->executeCallback(0, &r);
+
+		expect(r.wasOk(), r.getErrorMessage());
+		expectBuffer(*engine, "t", [this](int i) { return getA(i) * 0.25f; }, "Fused assignment in a compiled callback");
+	}
+
+	void testMixedChains()
+	{
+		beginTest("Testing operator chains with buffers and numbers");
+
+		ScopedPointer<HiseJavascriptEngine> engine = createEngine();
+
+		createBuffers(*engine);
+
+		execute(*engine, "t << a * 2 + c;");
+
+		expectBuffer(*engine, "t", [this](int i) { return getA(i) * 2.0f - 0.25f; }, "Chain with a number");
+		expectBuffer(*engine, "a", [this](int i) { return getA(i) * 2.0f - 0.25f; }, "Chain with a number changes the first operand");
+
+		resetBuffers(*engine);
+
+		execute(*engine, "t << a * b + 1;");
+
+		expectBuffer(*engine, "t", [this](int i) { return getA(i) * 0.5f + 1.0f; }, "Number at the end of the chain");
+
+		execute(*engine, "var small = Buffer.create(10);");
+
+		Result r = engine->execute("t << a * small + c;");
+
+		expect(r.failed(), "Size mismatch in a chain");
+
+		r = engine->execute("small << a * b + c;");
+
+		expect(r.failed(), "Target is too small");
+	}
+};
+
+static ScriptOperatorTest scriptOperatorTest;
+
+
 class CustomContainerTest : public UnitTest
 {
 public:
@@ -506,6 +715,204 @@ private:
 static CustomContainerTest unorderedStackTest;
 
 
+class TypedArrayTest : public UnitTest
+{
+public:
+
+	TypedArrayTest() :
+		UnitTest("Testing TypedArray")
+	{
+
+	}
+
+	void runTest() override
+	{
+		testFloatArray();
+
+		testIntArray();
+
+		testViews();
+
+		testMidiListCounter();
+	}
+
+private:
+
+	static var referTo(const var& source, int offset = 0, int numElements = -1)
+	{
+		var args[3] = { source, offset, numElements };
+
+		var::NativeFunctionArgs a(var(), args, numElements >= 0 ? 3 : 2);
+
+		return TypedArray::Factory::referTo(a);
+	}
+
+	void testFloatArray()
+	{
+		beginTest("Testing float arrays");
+
+		TypedArray a(TypedArray::Type::Float32, 64);
+
+		expectEquals<int>(a.size(), 64, "Size");
+
+		for (int i = 0; i < 64; i++)
+			expect((float)a.getUnchecked(i) == 0.0f, "Clear at index " + String(i));
+
+		a.fill(0.5f);
+		a.setUnchecked(12, 2.0f);
+		a.multiply(2.0f);
+		a.add(-1.0f);
+
+		expectEquals<float>(a.getUnchecked(0), 0.0f, "fill, multiply and add");
+		expectEquals<float>(a.getUnchecked(12), 3.0f, "setUnchecked");
+		expectEquals<float>(a.getMax(), 3.0f, "getMax");
+		expectEquals<float>(a.getMin(), 0.0f, "getMin");
+
+		a.setUnchecked(3, sqrt(-1.0));
+
+		expectEquals<float>(a.getUnchecked(3), 0.0f, "NaN is sanitized");
+
+		TypedArray other(TypedArray::Type::Float32, 64);
+
+		other.fill(2.0f);
+		other.multiply(var(&a));
+
+		expectEquals<float>(other.getUnchecked(12), 6.0f, "Multiply with other array");
+
+		TypedArray empty(TypedArray::Type::Float32, 0);
+
+		expect(empty.getMax().isUndefined(), "getMax of empty array");
+	}
+
+	void testIntArray()
+	{
+		beginTest("Testing int arrays");
+
+		TypedArray a(TypedArray::Type::Int32, 10);
+
+		a.fill(3);
+		a.setUnchecked(2, 7.8);
+		a.add(1);
+
+		expectEquals<int>(a.getUnchecked(0), 4, "fill and add");
+		expectEquals<int>(a.getUnchecked(2), 8, "setUnchecked truncates");
+
+		var source = Array<var>({ 5, 6, 7 });
+
+		a.copyFrom(source);
+
+		expectEquals<int>(a.getUnchecked(1), 6, "copyFrom Array");
+		expectEquals<int>(a.getUnchecked(3), 4, "copyFrom Array keeps the rest");
+
+		TypedArray f(TypedArray::Type::Float32, 10);
+
+		f.copyFrom(var(&a));
+
+		expectEquals<float>(f.getUnchecked(2), 7.0f, "copyFrom int to float");
+		expectEquals<int>(a.getMax(), 7, "getMax");
+		expectEquals<int>(a.getMin(), 4, "getMin");
+	}
+
+	void testViews()
+	{
+		beginTest("Testing views of other data");
+
+		var b = var(new VariantBuffer(16));
+
+		var view = referTo(b, 4, 8);
+
+		auto t = dynamic_cast<TypedArray*>(view.getObject());
+
+		expect(t != nullptr, "View of a Buffer");
+
+		if (t == nullptr)
+			return;
+
+		expectEquals<int>(t->size(), 8, "View size");
+
+		t->fill(1.0f);
+
+		expectEquals<float>(b.getBuffer()->getSample(3), 0.0f, "View doesn't write before the offset");
+		expectEquals<float>(b.getBuffer()->getSample(4), 1.0f, "View writes the buffer");
+		expectEquals<float>(b.getBuffer()->getSample(12), 0.0f, "View doesn't write after the end");
+
+		var viewOfView = referTo(view, 2);
+
+		dynamic_cast<TypedArray*>(viewOfView.getObject())->setUnchecked(0, 5.0f);
+
+		expectEquals<float>(b.getBuffer()->getSample(6), 5.0f, "View of a view");
+
+		b = var();
+		view = var();
+
+		expectEquals<float>(dynamic_cast<TypedArray*>(viewOfView.getObject())->getUnchecked(0), 5.0f, "View keeps the data alive");
+	}
+
+	void testMidiListCounter()
+	{
+		beginTest("Testing the counter of a MidiList with views");
+
+		ScriptingObjects::MidiList* list = new ScriptingObjects::MidiList(nullptr);
+		var listVar(list);
+
+		expect(list->isEmpty(), "Empty after creation");
+
+		list->setValue(10, 5);
+		list->setValue(20, 5);
+		list->setValue(20, 6);
+
+		expectEquals<int>(list->getNumSetValues(), 2, "setValue");
+
+		list->setValue(10, -1);
+
+		expectEquals<int>(list->getNumSetValues(), 1, "Removing a value");
+
+		list->fill(3);
+
+		expectEquals<int>(list->getNumSetValues(), 128, "fill");
+
+		list->clear();
+
+		expect(list->isEmpty(), "clear");
+
+		var view = referTo(listVar, 64);
+
+		auto t = dynamic_cast<TypedArray*>(view.getObject());
+
+		expect(t != nullptr, "View of a MidiList");
+
+		if (t == nullptr)
+			return;
+
+		t->setUnchecked(0, 12);
+		t->setUnchecked(1, 13);
+		t->setUnchecked(1, -1);
+
+		expectEquals<int>(list->getValue(64), 12, "View writes the MidiList");
+		expectEquals<int>(list->getNumSetValues(), 1, "setUnchecked of a view");
+
+		t->fill(0);
+
+		expectEquals<int>(list->getNumSetValues(), 64, "fill of a view");
+
+		var viewOfView = referTo(view, 0, 10);
+
+		dynamic_cast<TypedArray*>(viewOfView.getObject())->fill(-1);
+
+		expectEquals<int>(list->getNumSetValues(), 54, "fill of a view of a view");
+
+		const String encoded = list->getBase64String();
+
+		list->clear();
+		list->restoreFromBase64String(encoded);
+
+		expectEquals<int>(list->getNumSetValues(), 54, "restoreFromBase64String");
+	}
+};
+
+static TypedArrayTest typedArrayTest;
+
+
 
 
 
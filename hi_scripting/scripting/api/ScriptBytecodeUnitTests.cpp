@@ -0,0 +1,372 @@
+/*  ===========================================================================
+*
+*   This file is part of HISE.
+*   Copyright 2016 Christoph Hart
+*
+*   HISE is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   HISE is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with HISE.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Commercial licenses for using HISE in an closed source project are
+*   available on request. Please visit the project's website to get more
+*   information about commercial licensing:
+*
+*   http://www.hise.audio/
+*
+*   HISE is based on the JUCE library,
+*   which also must be licenced for commercial applications:
+*
+*   http://www.juce.com
+*
+*   ===========================================================================
+*/
+
+#include "AppConfig.h"
+
+#if HI_RUN_UNIT_TESTS
+
+#include  "JuceHeader.h"
+
+using namespace hise;
+
+/** Runs scripts through the bytecode of the callbacks and compares the results with the statement tree. 
+*
+*	The code in the onTest callback is compiled into bytecode while HiseJavascriptEngine::evaluate() always uses
+*	the statement tree, so both paths can be checked with the same expressions.
+*/
+class ScriptBytecodeTests : public UnitTest
+{
+public:
+
+	ScriptBytecodeTests() :
+		UnitTest("Testing the script bytecode")
+	{
+
+	}
+
+	void runTest() override
+	{
+		testOpCodes();
+
+		testLocalVariables();
+
+		testNumericFastPaths();
+
+		testFallbacks();
+
+		testConcurrentExecution();
+	}
+
+private:
+
+	const String declarations = "const var i = 7;\n"
+								"const var j = 2;\n"
+								"const var d = 2.5;\n"
+								"const var s = \"4\";\n"
+								"const var arr = [1, 2, 3];\n"
+								"reg ri = 3;\n"
+								"reg rd = 0.5;\n"
+								"var gv = 0;\n"
+								"inline function scale(value, factor)\n"
+								"{\n"
+								"	local result = value * factor;\n"
+								"	return result + 1;\n"
+								"}\n";
+
+	HiseJavascriptEngine* createEngine()
+	{
+		auto engine = new HiseJavascriptEngine(nullptr);
+
+		engine->registerCallbackName("onTest", 0, 0.0);
+
+		Result r = engine->execute(declarations);
+		expect(r.wasOk(), "Declarations: " + r.getErrorMessage());
+
+		return engine;
+	}
+
+	/** Compiles the code as body of the callback and returns the value of its return statement. */
+	var runCallback(HiseJavascriptEngine& engine, const String& body)
+	{
+		Result r = engine.execute("function onTest()\n{\n" + body + "\n}\n");
+		expect(r.wasOk(), "Compiling " + body + ": " + r.getErrorMessage());
+
+		r = Result::ok();
+
+		var returnValue = engine.executeCallback(0, &r);
+		expect(r.wasOk(), "Executing " + body + ": " + r.getErrorMessage());
+
+		return returnValue;
+	}
+
+	/** Checks that the bytecode returns the same value with the same type as the statement tree. */
+	void expectSameAsTree(HiseJavascriptEngine& engine, const String& expression)
+	{
+		Result r = Result::ok();
+
+		const var treeResult = engine.evaluate(expression, &r);
+		expect(r.wasOk(), "Evaluating " + expression + ": " + r.getErrorMessage());
+
+		const var bytecodeResult = runCallback(engine, "return " + expression + ";");
+
+		expect(bytecodeResult.equalsWithSameType(treeResult), expression + ": " + bytecodeResult.toString() + " vs. " + treeResult.toString());
+	}
+
+	void testOpCodes()
+	{
+		beginTest("Testing bytecode instructions");
+
+		ScopedPointer<HiseJavascriptEngine> engine = createEngine();
+
+		expectEquals<int>(runCallback(*engine, "return 5;"), 5, "LoadConstant");
+		expectEquals<int>(runCallback(*engine, "return ri;"), 3, "LoadPointer");
+		expectEquals<int>(runCallback(*engine, "ri = 12; return ri;"), 12, "StorePointer");
+		expectEquals<int>(runCallback(*engine, "return i;"), 7, "LoadConstObject");
+		expectEquals<int>(runCallback(*engine, "return scale(3, 4);"), 13, "LoadParameter");
+		expectEquals<int>(runCallback(*engine, "return scale(scale(1, 2), 3);"), 10, "Nested inline function calls");
+		expectEquals<int>(runCallback(*engine, "gv = 4; return gv * 2;"), 8, "Assign to a global variable");
+
+		expect((bool)runCallback(*engine, "return i > 3 && j < 3;"), "LogicalAnd");
+		expect((bool)runCallback(*engine, "return i < 3 || j < 3;"), "LogicalOr");
+		expect(!(bool)runCallback(*engine, "return i < 3 || j > 3;"), "LogicalOr false");
+		expectEquals<String>(runCallback(*engine, "return i > j ? \"yes\" : \"no\";").toString(), "yes", "ConditionalOp");
+
+		expectEquals<int>(runCallback(*engine, "if (i == 7) return 1; else return 2;"), 1, "If statement");
+		expectEquals<int>(runCallback(*engine, "if (i != 7) return 1; return 2;"), 2, "If statement without else");
+
+		expectEquals<int>(runCallback(*engine, "local count = 0;\n"
+											   "for (ri = 0; ri < 100; ri++)\n"
+											   "{\n"
+											   "	if (ri == 10) break;\n"
+											   "	if (ri % 2 == 0) continue;\n"
+											   "	count += ri;\n"
+											   "}\n"
+											   "return count;"), 25, "For loop with break and continue");
+
+		expectEquals<int>(runCallback(*engine, "local x = 1; while (x < 1000) x *= 3; return x;"), 2187, "While loop");
+
+		expectEquals<int>(runCallback(*engine, "ri = 5; ri++; return ri;"), 6, "PostAssignment");
+	}
+
+	void testLocalVariables()
+	{
+		beginTest("Testing local variable slots");
+
+		ScopedPointer<HiseJavascriptEngine> engine = createEngine();
+
+		expectEquals<int>(runCallback(*engine, "local a = 3; local b = a * 2; a = b + 1; return a + b;"), 13, "Callback locals");
+
+		// The locals of a callback are cleared after each execution
+		expectEquals<int>(runCallback(*engine, "local a; if (a == undefined) return 1; return 2;"), 1, "Callback locals are reset");
+
+		Result r = engine->execute("inline function sumTo(n)\n"
+								   "{\n"
+								   "	local total = 0;\n"
+								   "	for (ri = 0; ri < n; ri++)\n"
+								   "		total += ri;\n"
+								   "	return total;\n"
+								   "}\n");
+
+		expect(r.wasOk(), r.getErrorMessage());
+
+		expectEquals<int>(runCallback(*engine, "return sumTo(10);"), 45, "Inline function locals");
+		expectEquals<int>(runCallback(*engine, "return sumTo(4) + sumTo(5);"), 16, "Inline function locals with two calls");
+	}
+
+	void testNumericFastPaths()
+	{
+		beginTest("Testing numeric fast paths");
+
+		ScopedPointer<HiseJavascriptEngine> engine = createEngine();
+
+		const char* expressions[] = 
+		{
+			"i + j", "i - j", "i * j", "i / j", "i % j",
+			"i + d", "d - j", "d * j", "d / j",
+			"i / 0", "d / 0", "i % 0",
+			"i == j", "i != j", "i < j", "i <= 7", "i > d", "d >= 2.5", "i == 7.0",
+			"i + s", "s + i", "s == 4",
+			"ri * rd + i", "(i + j) * (i - j) / d", "i - j - ri - 1",
+			"true + 1", "true == 1"
+		};
+
+		for (auto e : expressions)
+			expectSameAsTree(*engine, e);
+	}
+
+	void testFallbacks()
+	{
+		beginTest("Testing fallbacks to the statement tree");
+
+		ScopedPointer<HiseJavascriptEngine> engine = createEngine();
+
+		expectEquals<int>(runCallback(*engine, "local x = 0; do { x += 2; } while (x < 7); return x;"), 8, "Do-while loop");
+		expectEquals<int>(runCallback(*engine, "local sum = 0; for (v in arr) sum += v; return sum;"), 6, "For-in loop");
+		expectEquals<int>(runCallback(*engine, "arr[1] = 5; return arr[1];"), 5, "Array subscript");
+		expectEquals<int>(runCallback(*engine, "return arr.length;"), 3, "Property access");
+		expectEquals<double>(runCallback(*engine, "return Math.abs(-4) + Math.max(1, 2);"), 6.0, "API call");
+		expectEquals<String>(runCallback(*engine, "return \"a\" + i + d;").toString(), "a72.5", "String concatenation");
+	}
+
+	/** Runs the same callback on multiple threads. Every invocation must use its own registers. */
+	void testConcurrentExecution()
+	{
+		beginTest("Testing concurrent execution of a callback");
+
+		ScopedPointer<HiseJavascriptEngine> engine = createEngine();
+
+		Result r = engine->execute("function onTest()\n{\n return ((i + j) * (i - j) + (i * 3 - j) * (j + 1)) / d;\n}\n");
+		expect(r.wasOk(), r.getErrorMessage());
+
+		Result treeResult = Result::ok();
+		const var expected = engine->evaluate("((i + j) * (i - j) + (i * 3 - j) * (j + 1)) / d", &treeResult);
+
+		struct TestThread : public Thread
+		{
+			TestThread(HiseJavascriptEngine& e_, const var& expected_) :
+				Thread("Bytecode Test Thread"),
+				e(e_),
+				expected(expected_)
+			{}
+
+			void run() override
+			{
+				for (int i = 0; i < 10000; i++)
+				{
+					Result result = Result::ok();
+
+					if (!(e.executeCallback(0, &result) == expected) || !result.wasOk())
+						numErrors++;
+				}
+			}
+
+			HiseJavascriptEngine& e;
+			const var expected;
+			int numErrors = 0;
+		};
+
+		TestThread t1(*engine, expected);
+		TestThread t2(*engine, expected);
+
+		t1.startThread();
+		t2.startThread();
+
+		t1.waitForThreadToExit(-1);
+		t2.waitForThreadToExit(-1);
+
+		expectEquals<int>(t1.numErrors + t2.numErrors, 0, "Wrong results with concurrent execution");
+	}
+};
+
+static ScriptBytecodeTests scriptBytecodeTests;
+
+#if ENABLE_SCRIPTING_ALLOCATION_TRACER
+
+class ScriptAllocationTracerTests : public UnitTest
+{
+public:
+
+	ScriptAllocationTracerTests() :
+		UnitTest("Testing the script allocation tracer")
+	{
+
+	}
+
+	void runTest() override
+	{
+		testStatementRecords();
+
+		testCallbackAllocations();
+	}
+
+private:
+
+	void testStatementRecords()
+	{
+		beginTest("Testing the records of the statements");
+
+		OwnedArray<String> strings;
+
+		int firstStatement, secondStatement;
+
+		ScriptAllocationTracer tracer;
+
+		{
+			ScriptAllocationTracer::ScopedStatement ss(&firstStatement);
+
+			strings.add(new String("first"));
+			strings.add(new String("second"));
+		}
+
+		{
+			ScriptAllocationTracer::ScopedStatement ss(&secondStatement);
+
+			strings.add(new String("third"));
+		}
+
+		tracer.stop();
+
+		strings.add(new String("not recorded"));
+
+		expectEquals<int>(tracer.getNumRecords(), 2, "Number of records");
+		expectEquals<int>(tracer.getNumDroppedAllocations(), 0, "Dropped allocations");
+
+		if (tracer.getNumRecords() == 2)
+		{
+			expect(tracer.getRecord(0).statement == &firstStatement, "First statement");
+			expect(tracer.getRecord(1).statement == &secondStatement, "Second statement");
+
+			expect(tracer.getRecord(0).numAllocations >= 2, "Allocations of the first statement");
+			expect(tracer.getRecord(1).numAllocations >= 1, "Allocations of the second statement");
+			expect(tracer.getRecord(0).numBytes >= 2 * sizeof(String), "Bytes of the first statement");
+		}
+	}
+
+	void testCallbackAllocations()
+	{
+		beginTest("Testing the allocations of a callback");
+
+		ScopedPointer<HiseJavascriptEngine> engine = new HiseJavascriptEngine(nullptr);
+
+		engine->registerCallbackName("onTest", 0, 0.0);
+
+		Result r = engine->execute("function onTest()\n{\n	local a = 1;\n	return [a, 2, 3];\n}\n");
+		expect(r.wasOk(), r.getErrorMessage());
+
+		ScriptAllocationTracer tracer;
+
+		var returnValue = engine->executeCallback(0, &r);
+
+		tracer.stop();
+
+		expect(r.wasOk(), r.getErrorMessage());
+		expectEquals<int>(returnValue.size(), 3, "Return value");
+
+		int numAllocations = tracer.getNumDroppedAllocations();
+		bool allocationsHaveStatement = false;
+
+		for (int i = 0; i < tracer.getNumRecords(); i++)
+		{
+			numAllocations += tracer.getRecord(i).numAllocations;
+			allocationsHaveStatement |= tracer.getRecord(i).statement != nullptr;
+		}
+
+		expect(numAllocations > 0, "The array literal was not recorded");
+		expect(allocationsHaveStatement, "The allocations were not assigned to a statement");
+	}
+};
+
+static ScriptAllocationTracerTests scriptAllocationTracerTests;
+
+#endif
+
+#endif
@@ -74,6 +74,7 @@ void ScriptCreatedComponentWrapper::updateComponent(int propertyIndex, var newVa
 void ScriptCreatedComponentWrapper::changed(var newValue)
 {
 	getScriptComponent()->value = newValue;
+	getScriptComponent()->sendValueChangeMessage();
 
 	dynamic_cast<ProcessorWithScriptingContent*>(getProcessor())->controlCallback(getScriptComponent(), newValue);
 }
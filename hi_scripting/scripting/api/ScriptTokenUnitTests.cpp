@@ -0,0 +1,194 @@
+/*  ===========================================================================
+*
+*   This file is part of HISE.
+*   Copyright 2016 Christoph Hart
+*
+*   HISE is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   HISE is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with HISE.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Commercial licenses for using HISE in an closed source project are
+*   available on request. Please visit the project's website to get more
+*   information about commercial licensing:
+*
+*   http://www.hise.audio/
+*
+*   HISE is based on the JUCE library,
+*   which also must be licenced for commercial applications:
+*
+*   http://www.juce.com
+*
+*   ===========================================================================
+*/
+
+#include "AppConfig.h"
+
+#if HI_RUN_UNIT_TESTS
+
+#include  "JuceHeader.h"
+
+using namespace hise;
+
+/** Checks the precompiled tokens that are embedded into exported projects.
+*
+*	HiseJavascriptEngine::checkPrecompiledTokens() reads the tokens back from the binary data and compares each one
+*	with the output of the tokenizer. If every token has the same type, position, value and comment, the parser builds
+*	the same tree from the data as from the source code.
+*/
+class ScriptTokenTests : public UnitTest
+{
+public:
+
+	ScriptTokenTests() :
+		UnitTest("Testing the precompiled script tokens")
+	{
+
+	}
+
+	void runTest() override
+	{
+		testRoundTrip();
+
+		testRejectedTokens();
+
+		testTiming();
+	}
+
+private:
+
+	void expectRoundTrip(const String& code, const String& name)
+	{
+		const MemoryBlock tokens = HiseJavascriptEngine::createPrecompiledTokens(code);
+
+		expect(tokens.getSize() > 0, name + ": no tokens");
+
+		const Result r = HiseJavascriptEngine::checkPrecompiledTokens(code, tokens);
+
+		expect(r.wasOk(), name + ": " + r.getErrorMessage());
+	}
+
+	void testRoundTrip()
+	{
+		beginTest("Testing saved and loaded tokens");
+
+		expectRoundTrip("", "Empty code");
+		expectRoundTrip("var x = 5;", "Variable");
+		expectRoundTrip("const var a = 0x1F + 017 + 2.5e3 + .5 + 12;", "Numbers");
+		expectRoundTrip("var s = \"a\\\"b\\n\" + 'c' + \"\\u00e4\";", "String literals");
+		expectRoundTrip(String(CharPointer_UTF8("var s = \"\xc3\xa4\xc3\xb6\xc3\xbc\"; // \xe2\x82\xac\nvar t = s;")), "Non-ASCII characters");
+
+		expectRoundTrip("/** The first comment */\n"
+						"const var a = 1;\n"
+						"/***/\n"
+						"const var b = 2;\n"
+						"/* A comment */ /** Another comment */ var c = a >>> b;\n"
+						"// A line comment\n"
+						"var d = c;", "Comments");
+
+		expectRoundTrip("namespace Ns\n"
+						"{\n"
+						"	reg r = 2;\n"
+						"	inline function f(x)\n"
+						"	{\n"
+						"		local y = x * r;\n"
+						"		return y >= 3 ? y : -y;\n"
+						"	}\n"
+						"}\n"
+						"function onNoteOn()\n"
+						"{\n"
+						"	for (i = 0; i < 4; i++) { if (i % 2 == 0 && !false) continue; Ns.f(i); }\n"
+						"}\n", "Namespaces and functions");
+	}
+
+	void testRejectedTokens()
+	{
+		beginTest("Testing tokens that don't match the code");
+
+		const String code = "var x = 5;\nvar y = x * 2;";
+		const MemoryBlock tokens = HiseJavascriptEngine::createPrecompiledTokens(code);
+
+		expect(!HiseJavascriptEngine::checkPrecompiledTokens(code + " ", tokens).wasOk(), "Tokens of other code are used");
+		expect(!HiseJavascriptEngine::checkPrecompiledTokens(code, MemoryBlock()).wasOk(), "Empty tokens are used");
+
+		// A truncated stream is discarded at its end and the tokenizer takes over
+		MemoryBlock truncated(tokens);
+		truncated.setSize(tokens.getSize() - 4);
+
+		const Result r = HiseJavascriptEngine::checkPrecompiledTokens(code, truncated);
+		expect(r.wasOk(), "Truncated tokens: " + r.getErrorMessage());
+
+		expectEquals<int>((int)HiseJavascriptEngine::createPrecompiledTokens("var x = \"unterminated;").getSize(), 0, "Tokens of a syntax error");
+	}
+
+	/** Logs how long tokenizing takes compared to the whole compilation. This is the upper limit of what the
+	*	precompiled tokens can save when an exported project is loaded.
+	*/
+	void testTiming()
+	{
+		beginTest("Measuring the tokenizer");
+
+		String code;
+
+		for (int i = 0; i < 200; i++)
+		{
+			code << "/** Namespace " << i << " */\n"
+				 << "namespace Ns" << i << "\n"
+				 << "{\n"
+				 << "	const var data" << i << " = [1, 2, 3, 0x10, 2.5];\n"
+				 << "	inline function process" << i << "(value, factor)\n"
+				 << "	{\n"
+				 << "		local result = value * factor + data" << i << "[1];\n"
+				 << "		return result > 10.0 ? result : \"small\";\n"
+				 << "	}\n"
+				 << "}\n";
+		}
+
+		const int numRuns = 5;
+
+		double tokenizeTime = 0.0;
+		double compileTime = 0.0;
+
+		MemoryBlock tokens;
+
+		for (int i = 0; i < numRuns; i++)
+		{
+			const double start = Time::getMillisecondCounterHiRes();
+
+			tokens = HiseJavascriptEngine::createPrecompiledTokens(code);
+
+			const double tokenized = Time::getMillisecondCounterHiRes();
+
+			ScopedPointer<HiseJavascriptEngine> engine = new HiseJavascriptEngine(nullptr);
+			const Result r = engine->execute(code);
+
+			const double compiled = Time::getMillisecondCounterHiRes();
+
+			expect(r.wasOk(), r.getErrorMessage());
+
+			tokenizeTime += tokenized - start;
+			compileTime += compiled - tokenized;
+		}
+
+		expect(HiseJavascriptEngine::checkPrecompiledTokens(code, tokens).wasOk(), "Round trip of the timing code");
+
+		tokenizeTime /= (double)numRuns;
+		compileTime /= (double)numRuns;
+
+		logMessage("Source: " + String(code.getNumBytesAsUTF8()) + " bytes, tokens: " + String(tokens.getSize()) + " bytes");
+		logMessage("Tokenizing: " + String(tokenizeTime, 3) + " ms, compiling: " + String(compileTime, 3) + " ms (" + 
+				   String(100.0 * tokenizeTime / jmax(compileTime, 0.001), 1) + "%)");
+	}
+};
+
+static ScriptTokenTests scriptTokenTests;
+
+#endif
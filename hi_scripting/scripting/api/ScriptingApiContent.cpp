@@ -30,16 +30,6 @@
 *   ===========================================================================
 */
 
-#if 0//JUCE_MAC
-#define SEND_MESSAGE(broadcaster) {	broadcaster->sendAllocationFreeChangeMessage(); }
-#elif 0
-#define SEND_MESSAGE(broadcaster) {	if (MessageManager::getInstance()->isThisTheMessageThread()) broadcaster->sendSynchronousChangeMessage(); else broadcaster->sendChangeMessage();}
-#else
-#define SEND_MESSAGE(broadcaster) {	broadcaster->sendChangeMessage();}
-#endif
-
-
-
 
 #define ADD_TO_TYPE_SELECTOR(x) (ScriptComponentPropertyTypeSelector::addToTypeSelector(ScriptComponentPropertyTypeSelector::x, propertyIds.getLast()))
 #define ADD_AS_SLIDER_TYPE(min, max, interval) (ScriptComponentPropertyTypeSelector::addToTypeSelector(ScriptComponentPropertyTypeSelector::SliderSelector, propertyIds.getLast(), min, max, interval))
@@ -111,7 +101,8 @@ ScriptingApi::Content::ScriptComponent::ScriptComponent(ProcessorWithScriptingCo
 	value(0.0),
 	skipRestoring(false),
 	changed(false),
-	customControlCallback(var())
+	customControlCallback(var()),
+	valueIsDirty(false)
 {
 	jassert(propertyTree.isValid());
 
@@ -273,6 +264,8 @@ void ScriptingApi::Content::ScriptComponent::restoreFromValueTree(const ValueTre
 	{
 		value = (double)data;
 	}
+
+	sendValueChangeMessage();
 }
 
 void ScriptingApi::Content::ScriptComponent::doubleClickCallback(const MouseEvent &, Component* /*componentToNotify*/)
@@ -548,9 +541,15 @@ void ScriptingApi::Content::ScriptComponent::setValue(var controlValue)
 		skipRestoring = true;
 	}
 
-    SEND_MESSAGE(this);
+	sendValueChangeMessage();
 };
 
+void ScriptingApi::Content::ScriptComponent::sendValueChangeMessage()
+{
+	if (parent != nullptr)
+		parent->dirtyComponents.push(this);
+}
+
 void ScriptingApi::Content::ScriptComponent::setColour(int colourId, int colourAs32bitHex)
 {
 	switch (colourId)
@@ -903,7 +902,6 @@ ScriptingApi::Content::ScriptSlider::ScriptSlider(ProcessorWithScriptingContent
 ScriptComponent(base, name_),
 styleId(Slider::SliderStyle::RotaryHorizontalVerticalDrag),
 m(HiSlider::Mode::Linear),
-image(nullptr),
 minimum(0.0f),
 maximum(1.0f)
 {
@@ -995,7 +993,7 @@ maximum(1.0f)
 
 ScriptingApi::Content::ScriptSlider::~ScriptSlider()
 {
-	image = Image();
+	image.clear();
 }
 
 ScriptCreatedComponentWrapper * ScriptingApi::Content::ScriptSlider::createComponentWrapper(ScriptContentComponent *content, int index)
@@ -1035,7 +1033,7 @@ void ScriptingApi::Content::ScriptSlider::setScriptObjectPropertyWithChangeMessa
 		if (newValue == "Use default skin" || newValue == "")
 		{
 			setScriptObjectProperty(filmstripImage, "Use default skin");
-			image = Image();
+			image.clear();
 		}
 		else
 		{
@@ -1046,16 +1044,14 @@ void ScriptingApi::Content::ScriptSlider::setScriptObjectPropertyWithChangeMessa
 
 			String poolName = ProjectHandler::Frontend::getSanitiziedFileNameForPoolReference(newValue);
 
-			image = pool->loadFileIntoPool(poolName);
-
-			jassert(image.isValid());
+			image.setReference(pool, poolName);
 
 #else
 
 
 			File actualFile = getExternalFile(newValue);
 
-			image = pool->loadFileIntoPool(actualFile.getFullPathName());
+			image.setReference(pool, actualFile.getFullPathName());
 
 #endif
 		}
@@ -1172,7 +1168,7 @@ void ScriptingApi::Content::ScriptSlider::setMinValue(double min) noexcept
 	if (styleId == Slider::TwoValueHorizontal)
 	{
 		minimum = min;
-		sendChangeMessage();
+		sendValueChangeMessage();
 	}
 	else
 	{
@@ -1185,7 +1181,7 @@ void ScriptingApi::Content::ScriptSlider::setMaxValue(double max) noexcept
 	if (styleId == Slider::TwoValueHorizontal)
 	{
 		maximum = max;
-		sendChangeMessage();
+		sendValueChangeMessage();
 	}
 	else
 	{
@@ -1368,8 +1364,7 @@ struct ScriptingApi::Content::ScriptButton::Wrapper
 };
 
 ScriptingApi::Content::ScriptButton::ScriptButton(ProcessorWithScriptingContent *base, Content* /*parentContent*/, Identifier name, int x, int y, int, int) :
-ScriptComponent(base, name),
-image(nullptr)
+ScriptComponent(base, name)
 {
 	ADD_SCRIPT_PROPERTY(i00, "filmstripImage");	ADD_TO_TYPE_SELECTOR(SelectorTypes::FileSelector);
 	ADD_SCRIPT_PROPERTY(i01, "numStrips");		
@@ -1420,7 +1415,7 @@ void ScriptingApi::Content::ScriptButton::setScriptObjectPropertyWithChangeMessa
 		if (newValue == "Use default skin" || newValue == "")
 		{
 			setScriptObjectProperty(filmstripImage, "");
-			image = Image();
+			image.clear();
 		}
 		else
 		{
@@ -1430,16 +1425,14 @@ void ScriptingApi::Content::ScriptButton::setScriptObjectPropertyWithChangeMessa
 
 			String poolName = ProjectHandler::Frontend::getSanitiziedFileNameForPoolReference(newValue);
 
-			image = pool->loadFileIntoPool(poolName);
-
-			jassert(image.isValid());
+			image.setReference(pool, poolName);
 
 #else
 
 
 			File actualFile = getExternalFile(newValue);
 
-			image = pool->loadFileIntoPool(actualFile.getFullPathName());
+			image.setReference(pool, actualFile.getFullPathName());
 
 #endif
 		}
@@ -2125,7 +2118,7 @@ void ScriptingApi::Content::ScriptSliderPack::setValue(var newValue)
 	{
 		getSliderPackData()->swapData(*array);
 		
-		SEND_MESSAGE(this);
+		sendValueChangeMessage();
 	}
 	else
 	{
@@ -2156,8 +2149,7 @@ struct ScriptingApi::Content::ScriptImage::Wrapper
 };
 
 ScriptingApi::Content::ScriptImage::ScriptImage(ProcessorWithScriptingContent *base, Content* /*parentContent*/, Identifier imageName, int x, int y, int width, int height) :
-ScriptComponent(base, imageName),
-image(nullptr)
+ScriptComponent(base, imageName)
 {
 	deactivatedProperties.add(getIdFor(ScriptComponent::Properties::bgColour));
 	deactivatedProperties.add(getIdFor(ScriptComponent::Properties::itemColour));
@@ -2198,7 +2190,7 @@ image(nullptr)
 
 ScriptingApi::Content::ScriptImage::~ScriptImage()
 {
-	image = Image();
+	image.clear();
 };
 
 
@@ -2259,23 +2251,15 @@ void ScriptingApi::Content::ScriptImage::setImageFile(const String &absoluteFile
 
 	String poolName = ProjectHandler::Frontend::getSanitiziedFileNameForPoolReference(absoluteFileName);
 
-	image = pool->loadFileIntoPool(poolName);
-
-	jassert(image.isValid());
+	image.setReference(pool, poolName);
 
 #else
 
 	File actualFile = getExternalFile(absoluteFileName);
 
-	image = pool->loadFileIntoPool(actualFile.getFullPathName());
+	image.setReference(pool, actualFile.getFullPathName());
 
 #endif
-
-	if (image.isValid())
-	{
-		//setScriptObjectProperty(ScriptComponent::width, image.getWidth(), dontSendNotification);
-		//setScriptObjectProperty(ScriptComponent::height, image.getHeight(), sendNotification);
-	}
 };
 
 
@@ -2289,9 +2273,11 @@ const Image ScriptingApi::Content::ScriptImage::getImage() const
 {
 	
 
-	return image.isNull() ? ImagePool::getEmptyImage(getScriptObjectProperty(ScriptComponent::Properties::width),
-													 getScriptObjectProperty(ScriptComponent::Properties::height)) : 
-							image;
+	Image img = image.get();
+
+	return img.isNull() ? ImagePool::getEmptyImage(getScriptObjectProperty(ScriptComponent::Properties::width),
+												   getScriptObjectProperty(ScriptComponent::Properties::height)) : 
+						  img;
 }
 
 StringArray ScriptingApi::Content::ScriptImage::getItemList() const
@@ -2493,29 +2479,18 @@ void ScriptingApi::Content::ScriptPanel::internalRepaint(bool forceRepaint/*=fal
 		if ((!forceRepaint && !isShowing()) || canvasWidth <= 0 || canvasHeight <= 0)
 		{
 			paintCanvas = Image();
+			displayListIsOutdated = true;
 
 			return;
 		}
 
-		if (paintCanvas.getWidth() != canvasWidth ||
-			paintCanvas.getHeight() != canvasHeight)
-		{
-			paintCanvas = Image(Image::PixelFormat::ARGB, canvasWidth, canvasHeight, !getScriptObjectProperty(Properties::opaque));
-		}
-		else if (!getScriptObjectProperty(Properties::opaque))
-		{
-			paintCanvas.clear(Rectangle<int>(0, 0, canvasWidth, canvasHeight));
-		}
-
-		Graphics g(paintCanvas);
-
-		g.addTransform(AffineTransform::scale((float)getScaleFactorForCanvas()));
-
 		var thisObject(this);
 		var arguments = var(graphics);
 		var::NativeFunctionArgs args(thisObject, &arguments, 1);
 
-		graphics->setGraphics(&g, &paintCanvas);
+		ScriptingObjects::GraphicsObject::DrawActionList::Ptr newActions = new ScriptingObjects::GraphicsObject::DrawActionList(imageBounds);
+
+		graphics->setDrawActionList(newActions);
 
 		Result r = Result::ok();
 
@@ -2531,14 +2506,69 @@ void ScriptingApi::Content::ScriptPanel::internalRepaint(bool forceRepaint/*=fal
 			debugError(dynamic_cast<Processor*>(getScriptProcessor()), r.getErrorMessage());
 		}
 
-		graphics->setGraphics(nullptr, nullptr);
+		graphics->setDrawActionList(nullptr);
+
+		displayListIsOutdated = false;
+
+		// The paint routine produced the same output, so there's no need to rasterize and repaint the component
+		if (paintCanvas.isValid() && drawActions != nullptr && drawActions->hasSameContent(*newActions))
+			return;
+
+		drawActions = newActions;
+
+		rasterizeDrawActions();
+	}
+}
+
+void ScriptingApi::Content::ScriptPanel::rasterizeDrawActions()
+{
+	jassert(drawActions != nullptr);
+
+	const int canvasWidth = drawActions->canvasBounds.getWidth();
+	const int canvasHeight = drawActions->canvasBounds.getHeight();
+
+	if (paintCanvas.getWidth() != canvasWidth ||
+		paintCanvas.getHeight() != canvasHeight)
+	{
+		paintCanvas = Image(Image::PixelFormat::ARGB, canvasWidth, canvasHeight, !getScriptObjectProperty(Properties::opaque));
+	}
+	else if (!getScriptObjectProperty(Properties::opaque))
+	{
+		paintCanvas.clear(Rectangle<int>(0, 0, canvasWidth, canvasHeight));
+	}
 
-		sendChangeMessage();
+	{
+		Graphics g(paintCanvas);
+
+		g.addTransform(AffineTransform::scale((float)getScaleFactorForCanvas()));
 
-		repaintNotifier.sendSynchronousChangeMessage();
+		drawActions->draw(g, paintCanvas);
 	}
 
-	//SEND_MESSAGE(this);
+	sendValueChangeMessage();
+
+	repaintNotifier.sendSynchronousChangeMessage();
+}
+
+bool ScriptingApi::Content::ScriptPanel::repaintFromDrawActions()
+{
+	if (drawActions == nullptr || displayListIsOutdated || usesClippedFixedImage)
+		return false;
+
+	if (!isShowing())
+	{
+		// Release the canvas but keep the actions for the next time it becomes visible
+		paintCanvas = Image();
+		return true;
+	}
+
+	if (drawActions->canvasBounds != getBoundsForImage())
+		return false;
+
+	if (!paintCanvas.isValid())
+		rasterizeDrawActions();
+
+	return true;
 }
 
 void ScriptingApi::Content::ScriptPanel::setLoadingCallback(var loadingCallback)
@@ -2670,30 +2700,30 @@ void ScriptingApi::Content::ScriptPanel::loadImage(String imageName, String pret
 
 	ImagePool *pool = getProcessor()->getMainController()->getSampleManager().getImagePool();
 
+	// The image is decoded when it is drawn for the first time
+	ImagePool::LazyImage newImage;
+
 #if USE_FRONTEND
 
 	String poolName = ProjectHandler::Frontend::getSanitiziedFileNameForPoolReference(imageName);
 
-	const Image newImage = pool->loadFileIntoPool(poolName);
-
-	jassert(newImage.isValid());
+	newImage.setReference(pool, poolName);
 
 #else
 
 	File actualFile = getExternalFile(imageName);
 
-	const Image newImage = pool->loadFileIntoPool(actualFile.getFullPathName());
+	if (!actualFile.existsAsFile())
+	{
+		reportScriptError("Image " + actualFile.getFullPathName() + " not found. ");
+		return;
+	}
+
+	newImage.setReference(pool, actualFile.getFullPathName());
 
 #endif
 
-	if (newImage.isValid())
-	{
-		loadedImages.push_back(NamedImage(newImage, prettyName, imageName));
-	}
-	else
-	{
-		BACKEND_ONLY(reportScriptError("Image " + actualFile.getFullPathName() + " not found. "));
-	}
+	loadedImages.push_back(NamedImage(newImage, prettyName, imageName));
 }
 
 StringArray ScriptingApi::Content::ScriptPanel::getItemList() const
@@ -2759,8 +2789,11 @@ void ScriptingApi::Content::ScriptPanel::setImage(String imageName, int xOffset,
 {
 	paintRoutine = var();
 	usesClippedFixedImage = true;
+	drawActions = nullptr;
 
-	Image toUse = getLoadedImage(imageName);
+	auto loadedImage = getLoadedImage(imageName);
+
+	Image toUse = loadedImage != nullptr ? loadedImage->get() : Image();
 
 	auto b = getBoundsForImage();
 
@@ -2824,7 +2857,7 @@ void ScriptingApi::Content::ScriptPanel::showAsPopup(bool closeOtherPopups)
 
 	repaintThisAndAllChildren();
 
-	sendChangeMessage();
+	sendValueChangeMessage();
 }
 
 void ScriptingApi::Content::ScriptPanel::closeAsPopup()
@@ -2833,7 +2866,7 @@ void ScriptingApi::Content::ScriptPanel::closeAsPopup()
 
 	repaintThisAndAllChildren();
 
-	sendChangeMessage();
+	sendValueChangeMessage();
 }
 
 void ScriptingApi::Content::ScriptPanel::repaintThisAndAllChildren()
@@ -2842,7 +2875,11 @@ void ScriptingApi::Content::ScriptPanel::repaintThisAndAllChildren()
 	ChildIterator<ScriptPanel> iter(this);
 
 	while (auto childPanel = iter.getNextChildComponent())
-		childPanel->repaint();
+	{
+		// Replays the last recorded paint routine if nothing has changed since then
+		if (!childPanel->repaintFromDrawActions())
+			childPanel->repaint();
+	}
 }
 
 void ScriptingApi::Content::ScriptPanel::AsyncControlCallbackSender::handleAsyncUpdate()
@@ -3151,7 +3188,7 @@ void ScriptingApi::Content::ScriptAudioWaveform::restoreFromValueTree(const Valu
 			getAudioProcessor()->setRange(range);
 
 			//WHYTHEFUCK
-			sendChangeMessage();
+			sendValueChangeMessage();
 		}
 	}
 }
@@ -3360,6 +3397,7 @@ void ScriptingApi::Content::ScriptFloatingTile::setScriptObjectPropertyWithChang
 
 ScriptingApi::Content::Content(ProcessorWithScriptingContent *p) :
 ScriptingObject(p),
+dirtyComponents(*this),
 height(50),
 width(-1),
 name(String()),
@@ -3415,10 +3453,78 @@ ScriptingApi::Content::~Content()
 
 	contentPropertyData = ValueTree();
 
+	dirtyComponents.clear();
+
 	masterReference.clear();
 	components.clear();
 }
 
+ScriptingApi::Content::DirtyComponentQueue::DirtyComponentQueue(Content& parent_) :
+	parent(parent_),
+	queue(4096),
+	overflow(false)
+{
+
+}
+
+void ScriptingApi::Content::DirtyComponentQueue::push(ScriptComponent* sc)
+{
+	// Already in the queue...
+	if (sc->valueIsDirty.exchange(true))
+		return;
+
+	{
+		SpinLock::ScopedLockType sl(pushLock);
+
+		if (!queue.push(ScriptComponent::Ptr(sc)))
+			overflow.store(true);
+	}
+
+	triggerAsyncUpdate();
+}
+
+void ScriptingApi::Content::DirtyComponentQueue::clear()
+{
+	cancelPendingUpdate();
+
+	ScriptComponent::Ptr sc;
+
+	while (queue.pop(sc))
+		sc->valueIsDirty.store(false);
+
+	sc = nullptr;
+}
+
+void ScriptingApi::Content::DirtyComponentQueue::handleAsyncUpdate()
+{
+	ReferenceCountedArray<ScriptComponent> changedComponents;
+
+	ScriptComponent::Ptr sc;
+
+	while (queue.pop(sc))
+		changedComponents.add(sc);
+
+	sc = nullptr;
+
+	// There were too many changes, so update every component
+	if (overflow.exchange(false))
+		changedComponents = parent.components;
+
+	for (auto c : changedComponents)
+		c->valueIsDirty.store(false);
+
+	if (changedComponents.isEmpty())
+		return;
+
+	for (int i = 0; i < parent.valueListeners.size(); i++)
+	{
+		if (parent.valueListeners[i] != nullptr)
+			parent.valueListeners[i]->componentValuesChanged(changedComponents);
+		else
+			parent.valueListeners.remove(i--);
+	}
+}
+
 
 
 
@@ -3914,8 +4020,18 @@ void ScriptingApi::Content::restoreAllControlsFromPreset(const String &fileName)
 #endif
 }
 
-void ScriptingApi::Content::restoreAllControlsFromPreset(const ValueTree &preset)
+void ScriptingApi::Content::restoreAllControlsFromPreset(const ValueTree &preset, bool skipUnchangedValues)
 {
+	Array<var> previousValues;
+
+	if (skipUnchangedValues)
+	{
+		previousValues.ensureStorageAllocated(components.size());
+
+		for (int i = 0; i < components.size(); i++)
+			previousValues.add(components[i]->getValue());
+	}
+
 	restoreFromValueTree(preset);
 
 	StringArray macroNames;
@@ -3942,6 +4058,9 @@ void ScriptingApi::Content::restoreAllControlsFromPreset(const ValueTree &preset
 
 		var v = components[i]->getValue();
 
+		if (skipUnchangedValues && isUnchangedValue(components[i].get(), previousValues[i], v))
+			continue;
+
 		if (dynamic_cast<ScriptingApi::Content::ScriptLabel*>(components[i].get()) != nullptr)
 		{
 			getScriptProcessor()->controlCallback(components[i], v);
@@ -3970,6 +4089,21 @@ void ScriptingApi::Content::restoreAllControlsFromPreset(const ValueTree &preset
 
 
 
+bool ScriptingApi::Content::isUnchangedValue(ScriptComponent* sc, const var& previousValue, const var& newValue)
+{
+	const bool isPlainValueControl = dynamic_cast<ScriptSlider*>(sc) != nullptr ||
+									 dynamic_cast<ScriptButton*>(sc) != nullptr ||
+									 dynamic_cast<ScriptComboBox*>(sc) != nullptr;
+
+	if (!isPlainValueControl)
+		return false;
+
+	// An undefined value means the callback was never executed
+	const bool isNumber = previousValue.isInt() || previousValue.isInt64() || previousValue.isDouble() || previousValue.isBool();
+
+	return isNumber && !newValue.isObject() && (double)previousValue == (double)newValue;
+}
+
 ValueTree ScriptingApi::Content::exportAsValueTree() const
 {
 	ValueTree v("Content");
@@ -4212,7 +4346,6 @@ void ScriptingApi::Content::sendRebuildMessage()
 
 #undef ADD_TO_TYPE_SELECTOR
 #undef ADD_AS_SLIDER_TYPE
-#undef SEND_MESSAGE
 
 Identifier ScriptingApi::Content::Helpers::getUniqueIdentifier(Content* c, const String& id)
 {
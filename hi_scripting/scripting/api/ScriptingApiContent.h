@@ -219,6 +219,32 @@ public:
 		WeakReference<RebuildListener>::Master masterReference;
 	};
 
+	struct ScriptComponent;
+
+	/** A listener that gets notified about components with a changed value.
+	*
+	*	Instead of checking all components, the listener only gets the components that called sendValueChangeMessage()
+	*	since the last update.
+	*/
+	class ValueListener
+	{
+	public:
+
+		virtual ~ValueListener()
+		{
+			masterReference.clear();
+		}
+
+		/** Called on the message thread with all components whose value has changed since the last call. */
+		virtual void componentValuesChanged(const ReferenceCountedArray<ScriptComponent>& changedComponents) = 0;
+
+	private:
+
+		friend class WeakReference<ValueListener>;
+
+		WeakReference<ValueListener>::Master masterReference;
+	};
+
 	class PluginParameterConnector
 	{
 	public:
@@ -463,6 +489,14 @@ public:
 		void setChanged(bool isChanged = true) noexcept{ changed = isChanged; }
 		bool isChanged() const noexcept{ return changed; };
 
+		/** Marks the value as changed so the interface will be updated. 
+		*
+		*	This can be called from any thread, but it is not lock free: the first call after an update takes a short
+		*	spin lock to add the component to the queue and triggers an async update. Further calls return immediately
+		*	until the interface has been updated.
+		*/
+		void sendValueChangeMessage();
+
 		var value;
 		Identifier name;
 		Content *parent;
@@ -586,6 +620,10 @@ public:
 
         int connectedMacroIndex = -1;
         bool macroRecursionProtection = false;
+
+		friend class Content;
+
+		std::atomic<bool> valueIsDirty;
         
 		JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ScriptComponent);
 	};
@@ -669,12 +707,12 @@ public:
 
 		HiSlider::Mode m = HiSlider::Mode::Linear;
 		Slider::SliderStyle styleId;
-		Image getImage() const { return image; };
+		Image getImage() const { return image.get(); };
 
 	private:
 
 		double minimum, maximum;
-		Image image;
+		ImagePool::LazyImage image;
 
 		JUCE_DECLARE_WEAK_REFERENCEABLE(ScriptSlider)
 	};
@@ -704,7 +742,7 @@ public:
 		Identifier 	getObjectName() const override { return getStaticObjectName(); }
 		bool isAutomatable() const override { return true; }
 		ScriptCreatedComponentWrapper *createComponentWrapper(ScriptContentComponent *content, int index) override;
-		const Image getImage() const { return image; };
+		const Image getImage() const { return image.get(); };
 		void setScriptObjectPropertyWithChangeMessage(const Identifier &id, var newValue, NotificationType notifyEditor = sendNotification) override;
 		StringArray getOptionsFor(const Identifier &id) override;
 
@@ -735,7 +773,7 @@ public:
 
 		var popupData;
 
-		Image image;
+		ImagePool::LazyImage image;
 
 		JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ScriptButton)
 		JUCE_DECLARE_WEAK_REFERENCEABLE(ScriptButton)
@@ -1056,7 +1094,7 @@ public:
 
 	private:
 
-		Image image;
+		ImagePool::LazyImage image;
 
 		JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(ScriptImage);
 		JUCE_DECLARE_WEAK_REFERENCEABLE(ScriptImage);
@@ -1229,15 +1267,16 @@ public:
         
 		void timerCallback() override;
 
-		Image getLoadedImage(const String &prettyName) const
+		/** Returns the image that was loaded with loadImage() or nullptr if there is no image with this name. */
+		const ImagePool::LazyImage* getLoadedImage(const String &prettyName) const
 		{
 			for (size_t i = 0; i < loadedImages.size(); i++)
 			{
 				if (std::get<(int)NamedImageEntries::PrettyName>(loadedImages[i]) == prettyName)
-					return std::get<(int)NamedImageEntries::Image>(loadedImages[i]);
+					return &std::get<(int)NamedImageEntries::Image>(loadedImages[i]);
 			}
 
-			return Image();
+			return nullptr;
 		};
 
 		Rectangle<int> getDragBounds() const;
@@ -1286,6 +1325,12 @@ public:
 		
 		void internalRepaint(bool forceRepaint=false);
 
+		/** Draws the recorded actions onto the paint canvas and notifies the component. */
+		void rasterizeDrawActions();
+
+		/** Uses the last recorded actions instead of calling the paint routine. Returns false if they can't be used. */
+		bool repaintFromDrawActions();
+
 		struct AsyncControlCallbackSender : public AsyncUpdater
 		{
 			AsyncControlCallbackSender(ScriptPanel* parent_, ProcessorWithScriptingContent* p_) : parent(parent_), p(p_) {};
@@ -1348,6 +1393,9 @@ public:
 
 		Image paintCanvas;
 
+		ScriptingObjects::GraphicsObject::DrawActionList::Ptr drawActions;
+		bool displayListIsOutdated = true;
+
 		enum class NamedImageEntries
 		{
 			Image=0,
@@ -1355,7 +1403,7 @@ public:
 			FileName
 		};
 
-		using NamedImage =	std::tuple < const Image, String, String > ;
+		using NamedImage =	std::tuple < ImagePool::LazyImage, String, String > ;
 		
 		std::vector<NamedImage> loadedImages;
 
@@ -1691,8 +1739,12 @@ public:
 
 	// ================================================================================================================
 
-	// Restores the content and sets the attributes so that the macros and the control callbacks gets executed.
-	void restoreAllControlsFromPreset(const ValueTree &preset);
+	/** Restores the content and sets the attributes so that the macros and the control callbacks gets executed.
+	*
+	*	If skipUnchangedValues is true, the callbacks of sliders, buttons and comboboxes whose value is not changed by the 
+	*	preset are not executed (tables, panels and labels are always restored).
+	*/
+	void restoreAllControlsFromPreset(const ValueTree &preset, bool skipUnchangedValues=false);
 
 	Colour getColour() const { return colour; };
 	void endInitialization();
@@ -1714,6 +1766,16 @@ public:
 		rebuildListeners.removeAllInstancesOf(listenerToRemove);
 	}
 
+	void addValueListener(ValueListener* listener)
+	{
+		valueListeners.addIfNotAlreadyThere(listener);
+	}
+
+	void removeValueListener(ValueListener* listenerToRemove)
+	{
+		valueListeners.removeAllInstancesOf(listenerToRemove);
+	}
+
 	void cleanJavascriptObjects();
 
 	UpdateDispatcher* getUpdateDispatcher() { return &updateDispatcher; }
@@ -1891,10 +1953,42 @@ public:
     
 private:
 
+	/** Checks if a slider, button or combobox has the same value before and after the preset was restored. */
+	static bool isUnchangedValue(ScriptComponent* sc, const var& previousValue, const var& newValue);
+
     bool isRebuilding = false;
     
 	UpdateDispatcher updateDispatcher;
 
+	/** Collects the components with a changed value and notifies the value listeners once per update.
+	*
+	*	Every component is only added once until the next update (it uses an atomic flag in the component).
+	*	The queue only supports a single writer, so the push is guarded by a spin lock. It uses a plain AsyncUpdater
+	*	because a push during the update must trigger another update.
+	*/
+	struct DirtyComponentQueue : public AsyncUpdater
+	{
+		DirtyComponentQueue(Content& parent_);
+
+		void push(ScriptComponent* sc);
+
+		void clear();
+
+		void handleAsyncUpdate() override;
+
+		Content& parent;
+
+		SpinLock pushLock;
+		hise::LockfreeQueue<ScriptComponent::Ptr> queue;
+		std::atomic<bool> overflow;
+
+		JUCE_DECLARE_NON_COPYABLE(DirtyComponentQueue);
+	};
+
+	DirtyComponentQueue dirtyComponents;
+
+	Array<WeakReference<ValueListener>> valueListeners;
+
 	ReferenceCountedArray<ScriptPanel> popupPanels;
 
 	bool allowAsyncFunctions = false;
@@ -74,26 +74,22 @@ var ScriptingObjects::MidiList::getAssignedValue(int index) const				 { return g
 void ScriptingObjects::MidiList::fill(int valueToFill)
 {
 	for (int i = 0; i < 128; i++) data[i] = valueToFill;
-	empty = false;
-	numValues = 128;
+
+	numValues = valueToFill != -1 ? 128 : 0;
 }
 
 void ScriptingObjects::MidiList::clear()
 {
 	fill(-1);
-	empty = true;
-	numValues = 0;
 }
 
 int ScriptingObjects::MidiList::getValue(int index) const
 {
-	if (index < 127 && index >= 0) return (int)data[index]; else return -1;
+	if (index < 128 && index >= 0) return (int)data[index]; else return -1;
 }
 
 int ScriptingObjects::MidiList::getValueAmount(int valueToCheck)
 {
-	if (empty) return 0;
-
 	int amount = 0;
 
 	for (int i = 0; i < 128; i++)
@@ -106,7 +102,6 @@ int ScriptingObjects::MidiList::getValueAmount(int valueToCheck)
 
 int ScriptingObjects::MidiList::getIndex(int value) const
 {
-	if (empty) return -1;
 	for (int i = 0; i < 128; i++)
 	{
 		if (data[i] == value)
@@ -118,28 +113,17 @@ int ScriptingObjects::MidiList::getIndex(int value) const
 	return -1;
 }
 
+void ScriptingObjects::MidiList::updateNumSetValues() noexcept
+{
+	numValues = 128 - getValueAmount(-1);
+}
+
 void ScriptingObjects::MidiList::setValue(int index, int value)
 {
 	if (index >= 0 && index < 128)
 	{
-        if (value == -1)
-		{
-            if(data[index] != -1)
-            {
-                numValues--;
-                if (numValues == 0) empty = true;
-            }
-		}
-		else
-		{
-            if(data[index] == -1)
-            {
-                numValues++;
-                empty = false;
-            }
-            
-            data[index] = value;
-		}
+		valueChanged(data[index], value);
+		data[index] = value;
 	}
 }
 
@@ -154,6 +138,8 @@ void ScriptingObjects::MidiList::restoreFromBase64String(String base64encodedVal
 {
 	MemoryOutputStream stream(data, sizeof(int) * 128);
 	Base64::convertFromBase64(stream, base64encodedValues);
+
+	updateNumSetValues();
 }
 
 void addScriptParameters(ConstScriptingObject* this_, Processor* p)
@@ -2025,96 +2011,113 @@ rectangleResult(Result::ok())
 ScriptingObjects::GraphicsObject::~GraphicsObject()
 {
 	parent = nullptr;
-	imageToDraw = nullptr;
-	g = nullptr;
+	actionList = nullptr;
 }
 
+typedef ScriptingObjects::GraphicsObject::DrawActionList::ActionId DrawActionId;
+
 void ScriptingObjects::GraphicsObject::fillAll(int colour)
 {
 	initGraphics();
 	Colour c((uint32)colour);
 
-	g->fillAll(c);
-
-	
+	actionList->add(DrawActionId::fillAll, [c](Graphics& g, Image&) { g.fillAll(c); }, c);
 }
 
 void ScriptingObjects::GraphicsObject::fillRect(var area)
 {
 	initGraphics();
 
-	g->fillRect(getRectangleFromVar(area));
+	auto r = getRectangleFromVar(area);
+
+	actionList->add(DrawActionId::fillRect, [r](Graphics& g, Image&) { g.fillRect(r); }, r);
 }
 
 void ScriptingObjects::GraphicsObject::drawRect(var area, float borderSize)
 {
 	initGraphics();
 
+	auto r = getRectangleFromVar(area);
 	auto bs = (float)borderSize;
+	bs = SANITIZED(bs);
 
-	g->drawRect(getRectangleFromVar(area), SANITIZED(bs));
+	actionList->add(DrawActionId::drawRect, [r, bs](Graphics& g, Image&) { g.drawRect(r, bs); }, r, bs);
 }
 
 void ScriptingObjects::GraphicsObject::fillRoundedRectangle(var area, float cornerSize)
 {
 	initGraphics();
 
+	auto r = getRectangleFromVar(area);
     auto cs = (float)cornerSize;
+	cs = SANITIZED(cs);
     
-	g->fillRoundedRectangle(getRectangleFromVar(area), SANITIZED(cs));
+	actionList->add(DrawActionId::fillRoundedRectangle, [r, cs](Graphics& g, Image&) { g.fillRoundedRectangle(r, cs); }, r, cs);
 }
 
 void ScriptingObjects::GraphicsObject::drawRoundedRectangle(var area, float cornerSize, float borderSize)
 {
 	initGraphics();
 
+	auto r = getRectangleFromVar(area);
     auto cs = (float)cornerSize;
     auto bs = (float)borderSize;
+	cs = SANITIZED(cs);
+	bs = SANITIZED(bs);
     
-    g->drawRoundedRectangle(getRectangleFromVar(area), SANITIZED(cs), SANITIZED(bs));
+	actionList->add(DrawActionId::drawRoundedRectangle, [r, cs, bs](Graphics& g, Image&) { g.drawRoundedRectangle(r, cs, bs); }, r, cs, bs);
 }
 
 void ScriptingObjects::GraphicsObject::drawHorizontalLine(int y, float x1, float x2)
 {
 	initGraphics();
 
-    
-    
-	g->drawHorizontalLine(y, SANITIZED(x1), SANITIZED(x2));
+	x1 = SANITIZED(x1);
+	x2 = SANITIZED(x2);
+
+	actionList->add(DrawActionId::drawHorizontalLine, [y, x1, x2](Graphics& g, Image&) { g.drawHorizontalLine(y, x1, x2); }, y, x1, x2);
 }
 
 void ScriptingObjects::GraphicsObject::setOpacity(float alphaValue)
 {
 	initGraphics();
 
-	
-
-	g->setOpacity(alphaValue);
+	actionList->add(DrawActionId::setOpacity, [alphaValue](Graphics& g, Image&) { g.setOpacity(alphaValue); }, alphaValue);
 }
 
 void ScriptingObjects::GraphicsObject::drawLine(float x1, float x2, float y1, float y2, float lineThickness)
 {
 	initGraphics();
 
-	g->drawLine(SANITIZED(x1), SANITIZED(y1), SANITIZED(x2), SANITIZED(y2), SANITIZED(lineThickness));
+	Line<float> l(SANITIZED(x1), SANITIZED(y1), SANITIZED(x2), SANITIZED(y2));
+	const float t = SANITIZED(lineThickness);
+
+	actionList->add(DrawActionId::drawLine, [l, t](Graphics& g, Image&) { g.drawLine(l, t); }, l.getStart(), l.getEnd(), t);
 }
 
 void ScriptingObjects::GraphicsObject::setColour(int colour)
 {
-	
-	currentColour = Colour((uint32)colour);
-	g->setColour(currentColour);
+	initGraphics();
 
+	currentColour = Colour((uint32)colour);
 	useGradient = false;
+
+	auto c = currentColour;
+
+	actionList->add(DrawActionId::setColour, [c](Graphics& g, Image&) { g.setColour(c); }, c);
 }
 
 void ScriptingObjects::GraphicsObject::setFont(String fontName, float fontSize)
 {
+	initGraphics();
+
 	MainController *mc = getScriptProcessor()->getMainController_();
 
 	currentFont = mc->getFontFromString(fontName, SANITIZED(fontSize));
 
-	g->setFont(currentFont);
+	auto f = currentFont;
+
+	actionList->add(DrawActionId::setFont, [f](Graphics& g, Image&) { g.setFont(f); }, f);
 }
 
 void ScriptingObjects::GraphicsObject::drawText(String text, var area)
@@ -2125,9 +2128,13 @@ void ScriptingObjects::GraphicsObject::drawText(String text, var area)
 
 	currentFont.setHeightWithoutChangingWidth(r.getHeight());
 
-	g->setFont(currentFont);
+	auto f = currentFont;
 
-	g->drawText(text, r, Justification::centred);
+	actionList->add(DrawActionId::drawText, [f, text, r](Graphics& g, Image&)
+	{
+		g.setFont(f);
+		g.drawText(text, r, Justification::centred);
+	}, f, text, r, (int)Justification::centred);
 }
 
 void ScriptingObjects::GraphicsObject::drawAlignedText(String text, var area, String alignment)
@@ -2143,14 +2150,19 @@ void ScriptingObjects::GraphicsObject::drawAlignedText(String text, var area, St
 	if (re.failed())
 		reportScriptError(re.getErrorMessage());
 
+	auto f = currentFont;
 
-	g->setFont(currentFont);
-
-	g->drawText(text, r, just);
+	actionList->add(DrawActionId::drawText, [f, text, r, just](Graphics& g, Image&)
+	{
+		g.setFont(f);
+		g.drawText(text, r, just);
+	}, f, text, r, just.getFlags());
 }
 
 void ScriptingObjects::GraphicsObject::setGradientFill(var gradientData)
 {
+	initGraphics();
+
 	if (gradientData.isArray())
 	{
 		Array<var>* data = gradientData.getArray();
@@ -2162,7 +2174,9 @@ void ScriptingObjects::GraphicsObject::setGradientFill(var gradientData)
 
 			useGradient = true;
 
-			g->setGradientFill(currentGradient);
+			auto gradient = currentGradient;
+
+			actionList->add(DrawActionId::setGradientFill, [gradient](Graphics& g, Image&) { g.setGradientFill(gradient); }, gradient);
 		}
 		else
 		{
@@ -2181,14 +2195,18 @@ void ScriptingObjects::GraphicsObject::drawEllipse(var area, float lineThickness
 {
 	initGraphics();
 
-	g->drawEllipse(getRectangleFromVar(area), lineThickness);
+	auto r = getRectangleFromVar(area);
+
+	actionList->add(DrawActionId::drawEllipse, [r, lineThickness](Graphics& g, Image&) { g.drawEllipse(r, lineThickness); }, r, lineThickness);
 }
 
 void ScriptingObjects::GraphicsObject::fillEllipse(var area)
 {
 	initGraphics();
 
-	g->fillEllipse(getRectangleFromVar(area));
+	auto r = getRectangleFromVar(area);
+
+	actionList->add(DrawActionId::fillEllipse, [r](Graphics& g, Image&) { g.fillEllipse(r); }, r);
 }
 
 void ScriptingObjects::GraphicsObject::drawImage(String imageName, var area, int /*xOffset*/, int yOffset)
@@ -2197,7 +2215,9 @@ void ScriptingObjects::GraphicsObject::drawImage(String imageName, var area, int
 
 	auto sc = dynamic_cast<ScriptingApi::Content::ScriptPanel*>(parent);
 
-	const Image img = sc->getLoadedImage(imageName);
+	auto loadedImage = sc->getLoadedImage(imageName);
+
+	const Image img = loadedImage != nullptr ? loadedImage->get() : Image();
 
 	if (img.isValid())
 	{
@@ -2206,8 +2226,13 @@ void ScriptingObjects::GraphicsObject::drawImage(String imageName, var area, int
         if(r.getWidth() != 0)
         {
             const double scaleFactor = (double)img.getWidth() / (double)r.getWidth();
+			const int sourceHeight = (int)((double)r.getHeight() * scaleFactor);
             
-            g->drawImage(img, (int)r.getX(), (int)r.getY(), (int)r.getWidth(), (int)r.getHeight(), 0, yOffset, (int)img.getWidth(), (int)((double)r.getHeight() * scaleFactor));
+			// The pool key identifies the file and its version, so a freed bitmap that is reused can't match
+			actionList->add(DrawActionId::drawImage, [img, r, yOffset, sourceHeight](Graphics& g, Image&)
+			{
+				g.drawImage(img, (int)r.getX(), (int)r.getY(), (int)r.getWidth(), (int)r.getHeight(), 0, yOffset, (int)img.getWidth(), sourceHeight);
+			}, loadedImage->getHashCode(), img.getWidth(), img.getHeight(), r, yOffset, sourceHeight);
         }        
 	}
 	else
@@ -2227,7 +2252,7 @@ void ScriptingObjects::GraphicsObject::drawDropShadow(var area, int colour, int
 
 	auto r = getIntRectangleFromVar(area);
 
-	shadow.drawForRectangle(*g, r);
+	actionList->add(DrawActionId::drawDropShadow, [shadow, r](Graphics& g, Image&) { shadow.drawForRectangle(g, r); }, shadow.colour, radius, r);
 }
 
 void ScriptingObjects::GraphicsObject::drawTriangle(var area, float angle, float lineThickness)
@@ -2243,8 +2268,7 @@ void ScriptingObjects::GraphicsObject::drawTriangle(var area, float angle, float
 	auto r = getRectangleFromVar(area);
 	p.scaleToFit(r.getX(), r.getY(), r.getWidth(), r.getHeight(), false);
 	
-	PathStrokeType pst(lineThickness);
-	g->strokePath(p, pst);
+	actionList->add(DrawActionId::drawTriangle, [p, lineThickness](Graphics& g, Image&) { g.strokePath(p, PathStrokeType(lineThickness)); }, p, lineThickness);
 }
 
 void ScriptingObjects::GraphicsObject::fillTriangle(var area, float angle)
@@ -2260,7 +2284,7 @@ void ScriptingObjects::GraphicsObject::fillTriangle(var area, float angle)
 	auto r = getRectangleFromVar(area);
 	p.scaleToFit(r.getX(), r.getY(), r.getWidth(), r.getHeight(), false);
 
-	g->fillPath(p);
+	actionList->add(DrawActionId::fillTriangle, [p](Graphics& g, Image&) { g.fillPath(p); }, p);
 }
 
 void ScriptingObjects::GraphicsObject::addDropShadowFromAlpha(int colour, int radius)
@@ -2272,20 +2296,31 @@ void ScriptingObjects::GraphicsObject::addDropShadowFromAlpha(int colour, int ra
 	shadow.colour = Colour((uint32)colour);
 	shadow.radius = radius;
 
-    Graphics g2(*imageToDraw);
-    
 #if JUCE_MAC || HISE_IOS
     const double scaleFactor = dynamic_cast<ScriptingApi::Content::ScriptPanel*>(parent)->parent->usesDoubleResolution() ? 2.0 : 1.0;
-    
-    // don't ask why...
-    g2.addTransform(AffineTransform::scale((float)(1.0 / scaleFactor)));
+#else
+	const double scaleFactor = 1.0;
 #endif
-    
-	shadow.drawForImage(g2, *imageToDraw);
+
+	actionList->add(DrawActionId::addDropShadowFromAlpha, [shadow, scaleFactor](Graphics&, Image& canvas)
+	{
+		Graphics g2(canvas);
+
+#if JUCE_MAC || HISE_IOS
+		// don't ask why...
+		g2.addTransform(AffineTransform::scale((float)(1.0 / scaleFactor)));
+#else
+		ignoreUnused(scaleFactor);
+#endif
+
+		shadow.drawForImage(g2, canvas);
+	}, shadow.colour, radius, (float)scaleFactor);
 }
 
 void ScriptingObjects::GraphicsObject::fillPath(var path, var area)
 {
+	initGraphics();
+
 	if (PathObject* pathObject = dynamic_cast<PathObject*>(path.getObject()))
 	{
 		Path p = pathObject->getPath();
@@ -2296,12 +2331,14 @@ void ScriptingObjects::GraphicsObject::fillPath(var path, var area)
 			p.scaleToFit(r.getX(), r.getY(), r.getWidth(), r.getHeight(), false);
 		}
 
-		g->fillPath(p);
+		actionList->add(DrawActionId::fillPath, [p](Graphics& g, Image&) { g.fillPath(p); }, p);
 	}
 }
 
 void ScriptingObjects::GraphicsObject::drawPath(var path, var area, var thickness)
 {
+	initGraphics();
+
 	if (PathObject* pathObject = dynamic_cast<PathObject*>(path.getObject()))
 	{
 		Path p = pathObject->getPath();
@@ -2313,8 +2350,9 @@ void ScriptingObjects::GraphicsObject::drawPath(var path, var area, var thicknes
 		}
 
         auto t = (float)thickness;
+		t = SANITIZED(t);
         
-		g->strokePath(p, PathStrokeType(SANITIZED(t)));
+		actionList->add(DrawActionId::drawPath, [p, t](Graphics& g, Image&) { g.strokePath(p, PathStrokeType(t)); }, p, t);
 	}
 }
 
@@ -2328,7 +2366,7 @@ void ScriptingObjects::GraphicsObject::rotate(var angleInRadian, var center)
     
 	auto a = AffineTransform::rotation(SANITIZED(air), c.getX(), c.getY());
 
-	g->addTransform(a);
+	actionList->add(DrawActionId::rotate, [a](Graphics& g, Image&) { g.addTransform(a); }, a);
 }
 
 Point<float> ScriptingObjects::GraphicsObject::getPointFromVar(const var& data)
@@ -2360,8 +2398,41 @@ Rectangle<int> ScriptingObjects::GraphicsObject::getIntRectangleFromVar(const va
 
 void ScriptingObjects::GraphicsObject::initGraphics()
 {
-	if (g == nullptr) reportScriptError("Graphics not initialised");
+	if (actionList == nullptr) reportScriptError("Graphics not initialised");
+
+}
+
+bool ScriptingObjects::GraphicsObject::DrawActionList::hasSameContent(const DrawActionList& other) const
+{
+	return canvasBounds == other.canvasBounds && 
+		   signature.getDataSize() == other.signature.getDataSize() &&
+		   memcmp(signature.getData(), other.signature.getData(), signature.getDataSize()) == 0;
+}
 
+void ScriptingObjects::GraphicsObject::DrawActionList::write(const Font& f)
+{
+	write(f.toString());
+	write(f.getHorizontalScale());
+	write(f.getExtraKerningFactor());
+}
+
+void ScriptingObjects::GraphicsObject::DrawActionList::write(const ColourGradient& gradient)
+{
+	write(gradient.point1);
+	write(gradient.point2);
+	write((int)gradient.isRadial);
+
+	for (int i = 0; i < gradient.getNumColours(); i++)
+	{
+		write(gradient.getColour(i));
+		write((float)gradient.getColourPosition(i));
+	}
+}
+
+void ScriptingObjects::GraphicsObject::DrawActionList::write(const AffineTransform& t)
+{
+	write(t.mat00); write(t.mat01); write(t.mat02);
+	write(t.mat10); write(t.mat11); write(t.mat12);
 }
 
 struct ScriptingObjects::ScriptingMessageHolder::Wrapper
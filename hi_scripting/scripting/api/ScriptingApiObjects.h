@@ -142,7 +142,7 @@ public:
 		int getIndex(int value) const;
 
 		/** Checks if the list contains any data. */
-		bool isEmpty() const { return empty; }
+		bool isEmpty() const { return numValues == 0; }
 
 		/** Returns the number of values that are not -1. */
 		int getNumSetValues() const { return numValues; }
@@ -158,12 +158,23 @@ public:
 
 		// ============================================================================================================
 
+		/** Returns the raw data so that a TypedArray can operate on it without copying. */
+		int* getData() noexcept { return data; }
+
+		/** Updates the number of set values after a TypedArray changed a single element of the data. */
+		void valueChanged(int oldValue, int newValue) noexcept
+		{
+			numValues += (int)(newValue != -1) - (int)(oldValue != -1);
+		}
+
+		/** Counts the set values after a TypedArray changed multiple elements of the data. */
+		void updateNumSetValues() noexcept;
+
 		struct Wrapper;
 
 	private:
 
 		int data[128];
-		bool empty;
 		int numValues;
 
 		JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(MidiList);
@@ -1007,6 +1018,99 @@ public:
 
 		// ============================================================================================================
 
+		/** The draw calls of a paint routine. 
+		*
+		*	The paint routine does not draw directly, but records every call into this list. The list can be drawn 
+		*	onto the canvas as often as needed, and it creates a signature of all calls and their parameters, so
+		*	the panel can check if the paint routine created the same image as before.
+		*/
+		class DrawActionList : public ReferenceCountedObject
+		{
+		public:
+
+			typedef ReferenceCountedObjectPtr<DrawActionList> Ptr;
+			typedef std::function<void(Graphics&, Image&)> DrawAction;
+
+			enum class ActionId
+			{
+				fillAll = 0,
+				setColour,
+				setOpacity,
+				fillRect,
+				drawRect,
+				drawRoundedRectangle,
+				fillRoundedRectangle,
+				drawLine,
+				drawHorizontalLine,
+				setFont,
+				drawText,
+				setGradientFill,
+				drawEllipse,
+				fillEllipse,
+				drawImage,
+				drawDropShadow,
+				addDropShadowFromAlpha,
+				drawTriangle,
+				fillTriangle,
+				fillPath,
+				drawPath,
+				rotate,
+				numActionIds
+			};
+
+			DrawActionList(Rectangle<int> canvasBounds_) : canvasBounds(canvasBounds_) {}
+
+			/** Adds the action. The parameters are used to create the signature. */
+			template <typename... Parameters> void add(ActionId id, const DrawAction& action, const Parameters&... parameters)
+			{
+				signature.writeInt((int)id);
+				writeToSignature(parameters...);
+				actions.add(action);
+			}
+
+			/** Draws all actions onto the canvas. */
+			void draw(Graphics& g, Image& canvas) const
+			{
+				for (const auto& a : actions)
+					a(g, canvas);
+			}
+
+			/** Checks if both lists will draw the same image. */
+			bool hasSameContent(const DrawActionList& other) const;
+
+			const Rectangle<int> canvasBounds;
+
+		private:
+
+			void writeToSignature() {}
+
+			template <typename T, typename... Parameters> void writeToSignature(const T& first, const Parameters&... rest)
+			{
+				write(first);
+				writeToSignature(rest...);
+			}
+
+			void write(int value) { signature.writeInt(value); }
+			void write(int64 value) { signature.writeInt64(value); }
+			void write(float value) { signature.writeFloat(value); }
+			void write(const String& text) { signature.writeString(text); }
+			void write(Colour c) { signature.writeInt((int)c.getARGB()); }
+			void write(Point<float> p) { write(p.getX()); write(p.getY()); }
+			void write(Rectangle<float> r) { write(r.getX()); write(r.getY()); write(r.getWidth()); write(r.getHeight()); }
+			void write(Rectangle<int> r) { write(r.getX()); write(r.getY()); write(r.getWidth()); write(r.getHeight()); }
+			void write(const Path& p) { p.writePathToStream(signature); }
+			void write(const Font& f);
+			void write(const ColourGradient& gradient);
+			void write(const AffineTransform& t);
+
+			Array<DrawAction> actions;
+			MemoryOutputStream signature;
+
+			JUCE_DECLARE_NON_COPYABLE(DrawActionList);
+		};
+
+		// ============================================================================================================
+
 		Identifier getObjectName() const override { RETURN_STATIC_IDENTIFIER("Graphics"); }
 		
 		// ============================================================================================================ API Methods
@@ -1085,10 +1189,10 @@ public:
 		struct Wrapper;
 
 		
-		void setGraphics(Graphics *g_, Image* image_)
+		/** Records the draw calls into the given list (or stops recording if nullptr). */
+		void setDrawActionList(DrawActionList* newList)
 		{
-			g = g_;
-			imageToDraw = image_;
+			actionList = newList;
 		}
 
 	private:
@@ -1101,9 +1205,7 @@ public:
 
 		Result rectangleResult;
 
-		Image *imageToDraw = nullptr;
-
-		Graphics *g = nullptr;
+		DrawActionList* actionList = nullptr;
 
 		Colour currentColour;
 		Font currentFont;
@@ -0,0 +1,355 @@
+/*  ===========================================================================
+*
+*   This file is part of HISE.
+*   Copyright 2016 Christoph Hart
+*
+*   HISE is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   HISE is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with HISE.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Commercial licenses for using HISE in an closed source project are
+*   available on request. Please visit the project's website to get more
+*   information about commercial licensing:
+*
+*   http://www.hise.audio/
+*
+*   HISE is based on the JUCE library,
+*   which must be separately licensed for closed source applications:
+*
+*   http://www.juce.com
+*
+*   ===========================================================================
+*/
+
+namespace hise { using namespace juce;
+
+struct TypedArray::Wrapper
+{
+	static TypedArray* get(const var::NativeFunctionArgs& args)
+	{
+		auto t = dynamic_cast<TypedArray*>(args.thisObject.getObject());
+
+		CHECK_CONDITION(t != nullptr, "Not a TypedArray");
+
+		return t;
+	}
+
+	static var getArg(const var::NativeFunctionArgs& args, int index)
+	{
+		return index < args.numArguments ? args.arguments[index] : var();
+	}
+
+	static var fill(const var::NativeFunctionArgs& args)		{ get(args)->fill(getArg(args, 0)); return var(); }
+	static var add(const var::NativeFunctionArgs& args)			{ get(args)->add(getArg(args, 0)); return var(); }
+	static var multiply(const var::NativeFunctionArgs& args)	{ get(args)->multiply(getArg(args, 0)); return var(); }
+	static var copyFrom(const var::NativeFunctionArgs& args)	{ get(args)->copyFrom(getArg(args, 0)); return var(); }
+	static var getMin(const var::NativeFunctionArgs& args)		{ return get(args)->getMin(); }
+	static var getMax(const var::NativeFunctionArgs& args)		{ return get(args)->getMax(); }
+};
+
+TypedArray::TypedArray(Type t, int numElements_) :
+	type(t),
+	numElements(jmax(0, numElements_)),
+	data(nullptr)
+{
+	ownedData.allocate(jmax(1, numElements), true);
+	data = ownedData.getData();
+
+	setMethod("fill", Wrapper::fill);
+	setMethod("add", Wrapper::add);
+	setMethod("multiply", Wrapper::multiply);
+	setMethod("copyFrom", Wrapper::copyFrom);
+	setMethod("getMin", Wrapper::getMin);
+	setMethod("getMax", Wrapper::getMax);
+}
+
+TypedArray::TypedArray(Type t, void* externalData, int numElements_, ReferenceCountedObject* dataOwner) :
+	type(t),
+	numElements(jmax(0, numElements_)),
+	data(externalData),
+	owner(dataOwner)
+{
+	setMethod("fill", Wrapper::fill);
+	setMethod("add", Wrapper::add);
+	setMethod("multiply", Wrapper::multiply);
+	setMethod("copyFrom", Wrapper::copyFrom);
+	setMethod("getMin", Wrapper::getMin);
+	setMethod("getMax", Wrapper::getMax);
+}
+
+TypedArray::~TypedArray()
+{
+	data = nullptr;
+	owner = nullptr;
+}
+
+bool TypedArray::getSourceData(const var& source, Type& sourceType, const void*& sourceData, int& sourceSize)
+{
+	if (auto t = dynamic_cast<TypedArray*>(source.getObject()))
+	{
+		sourceType = t->type;
+		sourceData = t->data;
+		sourceSize = t->numElements;
+		return true;
+	}
+
+	if (auto b = source.getBuffer())
+	{
+		sourceType = Type::Float32;
+		sourceData = b->buffer.getReadPointer(0);
+		sourceSize = b->size;
+		return true;
+	}
+
+	return false;
+}
+
+void TypedArray::fill(const var& value)
+{
+	if (isFloat())
+	{
+		float v = (float)value;
+		FloatVectorOperations::fill(getFloatData(), FloatSanitizers::sanitizeFloatNumber(v), numElements);
+	}
+	else
+		std::fill_n(getIntData(), numElements, (int)value);
+
+	if (midiList != nullptr)
+		midiList->updateNumSetValues();
+}
+
+void TypedArray::add(const var& valueOrArray)
+{
+	Type sourceType;
+	const void* sourceData;
+	int sourceSize;
+
+	if (getSourceData(valueOrArray, sourceType, sourceData, sourceSize))
+	{
+		const int num = jmin(numElements, sourceSize);
+
+		if (isFloat() && sourceType == Type::Float32)
+			FloatVectorOperations::add(getFloatData(), static_cast<const float*>(sourceData), num);
+		else if (isFloat())
+		{
+			for (int i = 0; i < num; i++)
+				getFloatData()[i] += (float)static_cast<const int*>(sourceData)[i];
+		}
+		else if (sourceType == Type::Int32)
+		{
+			for (int i = 0; i < num; i++)
+				getIntData()[i] += static_cast<const int*>(sourceData)[i];
+		}
+		else
+		{
+			for (int i = 0; i < num; i++)
+				getIntData()[i] += (int)static_cast<const float*>(sourceData)[i];
+		}
+	}
+	else if (isFloat())
+		FloatVectorOperations::add(getFloatData(), (float)valueOrArray, numElements);
+	else
+	{
+		const int delta = (int)valueOrArray;
+
+		for (int i = 0; i < numElements; i++)
+			getIntData()[i] += delta;
+	}
+
+	if (midiList != nullptr)
+		midiList->updateNumSetValues();
+}
+
+void TypedArray::multiply(const var& valueOrArray)
+{
+	Type sourceType;
+	const void* sourceData;
+	int sourceSize;
+
+	if (getSourceData(valueOrArray, sourceType, sourceData, sourceSize))
+	{
+		const int num = jmin(numElements, sourceSize);
+
+		if (isFloat() && sourceType == Type::Float32)
+			FloatVectorOperations::multiply(getFloatData(), static_cast<const float*>(sourceData), num);
+		else if (isFloat())
+		{
+			for (int i = 0; i < num; i++)
+				getFloatData()[i] *= (float)static_cast<const int*>(sourceData)[i];
+		}
+		else if (sourceType == Type::Int32)
+		{
+			for (int i = 0; i < num; i++)
+				getIntData()[i] *= static_cast<const int*>(sourceData)[i];
+		}
+		else
+		{
+			for (int i = 0; i < num; i++)
+				getIntData()[i] = (int)((float)getIntData()[i] * static_cast<const float*>(sourceData)[i]);
+		}
+	}
+	else if (isFloat())
+		FloatVectorOperations::multiply(getFloatData(), (float)valueOrArray, numElements);
+	else
+	{
+		const double factor = (double)valueOrArray;
+
+		for (int i = 0; i < numElements; i++)
+			getIntData()[i] = (int)((double)getIntData()[i] * factor);
+	}
+
+	if (midiList != nullptr)
+		midiList->updateNumSetValues();
+}
+
+void TypedArray::copyFrom(const var& source)
+{
+	Type sourceType;
+	const void* sourceData;
+	int sourceSize;
+
+	if (getSourceData(source, sourceType, sourceData, sourceSize))
+	{
+		const int num = jmin(numElements, sourceSize);
+
+		if (sourceType == type)
+			memmove(data, sourceData, sizeof(float) * (size_t)num);
+		else if (isFloat())
+		{
+			for (int i = 0; i < num; i++)
+				getFloatData()[i] = (float)static_cast<const int*>(sourceData)[i];
+		}
+		else
+		{
+			for (int i = 0; i < num; i++)
+				getIntData()[i] = (int)static_cast<const float*>(sourceData)[i];
+		}
+	}
+	else if (auto array = source.getArray())
+	{
+		const int num = jmin(numElements, array->size());
+
+		for (int i = 0; i < num; i++)
+			setUnchecked(i, array->getUnchecked(i));
+	}
+	else if (auto midiList = dynamic_cast<ScriptingObjects::MidiList*>(source.getObject()))
+	{
+		const int num = jmin(numElements, 128);
+
+		for (int i = 0; i < num; i++)
+			setUnchecked(i, midiList->getData()[i]);
+	}
+	else if (auto sliderPackData = dynamic_cast<ScriptingObjects::ScriptSliderPackData*>(source.getObject()))
+	{
+		const int num = jmin(numElements, sliderPackData->getNumSliders());
+
+		for (int i = 0; i < num; i++)
+			setUnchecked(i, sliderPackData->getSliderPackData()->getValue(i));
+	}
+	else
+		throw String("TypedArray.copyFrom(): unsupported source");
+
+	if (midiList != nullptr)
+		midiList->updateNumSetValues();
+}
+
+var TypedArray::getMin() const
+{
+	if (numElements == 0)
+		return var();
+
+	if (isFloat())
+		return FloatVectorOperations::findMinimum(getFloatData(), numElements);
+
+	return *std::min_element(getIntData(), getIntData() + numElements);
+}
+
+var TypedArray::getMax() const
+{
+	if (numElements == 0)
+		return var();
+
+	if (isFloat())
+		return FloatVectorOperations::findMaximum(getFloatData(), numElements);
+
+	return *std::max_element(getIntData(), getIntData() + numElements);
+}
+
+TypedArray::Factory::Factory()
+{
+	setProperty("Float32", (int)Type::Float32);
+	setProperty("Int32", (int)Type::Int32);
+
+	setMethod("create", create);
+	setMethod("referTo", referTo);
+}
+
+var TypedArray::Factory::create(const var::NativeFunctionArgs& args)
+{
+	CHECK_CONDITION(args.numArguments == 2, "Usage: TypedArray.create(type, numElements)");
+
+	const int typeIndex = (int)args.arguments[0];
+	const int numElements = (int)args.arguments[1];
+
+	CHECK_CONDITION(isPositiveAndBelow(typeIndex, (int)Type::numTypes), "TypedArray: unknown type");
+	CHECK_CONDITION(numElements >= 0, "TypedArray: negative size");
+
+	return var(new TypedArray((Type)typeIndex, numElements));
+}
+
+var TypedArray::Factory::referTo(const var::NativeFunctionArgs& args)
+{
+	CHECK_CONDITION(args.numArguments >= 1, "Usage: TypedArray.referTo(object, offset, numElements)");
+
+	const var& source = args.arguments[0];
+
+	Type sourceType;
+	void* sourceData = nullptr;
+	int sourceSize = 0;
+	ScriptingObjects::MidiList* sourceMidiList = nullptr;
+
+	if (auto t = dynamic_cast<TypedArray*>(source.getObject()))
+	{
+		sourceType = t->type;
+		sourceData = t->data;
+		sourceSize = t->numElements;
+		sourceMidiList = t->midiList;
+	}
+	else if (auto b = source.getBuffer())
+	{
+		sourceType = Type::Float32;
+		sourceData = b->buffer.getWritePointer(0);
+		sourceSize = b->size;
+	}
+	else if (auto midiList = dynamic_cast<ScriptingObjects::MidiList*>(source.getObject()))
+	{
+		sourceType = Type::Int32;
+		sourceData = midiList->getData();
+		sourceSize = 128;
+		sourceMidiList = midiList;
+	}
+	else
+		throw String("TypedArray.referTo(): the object must be a TypedArray, Buffer or MidiList");
+
+	const int offset = args.numArguments > 1 ? jlimit(0, sourceSize, (int)args.arguments[1]) : 0;
+	const int numElements = args.numArguments > 2 ? jlimit(0, sourceSize - offset, (int)args.arguments[2]) : sourceSize - offset;
+
+	void* viewData = static_cast<char*>(sourceData) + sizeof(float) * (size_t)offset;
+
+	TypedArray::Ptr view = new TypedArray(sourceType, viewData, numElements, source.getObject());
+
+	view->midiList = sourceMidiList;
+
+	return var(view.get());
+}
+
+} // namespace hise
@@ -0,0 +1,182 @@
+/*  ===========================================================================
+*
+*   This file is part of HISE.
+*   Copyright 2016 Christoph Hart
+*
+*   HISE is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   HISE is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with HISE.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Commercial licenses for using HISE in an closed source project are
+*   available on request. Please visit the project's website to get more
+*   information about commercial licensing:
+*
+*   http://www.hise.audio/
+*
+*   HISE is based on the JUCE library,
+*   which must be separately licensed for closed source applications:
+*
+*   http://www.juce.com
+*
+*   ===========================================================================
+*/
+
+#ifndef TYPEDARRAY_H_INCLUDED
+#define TYPEDARRAY_H_INCLUDED
+
+namespace hise { using namespace juce;
+
+/** A contiguous array of 32bit float or integer numbers for use in scripts.
+*
+*	Script arrays store every element as var, so using them as lookup table costs a lot of overhead.
+*	This object stores the numbers in a contiguous block of memory and the engine reads and writes 
+*	the elements directly when you use the [] operator (with a bounds check).
+*
+*		const var table = TypedArray.create(TypedArray.Float32, 128);
+*		table.fill(0.5);
+*		table[12] = 0.8;
+*		table.multiply(2.0);
+*
+*	It can also refer to the data of a Buffer or MidiList without copying it:
+*
+*		const var view = TypedArray.referTo(Engine.createMidiList());
+*
+*	The bulk operations of float arrays use the vectorised FloatVectorOperations.
+*/
+class TypedArray : public DynamicObject
+{
+public:
+
+	enum class Type
+	{
+		Float32 = 0,
+		Int32,
+		numTypes
+	};
+
+	/** Creates an array with the given size. The data will be initialised to zero. */
+	TypedArray(Type t, int numElements);
+
+	/** Creates an array that operates on the data of another object (which will be kept alive by this array). */
+	TypedArray(Type t, void* externalData, int numElements, ReferenceCountedObject* dataOwner);
+
+	~TypedArray();
+
+	static Identifier getName() { RETURN_STATIC_IDENTIFIER("TypedArray") };
+
+	// ================================================================================================================
+
+	Type getType() const noexcept { return type; }
+
+	int size() const noexcept { return numElements; }
+
+	bool isFloat() const noexcept { return type == Type::Float32; }
+
+	float* getFloatData() noexcept { jassert(isFloat()); return static_cast<float*>(data); }
+	const float* getFloatData() const noexcept { jassert(isFloat()); return static_cast<const float*>(data); }
+
+	int* getIntData() noexcept { jassert(!isFloat()); return static_cast<int*>(data); }
+	const int* getIntData() const noexcept { jassert(!isFloat()); return static_cast<const int*>(data); }
+
+	/** Returns the element without a bounds check. */
+	var getUnchecked(int index) const noexcept
+	{
+		jassert(isPositiveAndBelow(index, numElements));
+
+		if (isFloat())
+			return getFloatData()[index];
+		else
+			return getIntData()[index];
+	}
+
+	/** Sets the element without a bounds check. */
+	void setUnchecked(int index, const var& newValue) noexcept
+	{
+		jassert(isPositiveAndBelow(index, numElements));
+
+		if (isFloat())
+		{
+			float v = (float)newValue;
+			getFloatData()[index] = FloatSanitizers::sanitizeFloatNumber(v);
+		}
+		else
+		{
+			int& element = getIntData()[index];
+			const int oldValue = element;
+
+			element = (int)newValue;
+
+			if (midiList != nullptr)
+				midiList->valueChanged(oldValue, element);
+		}
+	}
+
+	// ================================================================================================================
+
+	/** Sets all elements to the given value. */
+	void fill(const var& value);
+
+	/** Adds a scalar or the elements of another TypedArray / Buffer. */
+	void add(const var& valueOrArray);
+
+	/** Multiplies with a scalar or the elements of another TypedArray / Buffer. */
+	void multiply(const var& valueOrArray);
+
+	/** Copies the values from a TypedArray, Buffer, Array, MidiList or SliderPackData. */
+	void copyFrom(const var& source);
+
+	/** Returns the smallest element (or undefined if the array is empty). */
+	var getMin() const;
+
+	/** Returns the biggest element (or undefined if the array is empty). */
+	var getMax() const;
+
+	/** The object that is registered as "TypedArray" and creates the arrays. */
+	class Factory : public DynamicObject
+	{
+	public:
+
+		Factory();
+
+		/** TypedArray.create(type, numElements) */
+		static var create(const var::NativeFunctionArgs& args);
+
+		/** TypedArray.referTo(object, offset, numElements) creates a view of a TypedArray, Buffer or MidiList. */
+		static var referTo(const var::NativeFunctionArgs& args);
+	};
+
+	typedef ReferenceCountedObjectPtr<TypedArray> Ptr;
+
+private:
+
+	struct Wrapper;
+
+	/** Returns the data of a TypedArray or Buffer without creating a new object. Returns false for other objects. */
+	static bool getSourceData(const var& source, Type& sourceType, const void*& sourceData, int& sourceSize);
+
+	const Type type;
+	const int numElements;
+
+	HeapBlock<uint32> ownedData;
+	void* data;
+
+	ReferenceCountedObjectPtr<ReferenceCountedObject> owner;
+
+	/** The MidiList whose data this array refers to. It must be told about changes to update its counter. */
+	ScriptingObjects::MidiList* midiList = nullptr;
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(TypedArray)
+};
+
+} // namespace hise
+
+#endif  // TYPEDARRAY_H_INCLUDED
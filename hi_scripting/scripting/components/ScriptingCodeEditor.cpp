@@ -386,6 +386,14 @@ void JavascriptCodeEditor::addPopupMenuItems(PopupMenu &menu, const MouseEvent *
 		menu.addSeparator();
 		menu.addItem(ContextActions::MoveToExternalFile, "Move selection to external file");
 		menu.addItem(ContextActions::InsertExternalFile, "Replace include with file content", s == "include");
+		menu.addSeparator();
+		menu.addSectionHeader("Profiling");
+
+		const bool isProfiling = scriptProcessor->isProfiling();
+
+		menu.addItem(ContextActions::StartProfiling, "Start profiling", !isProfiling);
+		menu.addItem(ContextActions::StartStatementProfiling, "Start profiling (including statements)", !isProfiling);
+		menu.addItem(ContextActions::StopProfiling, "Stop profiling and export", isProfiling);
     }
     
 #else
@@ -523,6 +531,38 @@ void JavascriptCodeEditor::performPopupMenuAction(int menuId)
 
 		return;
 	}
+	case JavascriptCodeEditor::StartProfiling:
+	case JavascriptCodeEditor::StartStatementProfiling:
+	{
+		s->startProfiling(action == JavascriptCodeEditor::StartStatementProfiling);
+		debugToConsole(p, "Profiling started");
+		return;
+	}
+	case JavascriptCodeEditor::StopProfiling:
+	{
+		s->stopProfiling();
+
+		FileChooser profileSaver("Export profile (use .txt for collapsed stacks)",
+			GET_PROJECT_HANDLER(p).getWorkDirectory().getChildFile(p->getId() + ".speedscope.json"),
+			"*.json;*.txt");
+
+		if (profileSaver.browseForFileToSave(true))
+		{
+			const File f = profileSaver.getResult();
+
+			const auto format = f.hasFileExtension("txt") ? ScriptProfiler::ExportFormat::CollapsedStacks :
+															ScriptProfiler::ExportFormat::Speedscope;
+
+			const Result r = s->exportProfile(f, format);
+
+			if (r.wasOk())
+				debugToConsole(p, "Profile exported to " + f.getFullPathName());
+			else
+				debugError(p, r.getErrorMessage());
+		}
+
+		return;
+	}
 	case JavascriptCodeEditor::ExportAsCompressedScript:
 	{
 		const String compressedScript = s->getBase64CompressedScript();
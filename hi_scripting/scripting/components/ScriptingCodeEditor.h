@@ -77,7 +77,10 @@ public:
 		MoveToExternalFile,
 		InsertExternalFile,
 		ExportAsCompressedScript,
-		ImportCompressedScript
+		ImportCompressedScript,
+		StartProfiling,
+		StartStatementProfiling,
+		StopProfiling
 	};
 
 
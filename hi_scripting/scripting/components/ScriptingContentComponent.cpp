@@ -69,12 +69,7 @@ ScriptContentComponent::~ScriptContentComponent()
 	processor->getScriptingContent()->removeRebuildListener(this);
 
 	if (contentData.get() != nullptr)
-	{
-		for (int i = 0; i < contentData->getNumComponents(); i++)
-		{
-			contentData->getComponent(i)->removeChangeListener(this);
-		}
-	}
+		contentData->removeValueListener(this);
 
 	if (p.get() != nullptr)
 	{
@@ -162,10 +157,30 @@ void ScriptContentComponent::updateValue(int i)
 	}
 }
 
-void ScriptContentComponent::updateValues()
+void ScriptContentComponent::componentValuesChanged(const ReferenceCountedArray<ScriptingApi::Content::ScriptComponent>& changedComponents)
 {
-	for (int i = 0; i < componentWrappers.size(); i++)
+	if (contentData.get() == nullptr || isRebuilding)
+		return;
+
+	// The whole content is sent if the queue overflowed, so looking up every component with indexOf() would be quadratic.
+	// Components of a previous content are not in the list and are skipped.
+	SortedSet<const ScriptingApi::Content::ScriptComponent*> changedSet;
+
+	changedSet.ensureStorageAllocated(changedComponents.size());
+
+	for (auto sc : changedComponents)
+		changedSet.add(sc);
+
+	const int numComponents = jmin<int>(contentData->components.size(), componentWrappers.size());
+
+	for (int i = 0; i < numComponents; i++)
 	{
+		auto sc = contentData->components[i].get();
+
+		if (!changedSet.contains(sc))
+			continue;
+
+		componentWrappers[i]->updateValue(sc->getValue());
 		updateValue(i);
 	}
 }
@@ -179,19 +194,8 @@ void ScriptContentComponent::changeListenerCallback(SafeChangeBroadcaster *b)
 		setEnabled(false);
 	}
 
-	if (p == b)
-	{
-#if USE_BACKEND
-		updateValues();
-#endif
-	}
-	
-	else if (auto sc = dynamic_cast<ScriptingApi::Content::ScriptComponent*>(b))
-	{
-		auto index = contentData->getComponentIndex(sc->name);
-		componentWrappers[index]->updateValue(sc->getValue());
-	}
-	else
+	// The values are updated with componentValuesChanged()
+	if (p != b)
 	{
 		updateContent();
 	}
@@ -380,15 +384,18 @@ void ScriptContentComponent::setNewContent(ScriptingApi::Content *c)
 {
 	if (c == nullptr) return;
 
+	if (contentData.get() != nullptr)
+		contentData->removeValueListener(this);
+
 	contentData = c;
 
+	contentData->addValueListener(this);
+
 	deleteAllScriptComponents();
 
 	for (int i = 0; i < contentData->components.size(); i++)
 	{
 		auto sc = contentData->components[i].get();
-		
-		sc->addChangeListener(this);
 
 		componentWrappers.add(sc->createComponentWrapper(this, i));
 
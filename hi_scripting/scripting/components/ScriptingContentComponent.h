@@ -85,6 +85,7 @@ class ScriptContentComponent: public Component,
 							  public SafeChangeListener,
 							  public GlobalScriptCompileListener,
 							  public ScriptingApi::Content::RebuildListener,
+							  public ScriptingApi::Content::ValueListener,
 							  public AsyncValueTreePropertyListener
 {
 public:
@@ -190,7 +191,7 @@ public:
 
 	void updateValue(int i);
 
-	void updateValues();
+	void componentValuesChanged(const ReferenceCountedArray<ScriptingApi::Content::ScriptComponent>& changedComponents) override;
 
 	void changeListenerCallback(SafeChangeBroadcaster *b) override;
 
@@ -219,4 +219,113 @@ DebugInformation* DebugableObject::Helpers::getDebugInformation(HiseJavascriptEn
 	return nullptr;
 }
 
-} // namespace hise
\ No newline at end of file
+#if ENABLE_SCRIPTING_ALLOCATION_TRACER
+
+thread_local ScriptAllocationTracer* ScriptAllocationTracer::currentTracer = nullptr;
+
+ScriptAllocationTracer::ScriptAllocationTracer() noexcept:
+	previousTracer(currentTracer)
+{
+	currentTracer = this;
+}
+
+void ScriptAllocationTracer::stop() noexcept
+{
+	if (active)
+	{
+		jassert(currentTracer == this);
+
+		currentTracer = previousTracer;
+		active = false;
+	}
+}
+
+ScriptAllocationTracer::ScopedStatement::ScopedStatement(const void* statement) noexcept:
+	tracer(currentTracer),
+	previousStatement(nullptr)
+{
+	if (tracer != nullptr)
+	{
+		previousStatement = tracer->currentStatement;
+		tracer->currentStatement = statement;
+	}
+}
+
+ScriptAllocationTracer::ScopedStatement::~ScopedStatement() noexcept
+{
+	if (tracer != nullptr)
+		tracer->currentStatement = previousStatement;
+}
+
+void ScriptAllocationTracer::recordAllocation(size_t numBytes) noexcept
+{
+	auto t = currentTracer;
+
+	if (t == nullptr)
+		return;
+
+	for (int i = 0; i < t->numRecords; i++)
+	{
+		auto& r = t->records[i];
+
+		if (r.statement == t->currentStatement)
+		{
+			r.numBytes += numBytes;
+			r.numAllocations++;
+			return;
+		}
+	}
+
+	if (t->numRecords == MaxNumRecords)
+	{
+		t->numDroppedAllocations++;
+		return;
+	}
+
+	auto& r = t->records[t->numRecords++];
+
+	r.statement = t->currentStatement;
+	r.numBytes = numBytes;
+	r.numAllocations = 1;
+}
+
+#endif
+
+} // namespace hise
+
+#if ENABLE_SCRIPTING_ALLOCATION_TRACER
+
+// Replaces the global allocation functions so that the allocations of script callbacks can be traced.
+
+void* operator new(std::size_t size)
+{
+	hise::ScriptAllocationTracer::recordAllocation(size);
+
+	if (void* p = std::malloc(size != 0 ? size : 1))
+		return p;
+
+	throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size)
+{
+	return operator new(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept
+{
+	hise::ScriptAllocationTracer::recordAllocation(size);
+	return std::malloc(size != 0 ? size : 1);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t& t) noexcept
+{
+	return operator new(size, t);
+}
+
+void operator delete(void* p) noexcept						{ std::free(p); }
+void operator delete[](void* p) noexcept					{ std::free(p); }
+void operator delete(void* p, const std::nothrow_t&) noexcept	{ std::free(p); }
+void operator delete[](void* p, const std::nothrow_t&) noexcept	{ std::free(p); }
+
+#endif
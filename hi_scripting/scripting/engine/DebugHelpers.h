@@ -321,5 +321,79 @@ public:
 	const Identifier namespaceId;
 };
 
+#if ENABLE_SCRIPTING_ALLOCATION_TRACER
+
+/** Records the heap allocations of the current thread while a realtime script callback is executed.
+*
+*	If ENABLE_SCRIPTING_ALLOCATION_TRACER is enabled, the global operator new is replaced with a version that 
+*	forwards every allocation to the tracer of the current thread. The tracer stores the statement that was
+*	executed when the allocation happened, so the engine can report the code location afterwards.
+*
+*	Recording an allocation does not allocate itself, it just increments the counters of a fixed number of records.
+*/
+class ScriptAllocationTracer
+{
+public:
+
+	enum
+	{
+		MaxNumRecords = 16
+	};
+
+	struct Record
+	{
+		const void* statement;
+		size_t numBytes;
+		int numAllocations;
+	};
+
+	/** Sets the statement that is executed by the current thread until this object is destroyed. */
+	struct ScopedStatement
+	{
+		ScopedStatement(const void* statement) noexcept;
+		~ScopedStatement() noexcept;
+
+	private:
+
+		ScriptAllocationTracer* tracer;
+		const void* previousStatement;
+	};
+
+	/** Starts recording all allocations of the current thread. */
+	ScriptAllocationTracer() noexcept;
+
+	~ScriptAllocationTracer() noexcept { stop(); }
+
+	/** Stops recording. Call this before you report the allocations (because this will allocate). */
+	void stop() noexcept;
+
+	int getNumRecords() const noexcept { return numRecords; }
+
+	const Record& getRecord(int index) const noexcept { return records[index]; }
+
+	/** Returns the amount of allocations that could not be stored because all records were used. */
+	int getNumDroppedAllocations() const noexcept { return numDroppedAllocations; }
+
+	/** Called by the replaced operator new. */
+	static void recordAllocation(size_t numBytes) noexcept;
+
+private:
+
+	static thread_local ScriptAllocationTracer* currentTracer;
+
+	ScriptAllocationTracer* previousTracer;
+	bool active = true;
+
+	const void* currentStatement = nullptr;
+
+	Record records[MaxNumRecords];
+	int numRecords = 0;
+	int numDroppedAllocations = 0;
+
+	JUCE_DECLARE_NON_COPYABLE(ScriptAllocationTracer)
+};
+
+#endif
+
 } // namespace hise
 #endif  // DEBUGHELPERS_H_INCLUDED
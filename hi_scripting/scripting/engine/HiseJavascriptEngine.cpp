@@ -184,6 +184,42 @@ struct HiseJavascriptEngine::RootObject::CodeLocation
 		return (int)(location - program.getCharPointer());
 	}
 
+	/** Returns the code from this location to the end of the line. */
+	String getLineText(int maxLength) const
+	{
+		auto end = location;
+
+		for (int i = 0; i < maxLength && !end.isEmpty() && *end != '\n' && *end != '\r'; i++)
+			++end;
+
+		return String(location, end).trim();
+	}
+
+	ScriptProfiler::FrameInfo createProfilerFrame(const String& name) const
+	{
+		ScriptProfiler::FrameInfo info;
+
+		int col;
+		fillColumnAndLines(col, info.line);
+
+		info.name = name;
+
+		if (externalFile.isEmpty())
+			info.file = "onInit()";
+		else if (externalFile.contains("()"))
+			info.file = externalFile;
+		else
+		{
+#if USE_BACKEND
+			info.file = File(externalFile).getFileName();
+#else
+			info.file = externalFile;
+#endif
+		}
+
+		return info;
+	}
+
 	String getEncodedLocationString(const String& processorId, const File& scriptRoot) const
 	{
 		int charIndex = getCharIndex();
@@ -690,6 +726,11 @@ void HiseJavascriptEngine::setCallStackEnabled(bool shouldBeEnabled)
 	root->setCallStackEnabled(shouldBeEnabled);
 }
 
+void HiseJavascriptEngine::setProfiler(ScriptProfiler* newProfiler)
+{
+	root->profiler = newProfiler;
+}
+
 void HiseJavascriptEngine::registerApiClass(ApiClass *apiClass)
 {
 	root->hiseSpecialData.apiClasses.add(apiClass);
@@ -935,6 +976,10 @@ numArgs(numArgs_)
 		parameters[i] = Identifier::null;
 		parameterValues[i] = var::undefined();
 	}
+
+#if ENABLE_SCRIPTING_ALLOCATION_TRACER
+	allocationReporter = new AllocationReporter(*this);
+#endif
 }
 
 #if INCLUDE_NATIVE_JIT
@@ -36,6 +36,7 @@
 namespace hise { using namespace juce;
 
 class JavascriptProcessor;
+class ScriptProfiler;
 class DialogWindowWithBackgroundThread;
 
 /** The HISE Javascript Engine.
@@ -86,6 +87,13 @@ class DialogWindowWithBackgroundThread;
  *
  *  @see VarRegister
  *
+ *  **Bytecode**
+ *
+ *  The bodies of callbacks and inline functions are compiled into a compact bytecode that is executed by a
+ *  register machine instead of walking the syntax tree. Constructs that are not supported by the bytecode are
+ *  embedded as calls to the original tree nodes, so the behaviour is the same.
+ *
+ *  @see BytecodeProgram
  *
  *
  */
@@ -111,6 +119,17 @@ public:
 	*/
 	Result execute(const String& javascriptCode, bool allowConstDeclarations=true);
 
+	/** Tokenizes the code and returns the tokens as binary data that can be embedded into an exported project.
+	*
+	*	If the engine parses the same code later and the MainController returns this data from getPrecompiledTokens(),
+	*	the parser reads the tokens from the data instead of scanning the code. Returns an empty block if the code 
+	*	contains a syntax error.
+	*/
+	static MemoryBlock createPrecompiledTokens(const String& javascriptCode);
+
+	/** Checks that the precompiled tokens produce exactly the same tokens as the tokenizer for the given code. */
+	static Result checkPrecompiledTokens(const String& javascriptCode, const MemoryBlock& tokens);
+
 	/** Attempts to parse and run a javascript expression, and returns the result.
 	If there's a syntax error, or the expression can't be evaluated, the return value
 	will be var::undefined(). The errorMessage parameter gives you a way to find out
@@ -161,6 +180,13 @@ public:
 
 	var executeCallback(int callbackIndex, Result *result);
 
+	/** Returns a description for every construct in the given callback that allocates memory when it is executed.
+	*
+	*	The parser collects these (including the ones from called inline functions) so that they can be reported
+	*	for callbacks that are executed on the audio thread. This is only available in the backend.
+	*/
+	StringArray getAllocationWarnings(const Identifier& callbackId) const;
+
 	inline void setCallbackParameter(int callbackIndex, int parameterIndex, var newValue);
 
 	DebugInformation*getDebugInformation(int index);
@@ -193,6 +219,9 @@ public:
 
 	void setCallStackEnabled(bool shouldBeEnabled);
 
+	/** Sets the profiler that records the execution times of this engine. */
+	void setProfiler(ScriptProfiler* newProfiler);
+
 	void registerApiClass(ApiClass *apiClass);
 	bool isApiClassRegistered(const String& className);
 
@@ -360,6 +389,9 @@ public:
 		static Identifier getPrototypeIdentifier();
 		static var* getPropertyPointer(DynamicObject* o, const Identifier& i) noexcept;
 
+		/** Same as getPropertyPointer(), but checks the slot of the last lookup before it searches the property. */
+		static var* getPropertyPointer(DynamicObject* o, const Identifier& i, int& cachedIndex) noexcept;
+
 		bool updateCyclicReferenceList(ThreadData& data, const Identifier &id) override;
 
 		void prepareCycleReferenceCheck() override;
@@ -460,6 +492,7 @@ public:
 		struct MultiplyOp;				struct DivideOp;			struct ModuloOp;
 		struct BitwiseAndOp;			struct BitwiseOrOp;			struct BitwiseXorOp;
 		struct LeftShiftOp;				struct RightShiftOp;		struct RightShiftUnsignedOp;
+		struct BufferExpression;
 
 		// Branching
 
@@ -489,6 +522,10 @@ public:
 		struct CallbackLocalStatement;  struct CallbackLocalReference;  struct ExternalCFunction;
 		struct NativeJIT;				struct IsDefinedTest;
 
+		// Bytecode
+
+		struct BytecodeProgram;			struct BytecodeCompiler;
+
 		// Parser classes
 
 		struct TokenIterator;
@@ -609,9 +646,47 @@ public:
 
 			NamedValueSet localProperties;
 
+			/** The allocating constructs that the parser found in this callback. */
+			Array<Error> allocationWarnings;
+
 		private:
 
+#if ENABLE_SCRIPTING_ALLOCATION_TRACER
+
+			/** Collects the allocations of the realtime callbacks and logs them on the message thread. */
+			struct AllocationReporter : public AsyncUpdater
+			{
+				AllocationReporter(const Callback& parent_) :
+					parent(parent_)
+				{}
+
+				~AllocationReporter() { cancelPendingUpdate(); }
+
+				/** Adds the counters of the tracer to the pending records. This doesn't allocate or wait for the lock. */
+				void addRecords(Processor* p, const ScriptAllocationTracer& tracer) noexcept;
+
+				/** Removes the pending records. Call this before the statements are deleted. */
+				void clearRecords() noexcept;
+
+				void handleAsyncUpdate() override;
+
+			private:
+
+				const Callback& parent;
+
+				SpinLock lock;
+
+				Processor* processor = nullptr;
+				ScriptAllocationTracer::Record records[ScriptAllocationTracer::MaxNumRecords];
+				int numRecords = 0;
+				int numDroppedAllocations = 0;
+			};
+
+			ScopedPointer<AllocationReporter> allocationReporter;
+#endif
+
 			ScopedPointer<BlockStatement> statements;
+			ScopedPointer<BytecodeProgram> program;
 			double lastExecutionTime;
 			const Identifier callbackName;
 			int numArgs;
@@ -802,6 +877,9 @@ public:
 
 		HiseSpecialData hiseSpecialData;
 
+		/** The profiler of the processor (or nullptr if it was never used). */
+		ScriptProfiler* profiler = nullptr;
+
 		private:
 
 		Array<CallStackEntry> callStack;
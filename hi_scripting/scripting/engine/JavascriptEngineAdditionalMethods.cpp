@@ -750,9 +750,30 @@ var HiseJavascriptEngine::executeCallback(int callbackIndex, Result *result)
 	return var();
 }
 
+StringArray HiseJavascriptEngine::getAllocationWarnings(const Identifier& callbackId) const
+{
+	StringArray warnings;
+
+	auto p = dynamic_cast<Processor*>(root->hiseSpecialData.processor);
+
+	if (auto c = root->hiseSpecialData.getCallback(callbackId))
+	{
+		for (const auto& e : c->allocationWarnings)
+			warnings.add(callbackId.toString() + "() - " + e.errorMessage + ": " + (p != nullptr ? e.toString(p) : e.getLocationString()));
+	}
+
+	return warnings;
+}
+
 void HiseJavascriptEngine::RootObject::Callback::setStatements(BlockStatement *s) noexcept
 {
+#if ENABLE_SCRIPTING_ALLOCATION_TRACER
+	allocationReporter->clearRecords();
+#endif
+
+	program = nullptr;
 	statements = s;
+	program = BytecodeCompiler::compile(statements);
 	isCallbackDefined = s->statements.size() != 0;
 }
 
@@ -763,27 +784,148 @@ var HiseJavascriptEngine::RootObject::Callback::perform(RootObject *root)
 
 	var returnValue = var::undefined();
 
+	ScriptProfiler::ScopedFrame sf(root->profiler, false, this, [](const void* id)
+	{
+		auto c = static_cast<const Callback*>(id);
+		return c->statements->location.createProfilerFrame(c->callbackName.toString() + "()");
+	});
+
+	const bool useProgram = program != nullptr && (root->profiler == nullptr || !root->profiler->shouldRecord(true));
+
 #if USE_BACKEND
 	const double pre = Time::getMillisecondCounterHiRes();
 
-
 	root->addToCallStack(callbackName, nullptr);
+#endif
+
+#if ENABLE_SCRIPTING_ALLOCATION_TRACER
+	auto jp = root->hiseSpecialData.processor;
 
+	if (jp != nullptr && jp->isRealtimeCallback(callbackName))
+	{
+		ScriptAllocationTracer tracer;
 
+		statements->perform(s, &returnValue);
 
-	statements->perform(s, &returnValue);
+		tracer.stop();
 
+		allocationReporter->addRecords(dynamic_cast<Processor*>(jp), tracer);
+	}
+	else
+#endif
+	if (useProgram)
+		program->perform(s, &returnValue);
+	else
+		statements->perform(s, &returnValue);
+
+#if USE_BACKEND
 	root->removeFromCallStack(callbackName);
 
 	const double post = Time::getMillisecondCounterHiRes();
 	lastExecutionTime = post - pre;
-#else
-	statements->perform(s, &returnValue);
 #endif
 
 	return returnValue;
 }
 
+#if ENABLE_SCRIPTING_ALLOCATION_TRACER
+void HiseJavascriptEngine::RootObject::Callback::AllocationReporter::addRecords(Processor* p, const ScriptAllocationTracer& tracer) noexcept
+{
+	if (tracer.getNumRecords() == 0 && tracer.getNumDroppedAllocations() == 0)
+		return;
+
+	GenericScopedTryLock<SpinLock> sl(lock);
+
+	// The message thread is copying the records, so this report is skipped
+	if (!sl.isLocked())
+		return;
+
+	processor = p;
+
+	for (int i = 0; i < tracer.getNumRecords(); i++)
+	{
+		const auto& r = tracer.getRecord(i);
+
+		int index = 0;
+
+		while (index < numRecords && records[index].statement != r.statement)
+			index++;
+
+		if (index < numRecords)
+		{
+			records[index].numAllocations += r.numAllocations;
+			records[index].numBytes += r.numBytes;
+		}
+		else if (numRecords < ScriptAllocationTracer::MaxNumRecords)
+		{
+			records[numRecords++] = r;
+		}
+		else
+		{
+			numDroppedAllocations += r.numAllocations;
+		}
+	}
+
+	numDroppedAllocations += tracer.getNumDroppedAllocations();
+
+	triggerAsyncUpdate();
+}
+
+void HiseJavascriptEngine::RootObject::Callback::AllocationReporter::clearRecords() noexcept
+{
+	SpinLock::ScopedLockType sl(lock);
+
+	numRecords = 0;
+	numDroppedAllocations = 0;
+}
+
+void HiseJavascriptEngine::RootObject::Callback::AllocationReporter::handleAsyncUpdate()
+{
+	ScriptAllocationTracer::Record recordsToLog[ScriptAllocationTracer::MaxNumRecords];
+	int numRecordsToLog;
+	int numDroppedAllocationsToLog;
+	Processor* p;
+
+	{
+		SpinLock::ScopedLockType sl(lock);
+
+		memcpy(recordsToLog, records, sizeof(ScriptAllocationTracer::Record) * numRecords);
+		numRecordsToLog = numRecords;
+		numDroppedAllocationsToLog = numDroppedAllocations;
+		p = processor;
+
+		numRecords = 0;
+		numDroppedAllocations = 0;
+	}
+
+	if (p == nullptr)
+		return;
+
+	auto& logger = p->getMainController()->getDebugLogger();
+	const Identifier& callbackName = parent.getName();
+
+	for (int i = 0; i < numRecordsToLog; i++)
+	{
+		const auto& r = recordsToLog[i];
+
+		String codeLocation;
+
+		if (auto st = static_cast<const Statement*>(r.statement))
+			codeLocation = Error::fromLocation(st->location, String()).getLocationString();
+		else
+			codeLocation = "Unknown location";
+
+		String message;
+		message << callbackName.toString() << "(): " << String(r.numAllocations) << " allocations (" << String((int64)r.numBytes) << " bytes) at " << codeLocation;
+
+		logger.logScriptAllocation(p, callbackName, message, r.numAllocations);
+	}
+
+	if (numDroppedAllocationsToLog != 0)
+		logger.logScriptAllocation(p, callbackName, callbackName.toString() + "(): " + String(numDroppedAllocationsToLog) + " more allocations", numDroppedAllocationsToLog);
+}
+#endif
+
 AttributedString DynamicObjectDebugInformation::getDescription() const
 {
 	return AttributedString();
@@ -0,0 +1,739 @@
+/*  ===========================================================================
+*
+*   This file is part of HISE.
+*   Copyright 2016 Christoph Hart
+*
+*   HISE is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   HISE is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with HISE.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Commercial licenses for using HISE in an closed source project are
+*   available on request. Please visit the project's website to get more
+*   information about commercial licensing:
+*
+*   http://www.hise.audio/
+*
+*   HISE is based on the JUCE library,
+*   which must be separately licensed for closed source applications:
+*
+*   http://www.juce.com
+*
+*   ===========================================================================
+*/
+
+namespace hise { using namespace juce;
+
+/** A compiled statement tree that is executed by a register machine.
+*
+*	The bytecode covers the constructs that are used the most in the MIDI callbacks: literals, access to registers, 
+*	constants, parameters and local variables, binary operators, conditions, for / while loops and assignments. 
+*	Every node that is not supported is embedded as fallback instruction that calls the original tree node, so a 
+*	program always behaves exactly like the statement tree it was created from.
+*/
+struct HiseJavascriptEngine::RootObject::BytecodeProgram
+{
+	/** Programs that need more registers are not created (the statement tree is used instead). */
+	enum { MaxNumRegisters = 64 };
+
+	enum class OpCode : uint8
+	{
+		LoadConstant = 0,	///< r[a] = constants[b]
+		LoadPointer,		///< r[a] = *data
+		StorePointer,		///< *data = r[b]
+		LoadConstObject,	///< r[a] = ns->constObjects[b]
+		LoadParameter,		///< r[a] = parameter of the current inline function call
+		LoadSlot,			///< r[a] = slots[b]
+		StoreSlot,			///< slots[c] = r[b]
+		Binary,				///< r[a] = binaryOp (r[b], r[c])
+		Add,				///< r[a] = r[b] + r[c] (with a fast path for numbers)
+		Subtract,			///< r[a] = r[b] - r[c] (with a fast path for numbers)
+		Multiply,			///< r[a] = r[b] * r[c] (with a fast path for numbers)
+		Divide,				///< r[a] = r[b] / r[c] (with a fast path for numbers)
+		Modulo,				///< r[a] = r[b] % r[c] (with a fast path for integers)
+		Equals,				///< r[a] = r[b] == r[c] (with a fast path for numbers)
+		NotEquals,			///< r[a] = r[b] != r[c] (with a fast path for numbers)
+		LessThan,			///< r[a] = r[b] < r[c] (with a fast path for numbers)
+		LessThanOrEqual,	///< r[a] = r[b] <= r[c] (with a fast path for numbers)
+		GreaterThan,		///< r[a] = r[b] > r[c] (with a fast path for numbers)
+		GreaterThanOrEqual,	///< r[a] = r[b] >= r[c] (with a fast path for numbers)
+		ToBool,				///< r[a] = (bool)r[b]
+		Jump,				///< pc = b
+		JumpIfFalse,		///< if (!r[a]) pc = b
+		JumpIfTrue,			///< if (r[a]) pc = b
+		CheckTimeOut,		///< throws if the execution time is exceeded
+		Evaluate,			///< r[a] = expression->getResult()
+		Assign,				///< expression->assign (r[b])
+		Execute,			///< statement->perform() and jump to b on break / c on continue
+		Return,				///< *returnValue = r[a] and return
+		Exit,				///< return the result code a
+		numOpCodes
+	};
+
+	struct Instruction
+	{
+		OpCode op;
+		int a;
+		int b;
+		int c;
+
+		const void* ptr;
+
+		const Expression* getExpression() const noexcept { return static_cast<const Expression*>(ptr); }
+		const Statement* getStatement() const noexcept { return static_cast<const Statement*>(ptr); }
+		const BinaryOperator* getBinaryOperator() const noexcept { return static_cast<const BinaryOperator*>(ptr); }
+		const JavascriptNamespace* getNamespace() const noexcept { return static_cast<const JavascriptNamespace*>(ptr); }
+		var* getData() const noexcept { return const_cast<var*>(static_cast<const var*>(ptr)); }
+		NamedValueSet* getSlots() const noexcept { return const_cast<NamedValueSet*>(static_cast<const NamedValueSet*>(ptr)); }
+	};
+
+	BytecodeProgram() {}
+
+	/** Executes the program. 
+	*
+	*	The program itself is never changed, so it can be executed on multiple threads and recursively at the same time.
+	*/
+	Statement::ResultCode perform(const Scope& s, var* returnValue) const;
+
+	int getNumInstructions() const noexcept { return instructions.size(); }
+
+	Array<Instruction> instructions;
+	Array<var> constants;
+	int numRegisters = 0;
+
+private:
+
+	/** The registers of a single invocation. They are allocated on the stack, so executing a program doesn't allocate. */
+	struct RegisterFrame
+	{
+		RegisterFrame(int numRegisters_) noexcept :
+			numRegisters(numRegisters_)
+		{
+			jassert(numRegisters <= MaxNumRegisters);
+
+			for (int i = 0; i < numRegisters; i++)
+				new (get() + i) var();
+		}
+
+		~RegisterFrame()
+		{
+			for (int i = 0; i < numRegisters; i++)
+				get()[i].~var();
+		}
+
+		var* get() noexcept { return reinterpret_cast<var*>(data); }
+
+		const int numRegisters;
+		alignas(var) char data[MaxNumRegisters * sizeof(var)];
+
+		JUCE_DECLARE_NON_COPYABLE(RegisterFrame)
+	};
+
+	/** The numeric operations of the specialised opcodes. 
+	*
+	*	They must return the same values as the getWithDoubles() / getWithInts() methods of the operator classes.
+	*/
+	struct Numeric
+	{
+		struct Add { static const bool hasDoubles = true;
+					 static var withDoubles(double a, double b) { return a + b; }
+					 static var withInts(int64 a, int64 b) { return a + b; } };
+
+		struct Subtract { static const bool hasDoubles = true;
+						  static var withDoubles(double a, double b) { return a - b; }
+						  static var withInts(int64 a, int64 b) { return a - b; } };
+
+		struct Multiply { static const bool hasDoubles = true;
+						  static var withDoubles(double a, double b) { return a * b; }
+						  static var withInts(int64 a, int64 b) { return a * b; } };
+
+		struct Divide { static const bool hasDoubles = true;
+						static var withDoubles(double a, double b) { return b != 0 ? a / b : std::numeric_limits<double>::infinity(); }
+						static var withInts(int64 a, int64 b) { return b != 0 ? var(a / (double)b) : var(std::numeric_limits<double>::infinity()); } };
+
+		struct Modulo { static const bool hasDoubles = false;
+						static var withDoubles(double, double) { return var(); }
+						static var withInts(int64 a, int64 b) { return b != 0 ? var(a % b) : var(std::numeric_limits<double>::infinity()); } };
+
+		struct Equals { static const bool hasDoubles = true;
+						static var withDoubles(double a, double b) { return a == b; }
+						static var withInts(int64 a, int64 b) { return a == b; } };
+
+		struct NotEquals { static const bool hasDoubles = true;
+						   static var withDoubles(double a, double b) { return a != b; }
+						   static var withInts(int64 a, int64 b) { return a != b; } };
+
+		struct LessThan { static const bool hasDoubles = true;
+						  static var withDoubles(double a, double b) { return a < b; }
+						  static var withInts(int64 a, int64 b) { return a < b; } };
+
+		struct LessThanOrEqual { static const bool hasDoubles = true;
+								 static var withDoubles(double a, double b) { return a <= b; }
+								 static var withInts(int64 a, int64 b) { return a <= b; } };
+
+		struct GreaterThan { static const bool hasDoubles = true;
+							 static var withDoubles(double a, double b) { return a > b; }
+							 static var withInts(int64 a, int64 b) { return a > b; } };
+
+		struct GreaterThanOrEqual { static const bool hasDoubles = true;
+									static var withDoubles(double a, double b) { return a >= b; }
+									static var withInts(int64 a, int64 b) { return a >= b; } };
+
+		static bool isInteger(const var& v) noexcept { return v.isInt() || v.isInt64(); }
+
+		/** Calculates the operation with unboxed values if both operands are numbers. 
+		*
+		*	Any other type combination (including bools and undefined values) uses the operator class.
+		*/
+		template <class Op> static void perform(var& result, const var& a, const var& b, const BinaryOperator* op)
+		{
+			const bool aIsDouble = a.isDouble();
+			const bool bIsDouble = b.isDouble();
+
+			if (isInteger(a) && isInteger(b))
+				result = Op::withInts((int64)a, (int64)b);
+			else if (Op::hasDoubles && (aIsDouble || isInteger(a)) && (bIsDouble || isInteger(b)))
+				result = Op::withDoubles((double)a, (double)b);
+			else
+				result = op->getWithValues(a, b);
+		}
+	};
+
+	friend struct BytecodeCompiler;
+
+	JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(BytecodeProgram)
+};
+
+
+HiseJavascriptEngine::RootObject::Statement::ResultCode HiseJavascriptEngine::RootObject::BytecodeProgram::perform(const Scope& s, var* returnValue) const
+{
+	RegisterFrame frame(numRegisters);
+
+	var* r = frame.get();
+	const Instruction* code = instructions.getRawDataPointer();
+	const int numInstructions = instructions.size();
+
+	int pc = 0;
+
+	while (pc < numInstructions)
+	{
+		const Instruction& i = code[pc++];
+
+		switch (i.op)
+		{
+		case OpCode::LoadConstant:		r[i.a] = constants.getReference(i.b); break;
+		case OpCode::LoadPointer:		r[i.a] = *i.getData(); break;
+		case OpCode::StorePointer:		*i.getData() = r[i.b]; break;
+		case OpCode::LoadConstObject:	r[i.a] = i.getNamespace()->constObjects.getValueAt(i.b); break;
+		case OpCode::LoadParameter:
+		{
+			auto p = static_cast<const InlineFunction::ParameterReference*>(i.getExpression());
+
+			if (p->f->e != nullptr)
+				r[i.a] = p->f->e->parameterResults[p->index];
+			else
+				r[i.a] = p->getResult(s); // throws the error message
+
+			break;
+		}
+		case OpCode::LoadSlot:			r[i.a] = i.getSlots()->getValueAt(i.b); break;
+		case OpCode::StoreSlot:			*i.getSlots()->getVarPointerAt(i.c) = r[i.b]; break;
+		case OpCode::Binary:			r[i.a] = i.getBinaryOperator()->getWithValues(r[i.b], r[i.c]); break;
+		case OpCode::Add:				Numeric::perform<Numeric::Add>(r[i.a], r[i.b], r[i.c], i.getBinaryOperator()); break;
+		case OpCode::Subtract:			Numeric::perform<Numeric::Subtract>(r[i.a], r[i.b], r[i.c], i.getBinaryOperator()); break;
+		case OpCode::Multiply:			Numeric::perform<Numeric::Multiply>(r[i.a], r[i.b], r[i.c], i.getBinaryOperator()); break;
+		case OpCode::Divide:			Numeric::perform<Numeric::Divide>(r[i.a], r[i.b], r[i.c], i.getBinaryOperator()); break;
+		case OpCode::Modulo:			Numeric::perform<Numeric::Modulo>(r[i.a], r[i.b], r[i.c], i.getBinaryOperator()); break;
+		case OpCode::Equals:			Numeric::perform<Numeric::Equals>(r[i.a], r[i.b], r[i.c], i.getBinaryOperator()); break;
+		case OpCode::NotEquals:			Numeric::perform<Numeric::NotEquals>(r[i.a], r[i.b], r[i.c], i.getBinaryOperator()); break;
+		case OpCode::LessThan:			Numeric::perform<Numeric::LessThan>(r[i.a], r[i.b], r[i.c], i.getBinaryOperator()); break;
+		case OpCode::LessThanOrEqual:	Numeric::perform<Numeric::LessThanOrEqual>(r[i.a], r[i.b], r[i.c], i.getBinaryOperator()); break;
+		case OpCode::GreaterThan:		Numeric::perform<Numeric::GreaterThan>(r[i.a], r[i.b], r[i.c], i.getBinaryOperator()); break;
+		case OpCode::GreaterThanOrEqual:Numeric::perform<Numeric::GreaterThanOrEqual>(r[i.a], r[i.b], r[i.c], i.getBinaryOperator()); break;
+		case OpCode::ToBool:			r[i.a] = (bool)r[i.b]; break;
+		case OpCode::Jump:				pc = i.b; break;
+		case OpCode::JumpIfFalse:		if (!(bool)r[i.a]) pc = i.b; break;
+		case OpCode::JumpIfTrue:		if ((bool)r[i.a]) pc = i.b; break;
+		case OpCode::CheckTimeOut:		s.checkTimeOut(i.getStatement()->location); break;
+		case OpCode::Evaluate:			r[i.a] = i.getExpression()->getResult(s); break;
+		case OpCode::Assign:			i.getExpression()->assign(s, r[i.b]); break;
+		case OpCode::Execute:
+		{
+			const Statement::ResultCode rc = i.getStatement()->perform(s, returnValue);
+
+			if (rc == Statement::ok)
+				break;
+
+			if (rc == Statement::breakWasHit && i.b != -1)
+				pc = i.b;
+			else if (rc == Statement::continueWasHit && i.c != -1)
+				pc = i.c;
+			else
+				return rc;
+
+			break;
+		}
+		case OpCode::Return:
+			if (returnValue != nullptr)
+				*returnValue = r[i.a];
+
+			return Statement::returnWasHit;
+		case OpCode::Exit:				return (Statement::ResultCode)i.a;
+		case OpCode::numOpCodes:
+		default:						jassertfalse; break;
+		}
+	}
+
+	return Statement::ok;
+}
+
+
+/** Lowers a statement tree into a BytecodeProgram.
+*
+*	Registers are allocated like a stack: every expression writes its result into the register it is given and
+*	uses the registers above for temporary values.
+*/
+struct HiseJavascriptEngine::RootObject::BytecodeCompiler
+{
+	/** Compiles the given statement. Returns nullptr if nothing could be compiled (then the tree should be used). */
+	static BytecodeProgram* compile(const Statement* statement)
+	{
+#if ENABLE_SCRIPTING_BYTECODE && !ENABLE_SCRIPTING_ALLOCATION_TRACER
+		if (statement == nullptr)
+			return nullptr;
+
+		ScopedPointer<BytecodeProgram> program = new BytecodeProgram();
+
+		BytecodeCompiler compiler(*program);
+		compiler.compileStatement(statement);
+
+		if (compiler.numCompiledNodes == 0 || program->numRegisters > BytecodeProgram::MaxNumRegisters)
+			return nullptr;
+
+		return program.release();
+#else
+		ignoreUnused(statement);
+		return nullptr;
+#endif
+	}
+
+private:
+
+	typedef BytecodeProgram::OpCode OpCode;
+	typedef BytecodeProgram::Instruction Instruction;
+
+	struct LoopTargets
+	{
+		Array<int> breakInstructions;
+		Array<int> continueInstructions;
+	};
+
+	BytecodeCompiler(BytecodeProgram& p) : program(p) {}
+
+	int emit(OpCode op, int a = 0, int b = 0, int c = 0, const void* ptr = nullptr)
+	{
+		Instruction i;
+		i.op = op;
+		i.a = a;
+		i.b = b;
+		i.c = c;
+		i.ptr = ptr;
+
+		program.instructions.add(i);
+		return program.instructions.size() - 1;
+	}
+
+	int getNextPosition() const { return program.instructions.size(); }
+
+	void setJumpTarget(int instructionIndex, int target)
+	{
+		program.instructions.getReference(instructionIndex).b = target;
+	}
+
+	int allocateRegister()
+	{
+		const int r = numUsedRegisters++;
+		program.numRegisters = jmax<int>(program.numRegisters, numUsedRegisters);
+		return r;
+	}
+
+	struct ScopedRegisterRelease
+	{
+		ScopedRegisterRelease(BytecodeCompiler& c_) : c(c_), numUsed(c_.numUsedRegisters) {}
+		~ScopedRegisterRelease() { c.numUsedRegisters = numUsed; }
+
+		BytecodeCompiler& c;
+		const int numUsed;
+	};
+
+	template <class T> static const T* as(const Statement* s) { return dynamic_cast<const T*>(s); }
+
+	void compileStatement(const Statement* st)
+	{
+		if (st == nullptr)
+			return;
+
+		ScopedRegisterRelease srr(*this);
+
+		if (typeid(*st) == typeid(Statement))
+			return;
+
+		if (auto block = as<BlockStatement>(st))
+		{
+			if (!canCompileBlock(*block))
+			{
+				emitFallback(st);
+				return;
+			}
+
+			numCompiledNodes++;
+
+			for (auto s : block->statements)
+				compileStatement(s);
+		}
+		else if (auto is = as<IfStatement>(st))
+		{
+			numCompiledNodes++;
+
+			const int condition = allocateRegister();
+			compileExpression(is->condition, condition);
+
+			const int jumpToElse = emit(OpCode::JumpIfFalse, condition);
+			compileStatement(is->trueBranch);
+
+			if (is->falseBranch != nullptr && typeid(*is->falseBranch) != typeid(Statement))
+			{
+				const int jumpToEnd = emit(OpCode::Jump);
+				setJumpTarget(jumpToElse, getNextPosition());
+				compileStatement(is->falseBranch);
+				setJumpTarget(jumpToEnd, getNextPosition());
+			}
+			else
+			{
+				setJumpTarget(jumpToElse, getNextPosition());
+			}
+		}
+		else if (auto ls = as<LoopStatement>(st))
+		{
+			// do-while loops and for-in loops use the tree
+			if (ls->isDoLoop || ls->isIterator || ls->condition == nullptr)
+			{
+				emitFallback(st);
+				return;
+			}
+
+			numCompiledNodes++;
+
+			compileStatement(ls->initialiser);
+
+			const int start = getNextPosition();
+			const int condition = allocateRegister();
+			compileExpression(ls->condition, condition);
+
+			const int jumpToEnd = emit(OpCode::JumpIfFalse, condition);
+			emit(OpCode::CheckTimeOut, 0, 0, 0, st);
+
+			LoopTargets targets;
+			loopStack.add(&targets);
+			compileStatement(ls->body);
+			loopStack.removeLast();
+
+			const int continuePosition = getNextPosition();
+			compileStatement(ls->iterator);
+			emit(OpCode::Jump, 0, start);
+
+			const int end = getNextPosition();
+			setJumpTarget(jumpToEnd, end);
+
+			for (auto i : targets.breakInstructions)
+				program.instructions.getReference(i).b = end;
+
+			for (auto i : targets.continueInstructions)
+			{
+				auto& ins = program.instructions.getReference(i);
+
+				if (ins.op == OpCode::Jump)
+					ins.b = continuePosition;
+				else
+					ins.c = continuePosition;
+			}
+		}
+		else if (auto rs = as<ReturnStatement>(st))
+		{
+			numCompiledNodes++;
+
+			const int value = allocateRegister();
+			compileExpression(rs->returnValue, value);
+			emit(OpCode::Return, value);
+		}
+		else if (as<BreakStatement>(st) != nullptr)
+		{
+			if (auto t = loopStack.getLast())
+				t->breakInstructions.add(emit(OpCode::Jump, 0, -1));
+			else
+				emit(OpCode::Exit, (int)Statement::breakWasHit);
+		}
+		else if (as<ContinueStatement>(st) != nullptr)
+		{
+			if (auto t = loopStack.getLast())
+				t->continueInstructions.add(emit(OpCode::Jump, 0, -1));
+			else
+				emit(OpCode::Exit, (int)Statement::continueWasHit);
+		}
+		else if (auto lvs = as<LocalVarStatement>(st))
+		{
+			numCompiledNodes++;
+
+			const int value = allocateRegister();
+			compileExpression(lvs->initialiser, value);
+			emit(OpCode::StoreSlot, 0, value, lvs->index, &lvs->parentFunction->localProperties);
+		}
+		else if (auto cls = as<CallbackLocalStatement>(st))
+		{
+			numCompiledNodes++;
+
+			const int value = allocateRegister();
+			compileExpression(cls->initialiser, value);
+			emit(OpCode::StoreSlot, 0, value, cls->index, &cls->parentCallback->localProperties);
+		}
+		else if (auto e = as<Expression>(st))
+		{
+			compileExpression(e, allocateRegister());
+		}
+		else
+		{
+			emitFallback(st);
+		}
+	}
+
+	/** Blocks with lock statements or breakpoints are executed by the tree. */
+	bool canCompileBlock(const BlockStatement& block) const
+	{
+		if (block.lockStatements.size() != 0)
+			return false;
+
+#if ENABLE_SCRIPTING_BREAKPOINTS
+		for (auto s : block.statements)
+		{
+			if (s->breakpointReference.index != -1)
+				return false;
+		}
+#endif
+
+		return true;
+	}
+
+	void emitFallback(const Statement* st)
+	{
+		const int index = emit(OpCode::Execute, 0, -1, -1, st);
+
+		if (auto t = loopStack.getLast())
+		{
+			t->breakInstructions.add(index);
+			t->continueInstructions.add(index);
+		}
+	}
+
+	void compileExpression(const Expression* e, int target)
+	{
+		ScopedRegisterRelease srr(*this);
+
+		if (typeid(*e) == typeid(Expression))
+		{
+			emit(OpCode::LoadConstant, target, addConstant(var::undefined()));
+		}
+		else if (auto lv = as<LiteralValue>(e))
+		{
+			emit(OpCode::LoadConstant, target, addConstant(lv->value));
+		}
+		else if (auto rn = as<RegisterName>(e))
+		{
+			emit(OpCode::LoadPointer, target, 0, 0, rn->data);
+		}
+		else if (auto cp = as<CallbackParameterReference>(e))
+		{
+			emit(OpCode::LoadPointer, target, 0, 0, cp->data);
+		}
+		else if (auto lr = as<LocalReference>(e))
+		{
+			emit(OpCode::LoadSlot, target, lr->index, 0, &lr->parentFunction->localProperties);
+		}
+		else if (auto clr = as<CallbackLocalReference>(e))
+		{
+			emit(OpCode::LoadSlot, target, clr->index, 0, &clr->parentCallback->localProperties);
+		}
+		else if (auto cr = as<ConstReference>(e))
+		{
+			emit(OpCode::LoadConstObject, target, cr->index, 0, cr->ns);
+		}
+		else if (as<InlineFunction::ParameterReference>(e) != nullptr)
+		{
+			emit(OpCode::LoadParameter, target, 0, 0, e);
+		}
+		else if (as<LeftShiftOp>(e) != nullptr && as<LeftShiftOp>(e)->assignsOperatorChain)
+		{
+			// `buffer << a * b + c` is fused by the tree
+			emit(OpCode::Evaluate, target, 0, 0, e);
+		}
+		else if (auto bo = as<BinaryOperator>(e))
+		{
+			var foldedValue;
+
+			if (foldConstants(*bo, foldedValue))
+			{
+				emit(OpCode::LoadConstant, target, addConstant(foldedValue));
+			}
+			else
+			{
+				const int lhs = allocateRegister();
+				const int rhs = allocateRegister();
+
+				compileExpression(bo->lhs, lhs);
+				compileExpression(bo->rhs, rhs);
+				emit(getBinaryOpCode(bo), target, lhs, rhs, bo);
+			}
+		}
+		else if (auto la = as<LogicalAndOp>(e))
+		{
+			compileExpression(la->lhs, target);
+			emit(OpCode::ToBool, target, target);
+			const int jumpToEnd = emit(OpCode::JumpIfFalse, target);
+			compileExpression(la->rhs, target);
+			emit(OpCode::ToBool, target, target);
+			setJumpTarget(jumpToEnd, getNextPosition());
+		}
+		else if (auto lo = as<LogicalOrOp>(e))
+		{
+			compileExpression(lo->lhs, target);
+			emit(OpCode::ToBool, target, target);
+			const int jumpToEnd = emit(OpCode::JumpIfTrue, target);
+			compileExpression(lo->rhs, target);
+			emit(OpCode::ToBool, target, target);
+			setJumpTarget(jumpToEnd, getNextPosition());
+		}
+		else if (auto co = as<ConditionalOp>(e))
+		{
+			const int condition = allocateRegister();
+			compileExpression(co->condition, condition);
+
+			const int jumpToElse = emit(OpCode::JumpIfFalse, condition);
+			compileExpression(co->trueBranch, target);
+			const int jumpToEnd = emit(OpCode::Jump);
+			setJumpTarget(jumpToElse, getNextPosition());
+			compileExpression(co->falseBranch, target);
+			setJumpTarget(jumpToEnd, getNextPosition());
+		}
+		else if (auto a = as<Assignment>(e))
+		{
+			compileExpression(a->newValue, target);
+			emitStore(a->target, target);
+		}
+		else if (auto pa = as<PostAssignment>(e))
+		{
+			const int newValue = allocateRegister();
+
+			compileExpression(pa->target, target);
+			compileExpression(pa->newValue, newValue);
+			emitStore(pa->target, newValue);
+		}
+		else if (auto sa = as<SelfAssignment>(e))
+		{
+			compileExpression(sa->newValue, target);
+			emitStore(sa->target, target);
+		}
+		else
+		{
+			emit(OpCode::Evaluate, target, 0, 0, e);
+			return;
+		}
+
+		numCompiledNodes++;
+	}
+
+	/** Returns the specialised opcode for the operator type (or the generic one). */
+	static OpCode getBinaryOpCode(const BinaryOperator* bo)
+	{
+		if (as<AdditionOp>(bo) != nullptr)				return OpCode::Add;
+		if (as<SubtractionOp>(bo) != nullptr)			return OpCode::Subtract;
+		if (as<MultiplyOp>(bo) != nullptr)				return OpCode::Multiply;
+		if (as<DivideOp>(bo) != nullptr)				return OpCode::Divide;
+		if (as<ModuloOp>(bo) != nullptr)				return OpCode::Modulo;
+		if (as<EqualsOp>(bo) != nullptr)				return OpCode::Equals;
+		if (as<NotEqualsOp>(bo) != nullptr)				return OpCode::NotEquals;
+		if (as<LessThanOp>(bo) != nullptr)				return OpCode::LessThan;
+		if (as<LessThanOrEqualOp>(bo) != nullptr)		return OpCode::LessThanOrEqual;
+		if (as<GreaterThanOp>(bo) != nullptr)			return OpCode::GreaterThan;
+		if (as<GreaterThanOrEqualOp>(bo) != nullptr)	return OpCode::GreaterThanOrEqual;
+
+		return OpCode::Binary;
+	}
+
+	/** Calculates operations with two numeric literals (eg. negative numbers or `!0`) at compile time. */
+	static bool foldConstants(const BinaryOperator& bo, var& result)
+	{
+		auto lhs = as<LiteralValue>(bo.lhs.get());
+		auto rhs = as<LiteralValue>(bo.rhs.get());
+
+		if (lhs == nullptr || rhs == nullptr || !isNumeric(lhs->value) || !isNumeric(rhs->value))
+			return false;
+
+		try
+		{
+			result = bo.getWithValues(lhs->value, rhs->value);
+			return true;
+		}
+		catch (...)
+		{
+			return false; // leave the error to the runtime
+		}
+	}
+
+	void emitStore(const Expression* destination, int source)
+	{
+		if (auto rn = as<RegisterName>(destination))
+			emit(OpCode::StorePointer, 0, source, 0, rn->data);
+		else if (auto lr = as<LocalReference>(destination))
+			emit(OpCode::StoreSlot, 0, source, lr->index, &lr->parentFunction->localProperties);
+		else if (auto clr = as<CallbackLocalReference>(destination))
+			emit(OpCode::StoreSlot, 0, source, clr->index, &clr->parentCallback->localProperties);
+		else
+			emit(OpCode::Assign, 0, source, 0, destination);
+	}
+
+	int addConstant(const var& v)
+	{
+		program.constants.add(v);
+		return program.constants.size() - 1;
+	}
+
+	BytecodeProgram& program;
+
+	Array<LoopTargets*> loopStack;
+	int numUsedRegisters = 0;
+	int numCompiledNodes = 0;
+};
+
+
+HiseJavascriptEngine::RootObject::Statement::ResultCode HiseJavascriptEngine::RootObject::InlineFunction::Object::performBody(const Scope& s, var* returnValue)
+{
+	ScriptProfiler::ScopedFrame sf(s.root->profiler, false, this, [](const void* id)
+	{
+		auto o = static_cast<const InlineFunction::Object*>(id);
+		return o->body->location.createProfilerFrame("inline function " + o->functionDef);
+	});
+
+	if (program != nullptr && (s.root->profiler == nullptr || !s.root->profiler->shouldRecord(true)))
+		return program->perform(s, returnValue);
+
+	return body->perform(s, returnValue);
+}
+
+} // namespace hise
@@ -233,6 +233,7 @@ struct HiseJavascriptEngine::RootObject::InlineFunction
 		~Object()
 		{
 			parameterNames.clear();
+			program = nullptr;
 			body = nullptr;
 			dynamicFunctionCall = nullptr;
 		}
@@ -315,7 +316,7 @@ struct HiseJavascriptEngine::RootObject::InlineFunction
 				dynamicFunctionCall->parameterResults.setUnchecked(i, args[i]);
 			}
 
-			Statement::ResultCode c = body->perform(s, &lastReturnValue);
+			Statement::ResultCode c = performBody(s, &lastReturnValue);
 
 			cleanUpAfterExecution();
 
@@ -339,14 +340,21 @@ struct HiseJavascriptEngine::RootObject::InlineFunction
 			}
 		}
 
+		/** Executes the compiled body if it exists or the statement tree. */
+		Statement::ResultCode performBody(const Scope& s, var* returnValue);
+
 		Identifier name;
 		Array<Identifier> parameterNames;
 		typedef ReferenceCountedObjectPtr<Object> Ptr;
 		ScopedPointer<BlockStatement> body;
+		ScopedPointer<BytecodeProgram> program;
 
 		String functionDef;
 		String commentDoc;
 
+		/** The allocating constructs that the parser found in the body (they are added to the calling callback). */
+		Array<Error> allocationWarnings;
+
 		var lastReturnValue = var::undefined();
 		
 		const FunctionCall *e;
@@ -407,7 +415,7 @@ struct HiseJavascriptEngine::RootObject::InlineFunction
 
 			try
 			{
-				ResultCode c = f->body->perform(s, &returnVar);
+				ResultCode c = f->performBody(s, &returnVar);
 
 				s.root->removeFromCallStack(f->name);
 
@@ -525,29 +533,33 @@ struct HiseJavascriptEngine::RootObject::LocalVarStatement : public Statement
 
 	ResultCode perform(const Scope& s, var*) const override
 	{
-		parentFunction->localProperties.set(name, initialiser->getResult(s));
+		var value(initialiser->getResult(s));
+		*parentFunction->localProperties.getVarPointerAt(index) = value;
 		return ok;
 	}
 
 	mutable InlineFunction::Object* parentFunction;
 	Identifier name;
 	ExpPtr initialiser;
+
+	/** The slot in the local properties of the function (they are added when the function is parsed). */
+	int index = -1;
 };
 
 
 
 struct HiseJavascriptEngine::RootObject::LocalReference : public Expression
 {
-	LocalReference(const CodeLocation& l, InlineFunction::Object *parentFunction_, const Identifier &id_) noexcept : Expression(l), parentFunction(parentFunction_), id(id_) {}
+	LocalReference(const CodeLocation& l, InlineFunction::Object *parentFunction_, const Identifier &id_, int index_) noexcept : Expression(l), parentFunction(parentFunction_), id(id_), index(index_) {}
 
 	var getResult(const Scope& /*s*/) const override
 	{
-		return parentFunction->localProperties[id];
+		return parentFunction->localProperties.getValueAt(index);
 	}
 
 	void assign(const Scope& /*s*/, const var& newValue) const override
 	{
-		parentFunction->localProperties.set(id, newValue);
+		*parentFunction->localProperties.getVarPointerAt(index) = newValue;
 	}
 
 	InlineFunction::Object* parentFunction;
@@ -576,35 +588,41 @@ struct HiseJavascriptEngine::RootObject::CallbackLocalStatement : public Stateme
 
 	ResultCode perform(const Scope& s, var*) const override
 	{
-		parentCallback->localProperties.set(name, initialiser->getResult(s));
+		var value(initialiser->getResult(s));
+		*parentCallback->localProperties.getVarPointerAt(index) = value;
 		return ok;
 	}
 
 	mutable Callback* parentCallback;
 	Identifier name;
 	ExpPtr initialiser;
+
+	/** The slot in the local properties of the callback (they are added when the callback is parsed). */
+	int index = -1;
 };
 
 struct HiseJavascriptEngine::RootObject::CallbackLocalReference : public Expression
 {
-	CallbackLocalReference(const CodeLocation& l, Callback* parent_, const Identifier& name_) noexcept : 
+	CallbackLocalReference(const CodeLocation& l, Callback* parent_, const Identifier& name_, int index_) noexcept : 
 	Expression(l), 
 	parentCallback(parent_),
-	name(name_)
+	name(name_),
+	index(index_)
 	{}
 
 	var getResult(const Scope& /*s*/) const override
 	{
-		return parentCallback->localProperties[name];
+		return parentCallback->localProperties.getValueAt(index);
 	}
 
 	void assign(const Scope& /*s*/, const var& newValue) const
 	{ 
-		parentCallback->localProperties.set(name, newValue);
+		*parentCallback->localProperties.getVarPointerAt(index) = newValue;
 	}
 
 	Callback* parentCallback;
 	Identifier name;
+	int index;
 
 	CallbackLocalStatement* target;
 };
@@ -11,12 +11,18 @@ struct HiseJavascriptEngine::RootObject::UnqualifiedName : public Expression
 {
 	UnqualifiedName(const CodeLocation& l, const Identifier& n, bool isFunction) noexcept : Expression(l), name(n), allowUnqualifiedDefinition(isFunction) {}
 
-	var getResult(const Scope& s) const override  { return s.findSymbolInParentScopes(name); }
+	var getResult(const Scope& s) const override
+	{
+		if (const var* v = getPropertyPointer(s.scope, name, cachedIndex))
+			return *v;
+
+		return s.parent != nullptr ? s.parent->findSymbolInParentScopes(name) : var::undefined();
+	}
 
 	void assign(const Scope& s, const var& newValue) const override
 	{
 		const Scope* currentScope = &s;
-		var* v = getPropertyPointer(currentScope->scope, name);
+		var* v = getPropertyPointer(currentScope->scope, name, cachedIndex);
 
 		while (v == nullptr && currentScope->parent != nullptr)
 		{
@@ -48,6 +54,9 @@ struct HiseJavascriptEngine::RootObject::UnqualifiedName : public Expression
 
 	JavascriptNamespace* ns = nullptr;
 	Identifier name;
+
+	/** The slot of the property in the innermost scope where it was found the last time. */
+	mutable int cachedIndex = -1;
 };
 
 
@@ -86,6 +95,15 @@ struct HiseJavascriptEngine::RootObject::ArraySubscript : public Expression
 			const int i = index->getResult(s);
 			return (*b)[i];
 		}
+		else if (TypedArray* t = dynamic_cast<TypedArray*>(result.getObject()))
+		{
+			const int i = index->getResult(s);
+
+			if (!isPositiveAndBelow(i, t->size()))
+				location.throwError("TypedArray index " + String(i) + " out of bounds");
+
+			return t->getUnchecked(i);
+		}
 		else if (AssignableObject * instance = dynamic_cast<AssignableObject*>(result.getObject()))
 		{
 			cacheIndex(instance, s);
@@ -123,6 +141,16 @@ struct HiseJavascriptEngine::RootObject::ArraySubscript : public Expression
 			(*b)[i] = FloatSanitizers::sanitizeFloatNumber(v);
 			return;
 		}
+		else if (TypedArray* t = dynamic_cast<TypedArray*>(result.getObject()))
+		{
+			const int i = index->getResult(s);
+
+			if (!isPositiveAndBelow(i, t->size()))
+				location.throwError("TypedArray index " + String(i) + " out of bounds");
+
+			t->setUnchecked(i, newValue);
+			return;
+		}
 		else if (Array<var>* array = result.getArray())
 		{
 			const int i = index->getResult(s);
@@ -174,6 +202,7 @@ struct HiseJavascriptEngine::RootObject::DotOperator : public Expression
 		{
 			if (Array<var>* array = p.getArray())   return array->size();
 			if (p.isBuffer()) return p.getBuffer()->size;
+			if (TypedArray* t = dynamic_cast<TypedArray*>(p.getObject())) return t->size();
 
 			if (p.isString())                       return p.toString().length();
 		}
@@ -365,6 +394,8 @@ struct HiseJavascriptEngine::RootObject::FunctionObject : public DynamicObject,
 			i < args.numArguments ? args.arguments[i] : var::undefined());
 
 		var result;
+
+		ScriptProfiler::ScopedFrame sf(s.root->profiler, false, this, [](const void* id) { return static_cast<const FunctionObject*>(id)->createProfilerFrame(); });
 		body->perform(Scope(&s, s.root, functionRoot), &result);
 
 #if ENABLE_SCRIPTING_SAFE_CHECKS
@@ -385,11 +416,17 @@ struct HiseJavascriptEngine::RootObject::FunctionObject : public DynamicObject,
 				i < args.numArguments ? args.arguments[i] : var::undefined());
 		}
 
+		ScriptProfiler::ScopedFrame sf(s.root->profiler, false, this, [](const void* id) { return static_cast<const FunctionObject*>(id)->createProfilerFrame(); });
 		body->perform(Scope(&s, s.root, scope), &result);
 
 		return result;
 	}
 
+	ScriptProfiler::FrameInfo createProfilerFrame() const
+	{
+		return body->location.createProfilerFrame("function " + functionDef);
+	}
+
 	void createFunctionDefinition(const Identifier &functionName)
 	{
 		functionDef = functionName.toString();
@@ -502,6 +539,23 @@ var* HiseJavascriptEngine::RootObject::getPropertyPointer(DynamicObject* o, cons
 	return o->getProperties().getVarPointer(i);
 }
 
+var* HiseJavascriptEngine::RootObject::getPropertyPointer(DynamicObject* o, const Identifier& i, int& cachedIndex) noexcept
+{
+	NamedValueSet& properties = o->getProperties();
+
+	if (isPositiveAndBelow(cachedIndex, properties.size()))
+	{
+		NamedValueSet::NamedValue& nv = properties.begin()[cachedIndex];
+
+		if (nv.name == i)
+			return &nv.value;
+	}
+
+	cachedIndex = properties.indexOf(i);
+
+	return properties.getVarPointerAt(cachedIndex);
+}
+
 bool HiseJavascriptEngine::RootObject::Scope::findAndInvokeMethod(const Identifier& function, const var::NativeFunctionArgs& args, var& result) const
 {
 	DynamicObject* target = args.thisObject.getDynamicObject();
@@ -24,6 +24,12 @@ struct HiseJavascriptEngine::RootObject::BinaryOperator : public BinaryOperatorB
 	{
 		var a(lhs->getResult(s)), b(rhs->getResult(s));
 
+		return getWithValues(a, b);
+	}
+
+	/** Applies the operator to the already evaluated operands (this is used by the bytecode interpreter). */
+	var getWithValues(const var& a, const var& b) const
+	{
 		if (isNumericOrUndefined(a) && isNumericOrUndefined(b))
 			return (a.isDouble() || b.isDouble()) ? getWithDoubles(a, b) : getWithInts(a, b);
 
@@ -45,6 +51,137 @@ struct HiseJavascriptEngine::RootObject::BinaryOperator : public BinaryOperatorB
 	}
 };
 
+/** Calculates `target << a * b + c` with buffers in a single pass.
+*
+*	The buffer operators work in place on the left operand, so this calculates `a *= b` and `a += c` and copies
+*	`a` into the target, which are three passes over the memory. If all operands of the chain are buffers with the
+*	size of the target, the same operations are applied in blocks of BlockSize samples, so every block is still 
+*	in the cache for the next operation. The left-most buffer is changed exactly like with the single operators.
+*/
+struct HiseJavascriptEngine::RootObject::BufferExpression
+{
+	enum
+	{
+		MaxNumOperators = 8,
+		BlockSize = 64
+	};
+
+	static const BinaryOperator* asFusableOperator(const Expression* e)
+	{
+		if (auto bo = dynamic_cast<const BinaryOperator*>(e))
+		{
+			if (bo->operation == TokenTypes::plus || bo->operation == TokenTypes::minus || bo->operation == TokenTypes::times)
+				return bo;
+		}
+
+		return nullptr;
+	}
+
+	/** Collects the operators along the left-hand side, starting with the innermost one. 
+	*
+	*	Returns the number of operators or 0 if the expression is not a fusable chain. The operand k + 1 is the rhs of the 
+	*	operator k and the operand 0 is the lhs of the first operator.
+	*/
+	static int getChain(const Expression* root, const BinaryOperator** operators)
+	{
+		int numOperators = 0;
+
+		while (auto bo = asFusableOperator(root))
+		{
+			if (numOperators == MaxNumOperators)
+				return 0;
+
+			operators[numOperators++] = bo;
+			root = bo->lhs.get();
+		}
+
+		std::reverse(operators, operators + numOperators);
+
+		return numOperators;
+	}
+
+	/** Checks if the expression is a chain with at least two operators. */
+	static bool isChain(const Expression* e)
+	{
+		const BinaryOperator* operators[MaxNumOperators];
+
+		return getChain(e, operators) > 1;
+	}
+
+	/** Calculates the chain into the target. 
+	*
+	*	The operands are evaluated from left to right. If they can't be fused, the operators are applied one after 
+	*	another and the result is returned in evaluatedChain (so it can be passed to the normal << operator).
+	*/
+	static bool copyInto(VariantBuffer& target, const Expression* chain, const Scope& s, var& evaluatedChain)
+	{
+		const BinaryOperator* operators[MaxNumOperators];
+		const int numOperators = getChain(chain, operators);
+
+		var operands[MaxNumOperators + 1];
+
+		operands[0] = operators[0]->lhs->getResult(s);
+
+		for (int i = 0; i < numOperators; i++)
+			operands[i + 1] = operators[i]->rhs->getResult(s);
+
+		if (canFuse(operands, numOperators, target))
+		{
+			process(operators, operands, numOperators, target);
+			return true;
+		}
+
+		evaluatedChain = operands[0];
+
+		for (int i = 0; i < numOperators; i++)
+			evaluatedChain = operators[i]->getWithValues(evaluatedChain, operands[i + 1]);
+
+		return false;
+	}
+
+private:
+
+	static bool canFuse(const var* operands, int numOperators, const VariantBuffer& target)
+	{
+		for (int i = 0; i <= numOperators; i++)
+		{
+			auto b = operands[i].getBuffer();
+
+			if (b == nullptr || b->size != target.size)
+				return false;
+		}
+
+		return true;
+	}
+
+	static void process(const BinaryOperator** operators, const var* operands, int numOperators, VariantBuffer& target)
+	{
+		float* first = operands[0].getBuffer()->buffer.getWritePointer(0);
+		float* t = target.buffer.getWritePointer(0);
+
+		for (int start = 0; start < target.size; start += BlockSize)
+		{
+			const int numSamples = jmin<int>(BlockSize, target.size - start);
+			float* block = first + start;
+
+			for (int i = 0; i < numOperators; i++)
+			{
+				const TokenType op = operators[i]->operation;
+				const float* src = operands[i + 1].getBuffer()->buffer.getReadPointer(0, start);
+
+				if (op == TokenTypes::plus)			FloatVectorOperations::add(block, src, numSamples);
+				else if (op == TokenTypes::minus)	FloatVectorOperations::subtract(block, src, numSamples);
+				else								FloatVectorOperations::multiply(block, src, numSamples);
+			}
+
+			if (t != first)
+				FloatVectorOperations::copy(t + start, block, numSamples);
+
+			FloatSanitizers::sanitizeArray(t + start, numSamples);
+		}
+	}
+};
+
 struct HiseJavascriptEngine::RootObject::EqualsOp : public BinaryOperator
 {
 	EqualsOp(const CodeLocation& l, ExpPtr& a, ExpPtr& b) noexcept : BinaryOperator(l, a, b, TokenTypes::equals) {}
@@ -105,6 +242,7 @@ struct HiseJavascriptEngine::RootObject::GreaterThanOrEqualOp : public BinaryOpe
 struct HiseJavascriptEngine::RootObject::AdditionOp : public BinaryOperator
 {
 	AdditionOp(const CodeLocation& l, ExpPtr& a, ExpPtr& b) noexcept : BinaryOperator(l, a, b, TokenTypes::plus) {}
+
 	var getWithDoubles(double a, double b) const override                 { return a + b; }
 	var getWithInts(int64 a, int64 b) const override                      { return a + b; }
 	var getWithStrings(const String& a, const String& b) const override   { return a + b; }
@@ -144,6 +282,7 @@ struct HiseJavascriptEngine::RootObject::AdditionOp : public BinaryOperator
 struct HiseJavascriptEngine::RootObject::SubtractionOp : public BinaryOperator
 {
 	SubtractionOp(const CodeLocation& l, ExpPtr& a, ExpPtr& b) noexcept : BinaryOperator(l, a, b, TokenTypes::minus) {}
+
 	var getWithDoubles(double a, double b) const override { return a - b; }
 	var getWithInts(int64 a, int64 b) const override      { return a - b; }
 
@@ -182,6 +321,7 @@ struct HiseJavascriptEngine::RootObject::SubtractionOp : public BinaryOperator
 struct HiseJavascriptEngine::RootObject::MultiplyOp : public BinaryOperator
 {
 	MultiplyOp(const CodeLocation& l, ExpPtr& a, ExpPtr& b) noexcept : BinaryOperator(l, a, b, TokenTypes::times) {}
+
 	var getWithDoubles(double a, double b) const override { return a * b; }
 	var getWithInts(int64 a, int64 b) const override      { return a * b; }
 
@@ -257,9 +397,36 @@ struct HiseJavascriptEngine::RootObject::BitwiseXorOp : public BinaryOperator
 
 struct HiseJavascriptEngine::RootObject::LeftShiftOp : public BinaryOperator
 {
-	LeftShiftOp(const CodeLocation& l, ExpPtr& a, ExpPtr& b) noexcept : BinaryOperator(l, a, b, TokenTypes::leftShift) {}
+	LeftShiftOp(const CodeLocation& l, ExpPtr& a, ExpPtr& b) noexcept : 
+		BinaryOperator(l, a, b, TokenTypes::leftShift),
+		assignsOperatorChain(BufferExpression::isChain(rhs.get()))
+	{}
+
 	var getWithInts(int64 a, int64 b) const override   { return ((int)a) << (int)b; }
 
+	var getResult(const Scope& s) const override
+	{
+		if (!assignsOperatorChain)
+			return BinaryOperator::getResult(s);
+
+		var a(lhs->getResult(s)), b;
+
+		if (auto target = a.getBuffer())
+		{
+			if (BufferExpression::copyInto(*target, rhs.get(), s, b))
+				return a;
+		}
+		else
+		{
+			b = rhs->getResult(s);
+		}
+
+		return getWithValues(a, b);
+	}
+
+	/** True if the right-hand side is a chain like `a * b + c` (which is fused if the operands are buffers). */
+	const bool assignsOperatorChain;
+
 	var getWithArrayOrObject(const var& a, const var&b) const override
 	{
 		if (a.isBuffer())
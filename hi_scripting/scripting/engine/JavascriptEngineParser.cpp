@@ -17,6 +17,9 @@ struct HiseJavascriptEngine::RootObject::TokenIterator
 
 	void skip()
 	{
+		if (precompiledTokens != nullptr && readPrecompiledToken())
+			return;
+
 		skipWhitespaceAndComments();
 		location.location = p;
 		currentType = matchNextToken();
@@ -90,7 +93,237 @@ struct HiseJavascriptEngine::RootObject::TokenIterator
 		}
 	}
 
+	// ============================================================================================= precompiled tokens
+
+	/** Tokenizes the code and writes the tokens into a binary stream that can be passed to usePrecompiledTokens().
+	*
+	*	Every token is stored with its position in the code, so the parser creates the same locations for error
+	*	messages and debug information. Returns an empty block if the code can't be tokenized.
+	*/
+	static MemoryBlock createPrecompiledTokens(const String& code)
+	{
+		static const String commentSentinel = String::charToString(1);
+
+		MemoryOutputStream mos;
+
+		mos.writeInt(PrecompiledTokensMagicNumber);
+		mos.writeInt(getPrecompiledTokensVersion());
+		mos.writeInt64(code.hashCode64());
+		mos.writeInt((int)code.getNumBytesAsUTF8());
+
+		try
+		{
+			TokenIterator it(code, String());
+
+			for (;;)
+			{
+				const int tokenIndex = getTokenTypes().indexOf(it.currentType);
+				const bool hasComment = it.lastComment != commentSentinel;
+
+				jassert(isPositiveAndBelow(tokenIndex, 128));
+
+				mos.writeByte((char)(tokenIndex | (hasComment ? 0x80 : 0)));
+				mos.writeCompressedInt(it.getByteOffset(it.location.location));
+				mos.writeCompressedInt(it.getByteOffset(it.p));
+
+				if (it.currentType == TokenTypes::identifier || it.currentType == TokenTypes::literal)
+					it.currentValue.writeToStream(mos);
+
+				if (hasComment)
+					mos.writeString(it.lastComment);
+
+				if (it.currentType == TokenTypes::eof)
+					break;
+
+				// A block comment always overwrites the last comment, so this detects empty comments too
+				it.lastComment = commentSentinel;
+				it.skip();
+			}
+		}
+		catch (String&)
+		{
+			return MemoryBlock();
+		}
+		catch (Error&)
+		{
+			return MemoryBlock();
+		}
+
+		return mos.getMemoryBlock();
+	}
+
+	/** Tokenizes the code and compares every token with the token that is read from the data.
+	*
+	*	This checks the type, the position, the value and the comment of each token, so if it succeeds, the parser
+	*	creates the same tree from the data as from the code.
+	*/
+	static Result checkPrecompiledTokens(const String& code, const MemoryBlock& data)
+	{
+		try
+		{
+			TokenIterator expected(code, String());
+			TokenIterator actual(code, String());
+
+			actual.usePrecompiledTokens(data);
+
+			if (actual.precompiledTokens == nullptr)
+				return Result::fail("The tokens were not created for this code");
+
+			for (int index = 0;; index++)
+			{
+				const bool hasValue = expected.currentType == TokenTypes::identifier || expected.currentType == TokenTypes::literal;
+
+				if (actual.currentType != expected.currentType ||
+					actual.getByteOffset(actual.location.location) != expected.getByteOffset(expected.location.location) ||
+					actual.getByteOffset(actual.p) != expected.getByteOffset(expected.p) ||
+					(hasValue && !actual.currentValue.equalsWithSameType(expected.currentValue)) ||
+					actual.lastComment != expected.lastComment)
+				{
+					return Result::fail("Token " + String(index) + " doesn't match: " + getTokenName(actual.currentType) + " instead of " + getTokenName(expected.currentType));
+				}
+
+				if (expected.currentType == TokenTypes::eof)
+					return Result::ok();
+
+				expected.skip();
+				actual.skip();
+			}
+		}
+		catch (String& s)
+		{
+			return Result::fail(s);
+		}
+		catch (Error& e)
+		{
+			return Result::fail(e.errorMessage);
+		}
+	}
+
+	/** Reads the tokens from the given stream instead of scanning the code.
+	*
+	*	If the stream was created for another code or with another version of the tokenizer, it will be ignored. 
+	*	Call this directly after the constructor.
+	*/
+	void usePrecompiledTokens(const MemoryBlock& data)
+	{
+		if (data.getSize() == 0)
+			return;
+
+		precompiledData = data;
+
+		ScopedPointer<MemoryInputStream> mis = new MemoryInputStream(precompiledData, false);
+
+		if (mis->readInt() != PrecompiledTokensMagicNumber ||
+			mis->readInt() != getPrecompiledTokensVersion() ||
+			mis->readInt64() != location.program.hashCode64() ||
+			mis->readInt() != (int)location.program.getNumBytesAsUTF8())
+		{
+			return;
+		}
+
+		precompiledTokens = mis.release();
+		lastComment = String();
+
+		if (!readPrecompiledToken())
+		{
+			p = location.program.getCharPointer();
+			skip();
+		}
+	}
+
 private:
+
+	enum
+	{
+		PrecompiledTokensMagicNumber = 0x4b4f5448, // 'HTOK'
+		PrecompiledTokensFormatVersion = 1
+	};
+
+	/** The version changes with the format and the list of token types. */
+	static int getPrecompiledTokensVersion()
+	{
+		static const int version = [] ()
+		{
+			String s(PrecompiledTokensFormatVersion);
+
+			for (auto t : getTokenTypes())
+				s << t;
+
+			return s.hashCode();
+		}();
+
+		return version;
+	}
+
+	static const Array<TokenType>& getTokenTypes()
+	{
+		static const Array<TokenType> tokenTypes = [] ()
+		{
+			Array<TokenType> t;
+
+#define JUCE_JS_ADD_TOKEN_TYPE(name, str) t.add(TokenTypes::name);
+			JUCE_JS_KEYWORDS(JUCE_JS_ADD_TOKEN_TYPE)
+			JUCE_JS_OPERATORS(JUCE_JS_ADD_TOKEN_TYPE)
+			JUCE_JS_ADD_TOKEN_TYPE(eof, "$eof")
+			JUCE_JS_ADD_TOKEN_TYPE(literal, "$literal")
+			JUCE_JS_ADD_TOKEN_TYPE(identifier, "$identifier")
+#undef JUCE_JS_ADD_TOKEN_TYPE
+
+			return t;
+		}();
+
+		return tokenTypes;
+	}
+
+	int getByteOffset(String::CharPointerType position) const noexcept
+	{
+		return (int)(position.getAddress() - location.program.getCharPointer().getAddress());
+	}
+
+	/** Reads the next token from the precompiled stream. If the stream is exhausted or corrupt, it will be discarded
+	*	and the tokenizer continues at the end of the last token.
+	*/
+	bool readPrecompiledToken()
+	{
+		auto& mis = *precompiledTokens;
+		const int numBytes = (int)location.program.getNumBytesAsUTF8();
+
+		if (!mis.isExhausted())
+		{
+			const int flags = (int)(uint8)mis.readByte();
+			const int tokenIndex = flags & 0x7f;
+			const int start = mis.readCompressedInt();
+			const int end = mis.readCompressedInt();
+
+			if (isPositiveAndBelow(tokenIndex, getTokenTypes().size()) && 
+				isPositiveAndNotGreaterThan(start, numBytes) && 
+				isPositiveAndNotGreaterThan(end, numBytes) && start <= end)
+			{
+				const TokenType type = getTokenTypes().getUnchecked(tokenIndex);
+
+				if (type == TokenTypes::identifier || type == TokenTypes::literal)
+					currentValue = var::readFromStream(mis);
+
+				if ((flags & 0x80) != 0)
+					lastComment = mis.readString();
+
+				auto programStart = location.program.getCharPointer().getAddress();
+
+				location.location = String::CharPointerType(programStart + start);
+				p = String::CharPointerType(programStart + end);
+				currentType = type;
+
+				return true;
+			}
+		}
+
+		precompiledTokens = nullptr;
+		return false;
+	}
+
+	MemoryBlock precompiledData;
+	ScopedPointer<MemoryInputStream> precompiledTokens;
+
 	String::CharPointerType p;
 
 	static bool isIdentifierStart(const juce_wchar c) noexcept{ return CharacterFunctions::isLetter(c) || c == '_'; }
@@ -275,6 +508,17 @@ struct HiseJavascriptEngine::RootObject::ExpressionTreeBuilder : private TokenIt
 
 		if(codeToPreprocess.isNotEmpty())
 			preprocessCode(codeToPreprocess);
+
+		usePrecompiledTokens(getPrecompiledTokens(location.program));
+	}
+
+	/** Returns the tokens that were created for the given code when the project was exported (or an empty block). */
+	MemoryBlock getPrecompiledTokens(const String& code) const
+	{
+		if (auto p = dynamic_cast<Processor*>(hiseSpecialData->processor))
+			return p->getMainController()->getPrecompiledTokens(code.hashCode64());
+
+		return MemoryBlock();
 	}
 
 	void preprocessCode(const String& codeToPreprocess, const String& externalFileName="");
@@ -546,10 +790,74 @@ private:
 
 	void throwError(const String& err) const  { location.throwError(err); }
 
+	/** Adds the warning to the callback or inline function that is currently parsed. */
+	void addAllocationWarning(const Error& e)
+	{
+		Array<Error>* warnings = nullptr;
+
+		if (auto obj = dynamic_cast<InlineFunction::Object*>(currentInlineFunction))
+			warnings = &obj->allocationWarnings;
+		else if (currentlyParsedCallback.isValid())
+			warnings = &hiseSpecialData->getCallback(currentlyParsedCallback)->allocationWarnings;
+
+		if (warnings == nullptr)
+			return;
+
+		for (const auto& w : *warnings)
+		{
+			if (w.charIndex == e.charIndex && w.externalLocation == e.externalLocation && w.errorMessage == e.errorMessage)
+				return;
+		}
+
+		warnings->add(e);
+	}
+
+	/** Remembers a construct that allocates when it is executed so that it can be reported for realtime callbacks. */
+	void reportAllocation(const CodeLocation& l, const String& reason)
+	{
+#if USE_BACKEND
+		if (currentInlineFunction != nullptr || currentlyParsedCallback.isValid())
+			addAllocationWarning(Error::fromLocation(l, reason));
+#else
+		ignoreUnused(l, reason);
+#endif
+	}
+
+	static bool isStringLiteral(const Expression* e)
+	{
+		auto l = dynamic_cast<const LiteralValue*>(e);
+		return l != nullptr && l->value.isString();
+	}
+
+	void checkStringConcatenation(const Expression* a, const Expression* b)
+	{
+		if (isStringLiteral(a) || isStringLiteral(b))
+			reportAllocation(a->location, "string concatenation creates a new String");
+	}
+
+	void checkAllocatingMethodCall(const Expression* function)
+	{
+		static const Array<Identifier> allocatingMethods =
+		{
+			"push", "insert", "reserve", "join", "concat", "split", "replace", "substring",
+			"charAt", "fromCharCode", "toLowerCase", "toUpperCase", "trim"
+		};
+
+		if (auto dot = dynamic_cast<const DotOperator*>(function))
+		{
+			if (allocatingMethods.contains(dot->child))
+				reportAllocation(dot->location, dot->child.toString() + "() can allocate memory");
+		}
+	}
+
 	template <typename OpType>
 	Expression* parseInPlaceOpExpression(ExpPtr& lhs)
 	{
 		ExpPtr rhs(parseExpression());
+
+		if (std::is_same<OpType, AdditionOp>::value)
+			checkStringConcatenation(lhs, rhs);
+
 		Expression* bareLHS = lhs; // careful - bare pointer is deliberately alised
 		return new SelfAssignment(location, bareLHS, new OpType(location, lhs, rhs));
 	}
@@ -735,6 +1043,7 @@ private:
 
 				ftb.hiseSpecialData = hiseSpecialData;
 				ftb.currentNamespace = hiseSpecialData;
+				ftb.usePrecompiledTokens(getPrecompiledTokens(fileContent));
 
 				//ftb.setupApiData(*hiseSpecialData, fileContent);
 
@@ -942,6 +1251,7 @@ private:
 			hiseSpecialData->checkIfExistsInOtherStorage(HiseSpecialData::VariableStorageType::LocalScope, s->name, location);
 
 			ifo->localProperties.set(s->name, var::undefined());
+			s->index = ifo->localProperties.indexOf(s->name);
 
 			s->initialiser = matchIf(TokenTypes::assign) ? parseExpression() : new Expression(location);
 
@@ -966,6 +1276,7 @@ private:
 			hiseSpecialData->checkIfExistsInOtherStorage(HiseSpecialData::VariableStorageType::LocalScope, s->name, location);
 
 			callback->localProperties.set(s->name, var());
+			s->index = callback->localProperties.indexOf(s->name);
 
 			s->initialiser = matchIf(TokenTypes::assign) ? parseExpression() : new Expression(location);
 
@@ -1007,6 +1318,8 @@ private:
 
 		ScopedValueSetter<Identifier> cParser(currentlyParsedCallback, name, Identifier::null);
 
+		c->allocationWarnings.clear();
+
 		ScopedPointer<BlockStatement> s = parseBlock();
 
 		
@@ -1206,6 +1519,14 @@ private:
 				throwError("Inline function call " + obj->name + ": parameter amount mismatch: " + String(f->parameterExpressions.size()) + " (Expected: " + String(f->numArgs) + ")");
 			}
 
+			for (auto w : obj->allocationWarnings)
+			{
+				if (!w.errorMessage.contains("(in "))
+					w.errorMessage << " (in " << obj->name.toString() << "())";
+
+				addAllocationWarning(w);
+			}
+
 			return matchCloseParen(f.release());
 		}
 		else
@@ -1281,9 +1602,12 @@ private:
 				o->commentDoc = lastComment;
 				clearLastComment();
 
+				o->allocationWarnings.clear();
+
 				ScopedPointer<BlockStatement> body = parseBlock();
 
 				o->body = body.release();
+				o->program = BytecodeCompiler::compile(o->body);
 
 				currentInlineFunction = nullptr;
 
@@ -1722,7 +2046,10 @@ private:
 			return parseSuffixes(new DotOperator(location, input, parseIdentifier()));
 
 		if (currentType == TokenTypes::openParen)
+		{
+			checkAllocatingMethodCall(input);
 			return parseSuffixes(parseFunctionCall(new FunctionCall(location), input));
+		}
 
 		if (matchIf(TokenTypes::openBracket))
 		{
@@ -1778,7 +2105,7 @@ private:
 				if (localParameterIndex >= 0)
 				{
 					parseIdentifier();
-					return parseSuffixes(new LocalReference(location, ob, id));
+					return parseSuffixes(new LocalReference(location, ob, id, localParameterIndex));
 				}
 			}
 
@@ -1856,13 +2183,13 @@ private:
 								return parseSuffixes(new CallbackParameterReference(location, callbackParameter));
 							}
 
-							var* localParameter = c->localProperties.getVarPointer(id);
+							const int localIndex = c->localProperties.indexOf(id);
 
-							if (localParameter != nullptr)
+							if (localIndex != -1)
 							{
 								auto name = parseIdentifier();
 
-								return parseSuffixes(new CallbackLocalReference(location, c, name));
+								return parseSuffixes(new CallbackLocalReference(location, c, name, localIndex));
 							}
 						}
 						else
@@ -1904,6 +2231,7 @@ private:
 			}
 
 			match(TokenTypes::closeBrace);
+			reportAllocation(e->location, "object literal creates a new object");
 			return parseSuffixes(e.release());
 		}
 
@@ -1920,6 +2248,7 @@ private:
 			}
 
 			match(TokenTypes::closeBracket);
+			reportAllocation(e->location, "array literal creates a new Array");
 			return parseSuffixes(e.release());
 		}
 
@@ -1931,6 +2260,8 @@ private:
 			if (name.isValid())
 				throwError("Inline functions definitions cannot have a name");
 
+			reportAllocation(location, "function literal creates a new function object");
+
 			return new LiteralValue(location, fn);
 		}
 
@@ -2021,7 +2352,7 @@ private:
 
 		for (;;)
 		{
-			if (matchIf(TokenTypes::plus))            { ExpPtr b(parseMultiplyDivide()); a = new AdditionOp(location, a, b); }
+			if (matchIf(TokenTypes::plus))            { ExpPtr b(parseMultiplyDivide()); checkStringConcatenation(a, b); a = new AdditionOp(location, a, b); }
 			else if (matchIf(TokenTypes::minus))      { ExpPtr b(parseMultiplyDivide()); a = new SubtractionOp(location, a, b); }
 			else break;
 		}
@@ -2114,6 +2445,7 @@ void HiseJavascriptEngine::RootObject::ExpressionTreeBuilder::preprocessCode(con
 	JavascriptNamespace* rootNamespace = hiseSpecialData;
 	JavascriptNamespace* cns = rootNamespace;
 	TokenIterator it(codeToPreprocess, externalFileName);
+	it.usePrecompiledTokens(getPrecompiledTokens(codeToPreprocess));
 
 	int braceLevel = 0;
 
@@ -2374,6 +2706,16 @@ void HiseJavascriptEngine::RootObject::execute(const String& code, bool allowCon
 	sl->perform(Scope(nullptr, this, this), nullptr);
 }
 
+MemoryBlock HiseJavascriptEngine::createPrecompiledTokens(const String& javascriptCode)
+{
+	return RootObject::TokenIterator::createPrecompiledTokens(javascriptCode);
+}
+
+Result HiseJavascriptEngine::checkPrecompiledTokens(const String& javascriptCode, const MemoryBlock& tokens)
+{
+	return RootObject::TokenIterator::checkPrecompiledTokens(javascriptCode, tokens);
+}
+
 HiseJavascriptEngine::RootObject::FunctionObject::FunctionObject(const FunctionObject& other) : DynamicObject(), functionCode(other.functionCode)
 {
 	ExpressionTreeBuilder tb(functionCode, String());
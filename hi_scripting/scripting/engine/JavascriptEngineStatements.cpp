@@ -45,6 +45,17 @@ struct HiseJavascriptEngine::RootObject::BlockStatement : public Statement
 			}
 #endif
 
+#if ENABLE_SCRIPTING_ALLOCATION_TRACER
+			ScriptAllocationTracer::ScopedStatement ss(statements.getUnchecked(i));
+#endif
+
+			const Statement* st = statements.getUnchecked(i);
+			ScriptProfiler::ScopedFrame sf(s.root->profiler, true, st, [](const void* id)
+			{
+				auto statement = static_cast<const Statement*>(id);
+				return statement->location.createProfilerFrame(statement->location.getLineText(60));
+			});
+
 			if (ResultCode r = statements.getUnchecked(i)->perform(s, returnedValue))
 				return r;
 		}
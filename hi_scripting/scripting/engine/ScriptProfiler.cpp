@@ -0,0 +1,482 @@
+/*  ===========================================================================
+*
+*   This file is part of HISE.
+*   Copyright 2016 Christoph Hart
+*
+*   HISE is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   HISE is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with HISE.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Commercial licenses for using HISE in an closed source project are
+*   available on request. Please visit the project's website to get more
+*   information about commercial licensing:
+*
+*   http://www.hise.audio/
+*
+*   HISE is based on the JUCE library,
+*   which must be separately licensed for closed source applications:
+*
+*   http://www.juce.com
+*
+*   ===========================================================================
+*/
+
+namespace hise { using namespace juce;
+
+ScriptProfiler::ThreadData::ThreadData() :
+	threadId(nullptr),
+	isMessageThread(false)
+{
+}
+
+bool ScriptProfiler::ThreadData::push(const void* id, CreateFrameInfoFunction createFrameInfo, int& frameGeneration)
+{
+	GenericScopedTryLock<SpinLock> sl(lock);
+
+	// The message thread is reading the data, so this frame is dropped
+	if (!sl.isLocked())
+		return false;
+
+	applyPendingPops();
+
+	// The recording was never started for this thread
+	if (nodes.isEmpty())
+		return false;
+
+	const int frameIndex = getFrameIndex(id, createFrameInfo);
+
+	if (frameIndex == -1)
+		return false;
+
+	int child = nodes.getReference(currentNode).firstChild;
+
+	while (child != -1 && nodes.getReference(child).frameIndex != frameIndex)
+		child = nodes.getReference(child).nextSibling;
+
+	if (child == -1)
+	{
+		// Adding a node must not reallocate the array
+		if (nodes.size() >= MaxNumNodes)
+			return false;
+
+		Node n = { frameIndex, currentNode, -1, nodes.getReference(currentNode).firstChild, 0, 0 };
+
+		child = nodes.size();
+		nodes.add(n);
+		nodes.getReference(currentNode).firstChild = child;
+	}
+
+	nodes.getReference(child).numCalls++;
+	currentNode = child;
+	frameGeneration = generation;
+
+	return true;
+}
+
+void ScriptProfiler::ThreadData::pop(int frameGeneration, int64 ticks)
+{
+	GenericScopedTryLock<SpinLock> sl(lock);
+
+	if (!sl.isLocked())
+	{
+		// The frame is closed the next time this thread gets the lock, but its time is lost
+		if (pendingPopGeneration != frameGeneration)
+		{
+			pendingPopGeneration = frameGeneration;
+			numPendingPops = 0;
+		}
+
+		numPendingPops++;
+		return;
+	}
+
+	applyPendingPops();
+
+	// The recording was restarted while this frame was open
+	if (frameGeneration != generation || currentNode == 0)
+		return;
+
+	auto& n = nodes.getReference(currentNode);
+
+	n.ticks += ticks;
+	currentNode = n.parent;
+}
+
+void ScriptProfiler::ThreadData::applyPendingPops()
+{
+	if (numPendingPops == 0)
+		return;
+
+	if (pendingPopGeneration == generation)
+	{
+		for (int i = 0; i < numPendingPops && currentNode != 0; i++)
+			currentNode = nodes.getReference(currentNode).parent;
+	}
+
+	numPendingPops = 0;
+}
+
+int ScriptProfiler::ThreadData::getFrameIndex(const void* id, CreateFrameInfoFunction createFrameInfo)
+{
+	int slot = (int)((((uint32)(pointer_sized_uint)id) >> 3) * 2654435761u) & (FrameTableSize - 1);
+
+	for (int i = 0; i < FrameTableSize; i++)
+	{
+		const int index = frameTable[slot];
+
+		if (index == -1)
+		{
+			// Adding a frame must not reallocate the array
+			if (frames.size() >= MaxNumFrames)
+				return -1;
+
+			Frame f = { id, createFrameInfo, FrameInfo(), false };
+
+			frames.add(f);
+			frameTable[slot] = frames.size() - 1;
+
+			return frames.size() - 1;
+		}
+
+		if (frames.getReference(index).id == id)
+			return index;
+
+		slot = (slot + 1) & (FrameTableSize - 1);
+	}
+
+	return -1;
+}
+
+void ScriptProfiler::ThreadData::reset(int newGeneration)
+{
+	SpinLock::ScopedLockType sl(lock);
+
+	nodes.ensureStorageAllocated(MaxNumNodes);
+	frames.ensureStorageAllocated(MaxNumFrames);
+
+	if (frameTable == nullptr)
+		frameTable.malloc(FrameTableSize);
+
+	for (int i = 0; i < FrameTableSize; i++)
+		frameTable[i] = -1;
+
+	Node root = { -1, -1, -1, -1, 0, 0 };
+
+	frames.clearQuick();
+	nodes.clearQuick();
+	nodes.add(root);
+
+	currentNode = 0;
+	generation = newGeneration;
+}
+
+void ScriptProfiler::ThreadData::createFrameInfos()
+{
+	int numFrames = 0;
+
+	{
+		SpinLock::ScopedLockType sl(lock);
+		numFrames = frames.size();
+	}
+
+	// The recording thread only appends frames without reallocating and never changes the id or the info of an
+	// existing frame, so the descriptions can be created without holding the lock.
+	for (int i = 0; i < numFrames; i++)
+	{
+		auto& f = frames.getReference(i);
+
+		if (f.hasInfo || f.id == nullptr)
+			continue;
+
+		const FrameInfo info = f.createFrameInfo(f.id);
+
+		SpinLock::ScopedLockType sl(lock);
+
+		f.info = info;
+		f.hasInfo = true;
+	}
+}
+
+void ScriptProfiler::ThreadData::clearFrameIds()
+{
+	createFrameInfos();
+
+	SpinLock::ScopedLockType sl(lock);
+
+	if (frameTable == nullptr)
+		return;
+
+	for (int i = 0; i < FrameTableSize; i++)
+		frameTable[i] = -1;
+
+	for (auto& f : frames)
+		f.id = nullptr;
+}
+
+ScriptProfiler::ScriptProfiler() :
+	recording(false)
+{
+	for (int i = 0; i < MaxNumThreads; i++)
+		threads.add(new ThreadData());
+}
+
+ScriptProfiler::~ScriptProfiler()
+{
+	stop();
+}
+
+void ScriptProfiler::start(bool shouldRecordStatements)
+{
+	recording.store(false);
+
+	ScopedLock sl(readerLock);
+
+	recordStatements = shouldRecordStatements;
+	++generation;
+
+	for (auto t : threads)
+		t->reset(generation);
+
+	recording.store(true);
+}
+
+void ScriptProfiler::stop()
+{
+	recording.store(false);
+}
+
+void ScriptProfiler::clearFrameIds()
+{
+	ScopedLock sl(readerLock);
+
+	for (auto t : threads)
+		t->clearFrameIds();
+}
+
+void ScriptProfiler::createFrameInfos()
+{
+	ScopedLock sl(readerLock);
+
+	for (auto t : threads)
+		t->createFrameInfos();
+}
+
+ScriptProfiler::ThreadData* ScriptProfiler::getThreadData() noexcept
+{
+	const auto id = Thread::getCurrentThreadId();
+
+	for (auto t : threads)
+	{
+		if (t->threadId.load() == id)
+			return t;
+	}
+
+	// The name of the thread is not queried here, because Thread::getCurrentThread() allocates for unknown threads
+	auto mm = MessageManager::getInstanceWithoutCreating();
+	const bool isMessageThread = mm != nullptr && mm->isThisTheMessageThread();
+
+	for (auto t : threads)
+	{
+		Thread::ThreadID unused = nullptr;
+
+		if (t->threadId.compare_exchange_strong(unused, id))
+		{
+			t->isMessageThread.store(isMessageThread);
+			return t;
+		}
+	}
+
+	// All slots are used by other threads, so the frames of this thread are dropped
+	return nullptr;
+}
+
+String ScriptProfiler::exportProfile(ExportFormat format) const
+{
+	struct ThreadCopy
+	{
+		String name;
+		Array<FrameInfo> frames;
+		Array<ThreadData::Node> nodes;
+	};
+
+	OwnedArray<ThreadCopy> copies;
+
+	{
+		ScopedLock sl(readerLock);
+
+		FrameInfo unknownFrame;
+		unknownFrame.name = "Unknown";
+
+		for (int i = 0; i < threads.size(); i++)
+		{
+			auto t = threads[i];
+
+			if (t->threadId.load() == nullptr)
+				continue;
+
+			auto c = new ThreadCopy();
+
+			c->name = t->isMessageThread.load() ? "Message Thread" : "Thread " + String(i + 1);
+
+			// Allocate before the lock is acquired, so the recording thread only drops the frames during the copy
+			c->frames.ensureStorageAllocated(MaxNumFrames);
+			c->nodes.ensureStorageAllocated(MaxNumNodes);
+
+			SpinLock::ScopedLockType tl(t->lock);
+
+			for (const auto& f : t->frames)
+				c->frames.add(f.hasInfo ? f.info : unknownFrame);
+
+			c->nodes.addArray(t->nodes);
+
+			copies.add(c);
+		}
+	}
+
+	auto getLabel = [](const FrameInfo& f)
+	{
+		String s;
+		s << f.name << " (" << f.file << ":" << String(f.line) << ")";
+		return s.replaceCharacter(';', ',');
+	};
+
+	auto getSelfTime = [](const Array<ThreadData::Node>& nodes, int index)
+	{
+		const auto& n = nodes.getReference(index);
+		int64 self = n.ticks;
+
+		for (int c = n.firstChild; c != -1; c = nodes.getReference(c).nextSibling)
+			self -= nodes.getReference(c).ticks;
+
+		return jmax<int64>(0, self);
+	};
+
+	auto toMicroSeconds = [](int64 ticks)
+	{
+		return Time::highResolutionTicksToSeconds(ticks) * 1000000.0;
+	};
+
+	if (format == ExportFormat::CollapsedStacks)
+	{
+		String output;
+		NewLine nl;
+
+		for (auto c : copies)
+		{
+			for (int i = 1; i < c->nodes.size(); i++)
+			{
+				const int64 selfTime = getSelfTime(c->nodes, i);
+
+				if (selfTime == 0)
+					continue;
+
+				StringArray stack;
+
+				for (int n = i; n > 0; n = c->nodes.getReference(n).parent)
+					stack.insert(0, getLabel(c->frames.getReference(c->nodes.getReference(n).frameIndex)));
+
+				stack.insert(0, c->name.replaceCharacter(';', ','));
+
+				output << stack.joinIntoString(";") << " " << String(roundToInt(toMicroSeconds(selfTime))) << nl;
+			}
+		}
+
+		return output;
+	}
+
+	HashMap<String, int> frameIndexes;
+	Array<var> sharedFrames;
+	Array<var> profiles;
+
+	for (auto c : copies)
+	{
+		Array<int> globalIndexes;
+
+		for (const auto& f : c->frames)
+		{
+			const String label = getLabel(f);
+
+			if (!frameIndexes.contains(label))
+			{
+				DynamicObject::Ptr frame = new DynamicObject();
+
+				frame->setProperty("name", f.name);
+				frame->setProperty("file", f.file);
+				frame->setProperty("line", f.line);
+
+				frameIndexes.set(label, sharedFrames.size());
+				sharedFrames.add(var(frame));
+			}
+
+			globalIndexes.add(frameIndexes[label]);
+		}
+
+		Array<var> samples;
+		Array<var> weights;
+		double totalTime = 0.0;
+
+		for (int i = 1; i < c->nodes.size(); i++)
+		{
+			const int64 selfTime = getSelfTime(c->nodes, i);
+
+			if (selfTime == 0)
+				continue;
+
+			Array<var> stack;
+
+			for (int n = i; n > 0; n = c->nodes.getReference(n).parent)
+				stack.insert(0, globalIndexes[c->nodes.getReference(n).frameIndex]);
+
+			const double weight = toMicroSeconds(selfTime);
+
+			samples.add(stack);
+			weights.add(weight);
+			totalTime += weight;
+		}
+
+		DynamicObject::Ptr profile = new DynamicObject();
+
+		profile->setProperty("type", "sampled");
+		profile->setProperty("name", c->name);
+		profile->setProperty("unit", "microseconds");
+		profile->setProperty("startValue", 0.0);
+		profile->setProperty("endValue", totalTime);
+		profile->setProperty("samples", samples);
+		profile->setProperty("weights", weights);
+
+		profiles.add(var(profile));
+	}
+
+	DynamicObject::Ptr shared = new DynamicObject();
+	shared->setProperty("frames", sharedFrames);
+
+	DynamicObject::Ptr root = new DynamicObject();
+
+	root->setProperty("$schema", "https://www.speedscope.app/file-format-schema.json");
+	root->setProperty("name", "HiseScript Profile");
+	root->setProperty("exporter", "HISE");
+	root->setProperty("activeProfileIndex", 0);
+	root->setProperty("shared", var(shared));
+	root->setProperty("profiles", profiles);
+
+	return JSON::toString(var(root), true);
+}
+
+Result ScriptProfiler::exportToFile(const File& f, ExportFormat format) const
+{
+	if (!f.replaceWithText(exportProfile(format)))
+		return Result::fail("Can't write the profile to " + f.getFullPathName());
+
+	return Result::ok();
+}
+
+} // namespace hise
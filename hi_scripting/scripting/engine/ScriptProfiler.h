@@ -0,0 +1,234 @@
+/*  ===========================================================================
+*
+*   This file is part of HISE.
+*   Copyright 2016 Christoph Hart
+*
+*   HISE is free software: you can redistribute it and/or modify
+*   it under the terms of the GNU General Public License as published by
+*   the Free Software Foundation, either version 3 of the License, or
+*   (at your option) any later version.
+*
+*   HISE is distributed in the hope that it will be useful,
+*   but WITHOUT ANY WARRANTY; without even the implied warranty of
+*   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+*   GNU General Public License for more details.
+*
+*   You should have received a copy of the GNU General Public License
+*   along with HISE.  If not, see <http://www.gnu.org/licenses/>.
+*
+*   Commercial licenses for using HISE in an closed source project are
+*   available on request. Please visit the project's website to get more
+*   information about commercial licensing:
+*
+*   http://www.hise.audio/
+*
+*   HISE is based on the JUCE library,
+*   which must be separately licensed for closed source applications:
+*
+*   http://www.juce.com
+*
+*   ===========================================================================
+*/
+
+#ifndef SCRIPTPROFILER_H_INCLUDED
+#define SCRIPTPROFILER_H_INCLUDED
+
+namespace hise { using namespace juce;
+
+/** An instrumenting profiler that records the execution time of a script.
+*
+*	The engine opens a frame for every callback, function and inline function (and optionally every statement) 
+*	that is executed while the profiler is recording. The frames are aggregated into one call tree per thread, so 
+*	the memory usage only depends on the amount of different call stacks and not on the recording time.
+*
+*	The buffers of every thread are allocated when the recording starts, so the recording threads never allocate
+*	and never wait for a lock. If a buffer is full or the message thread is reading it, the frame is dropped.
+*
+*	The result can be exported as speedscope file (https://www.speedscope.app) or as collapsed stacks which can be
+*	used with most flame graph tools.
+*
+*	If the profiler is not recording, the overhead of a frame is a single check of an atomic flag.
+*/
+class ScriptProfiler
+{
+	struct ThreadData;
+
+public:
+
+	enum class ExportFormat
+	{
+		Speedscope = 0,
+		CollapsedStacks,
+		numExportFormats
+	};
+
+	/** The description of a frame. */
+	struct FrameInfo
+	{
+		String name;
+		String file;
+		int line = 0;
+	};
+
+	/** Creates the description of the frame with the given id.
+	*
+	*	This is not called by the recording thread, but by createFrameInfos() or clearFrameIds(), so it can allocate.
+	*/
+	typedef FrameInfo(*CreateFrameInfoFunction)(const void* id);
+
+	/** Records the time between its construction and destruction as frame of the calling thread. 
+	*
+	*	The id must point to the object that is executed. It is passed to the createFrameInfo function when the
+	*	description of the frame is needed.
+	*/
+	struct ScopedFrame
+	{
+		ScopedFrame(ScriptProfiler* p, bool isStatement, const void* id, CreateFrameInfoFunction createFrameInfo)
+		{
+			if (p == nullptr || !p->shouldRecord(isStatement))
+				return;
+
+			auto d = p->getThreadData();
+
+			if (d != nullptr && d->push(id, createFrameInfo, generation))
+			{
+				data = d;
+				startTicks = Time::getHighResolutionTicks();
+			}
+		}
+
+		~ScopedFrame()
+		{
+			if (data != nullptr)
+				data->pop(generation, Time::getHighResolutionTicks() - startTicks);
+		}
+
+	private:
+
+		ThreadData* data = nullptr;
+		int generation = 0;
+		int64 startTicks = 0;
+
+		JUCE_DECLARE_NON_COPYABLE(ScopedFrame)
+	};
+
+	ScriptProfiler();
+	~ScriptProfiler();
+
+	/** Clears the previous recording, allocates the buffers and starts recording. 
+	*
+	*	Statement frames are only recorded if recordStatements is true. 
+	*/
+	void start(bool recordStatements);
+
+	/** Stops the recording. The data is kept until the next call to start(). */
+	void stop();
+
+	bool isRecording() const noexcept { return recording.load(); }
+
+	bool shouldRecord(bool isStatement) const noexcept { return recording.load() && (!isStatement || recordStatements); }
+
+	/** Creates the descriptions of the recorded frames and forgets their ids. 
+	*
+	*	Call this before the objects of a compilation are deleted, the ids of the previous frames might be reused by 
+	*	the new objects.
+	*/
+	void clearFrameIds();
+
+	/** Creates the descriptions of the recorded frames. The objects that were recorded must not be deleted during this call. */
+	void createFrameInfos();
+
+	/** Returns the recorded data in the given format. Call createFrameInfos() before this. */
+	String exportProfile(ExportFormat format) const;
+
+	/** Exports the recorded data to the given file. Call createFrameInfos() before this. */
+	Result exportToFile(const File& f, ExportFormat format) const;
+
+private:
+
+	enum
+	{
+		MaxNumThreads = 8,
+		MaxNumFrames = 4096,
+		MaxNumNodes = 16384,
+		FrameTableSize = MaxNumFrames * 2
+	};
+
+	struct ThreadData
+	{
+		ThreadData();
+
+		/** Opens the frame with the given id. Returns false if the frame was dropped. This is called by the recording thread. */
+		bool push(const void* id, CreateFrameInfoFunction createFrameInfo, int& frameGeneration);
+
+		/** Closes the last frame. This is called by the recording thread. */
+		void pop(int frameGeneration, int64 ticks);
+
+		/** Clears the recorded data and allocates the buffers. */
+		void reset(int newGeneration);
+
+		void createFrameInfos();
+
+		void clearFrameIds();
+
+		struct Node
+		{
+			int frameIndex;
+			int parent;
+			int firstChild;
+			int nextSibling;
+			int64 ticks;
+			int numCalls;
+		};
+
+		struct Frame
+		{
+			const void* id;
+			CreateFrameInfoFunction createFrameInfo;
+			FrameInfo info;
+			bool hasInfo;
+		};
+
+		/** The thread that uses this slot (or nullptr). */
+		std::atomic<Thread::ThreadID> threadId;
+		std::atomic<bool> isMessageThread;
+
+		/** The recording thread only uses a try lock on this. */
+		SpinLock lock;
+
+		Array<Frame> frames;
+		Array<Node> nodes;
+		HeapBlock<int> frameTable;
+
+		int currentNode = 0;
+		int generation = 0;
+
+	private:
+
+		int getFrameIndex(const void* id, CreateFrameInfoFunction createFrameInfo);
+
+		void applyPendingPops();
+
+		// Frames that couldn't be closed because the lock was held. Only the recording thread uses these.
+		int numPendingPops = 0;
+		int pendingPopGeneration = 0;
+	};
+
+	/** Returns the slot of the calling thread (or nullptr if all slots are used by other threads). */
+	ThreadData* getThreadData() noexcept;
+
+	std::atomic<bool> recording;
+	bool recordStatements = false;
+	int generation = 0;
+
+	/** Serialises the methods that are not called by the recording threads. */
+	CriticalSection readerLock;
+
+	OwnedArray<ThreadData> threads;
+
+	JUCE_DECLARE_NON_COPYABLE(ScriptProfiler)
+};
+
+} // namespace hise
+
+#endif  // SCRIPTPROFILER_H_INCLUDED